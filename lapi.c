@@ -436,6 +436,7 @@ LUA_API lua_Unsigned lua_rawlen (lua_State *L, int idx) {
     case LUA_VVECTOR4: return 4;
     case LUA_VQUAT: return 4;
     case LUA_VMATRIX: return cast(lua_Unsigned, LUAGLM_MATRIX_COLS(mvalue_dims(o)));
+    case LUA_VMATRIX2: return 2;
     case LUA_VSHRSTR: return tsvalue(o)->shrlen;
     case LUA_VLNGSTR: return tsvalue(o)->u.lnglen;
 #if defined(LUAGLM_EXT_BLOB)
@@ -605,6 +606,15 @@ LUA_API char *lua_tostringblob (lua_State *L, int idx, size_t *len) {
   lua_unlock(L);
   return result;
 }
+
+LUA_API void lua_setblobview (lua_State *L, int idx) {
+  const TValue *o;
+  lua_lock(L);
+  o = index2value(L, idx);
+  api_check(L, ttistable(o), "table expected");
+  G(L)->viewmt = hvalue(o);
+  lua_unlock(L);
+}
 #endif
 
 
@@ -780,7 +790,7 @@ LUA_API int lua_geti (lua_State *L, int idx, lua_Integer n) {
   else if (ttisvector(t))
     glmVec_geti(L, t, n, L->top);
   else if (ttismatrix(t))
-    glmMat_rawgeti(t, n, L->top);
+    glmMat_rawgeti(L, t, n, L->top);
   else {
     TValue aux;
     setivalue(&aux, n);
@@ -817,7 +827,7 @@ LUA_API int lua_rawget (lua_State *L, int idx) {
   if (ttisvector(o))
     result = glmVec_rawget(o, s2v(L->top - 1), L->top - 1);
   else if (ttismatrix(o))
-    result = glmMat_rawget(o, s2v(L->top - 1), L->top - 1);
+    result = glmMat_rawget(L, o, s2v(L->top - 1), L->top - 1);
   else {
     Table *t = gettable(L, o);
     const TValue *val = luaH_get(t, s2v(L->top - 1));
@@ -839,7 +849,7 @@ LUA_API int lua_rawgeti (lua_State *L, int idx, lua_Integer n) {
     api_incr_top(L);
   }
   else if (ttismatrix(o)) {
-    result = glmMat_rawgeti(o, n, L->top);
+    result = glmMat_rawgeti(L, o, n, L->top);
     api_incr_top(L);
   }
   else {
@@ -1439,6 +1449,19 @@ LUA_API int lua_gc (lua_State *L, int what, ...) {
       luaC_changemode(L, KGC_INC);
       break;
     }
+#if defined(LUAGLM_EXT_GCPOOL)
+    case LUA_GCPOOL: {  /* 0: pooled blocks; 1: pool hits; 2: pool misses */
+      int stat = va_arg(argp, int);
+      lu_mem n = luaC_poolstat(L, stat);
+      res = (n > cast(lu_mem, INT_MAX)) ? INT_MAX : cast_int(n);
+      break;
+    }
+    case LUA_GCSETPOOL: {
+      int max = va_arg(argp, int);
+      res = luaC_setpoolmax(L, max);
+      break;
+    }
+#endif
     default: res = -1;  /* invalid option */
   }
   va_end(argp);
@@ -1477,7 +1500,7 @@ LUA_API int lua_next (lua_State *L, int idx) {
   if (ttisvector(o))
     more = glmVec_next(o, L->top - 1);
   else if (ttismatrix(o))
-    more = glmMat_next(o, L->top - 1);
+    more = glmMat_next(L, o, L->top - 1);
   else {
     Table *t = gettable(L, o);
     more = luaH_next(L, t, L->top - 1);
@@ -218,10 +218,18 @@ static int pushmode (lua_State *L, int oldmode) {
 static int luaB_collectgarbage (lua_State *L) {
   static const char *const opts[] = {"stop", "restart", "collect",
     "count", "step", "setpause", "setstepmul",
-    "isrunning", "generational", "incremental", NULL};
+    "isrunning", "generational", "incremental",
+#if defined(LUAGLM_EXT_GCPOOL)
+    "pool", "setpool",
+#endif
+    NULL};
   static const int optsnum[] = {LUA_GCSTOP, LUA_GCRESTART, LUA_GCCOLLECT,
     LUA_GCCOUNT, LUA_GCSTEP, LUA_GCSETPAUSE, LUA_GCSETSTEPMUL,
-    LUA_GCISRUNNING, LUA_GCGEN, LUA_GCINC};
+    LUA_GCISRUNNING, LUA_GCGEN, LUA_GCINC,
+#if defined(LUAGLM_EXT_GCPOOL)
+    LUA_GCPOOL, LUA_GCSETPOOL,
+#endif
+  };
   int o = optsnum[luaL_checkoption(L, 1, "collect", opts)];
   switch (o) {
     case LUA_GCCOUNT: {
@@ -263,6 +271,23 @@ static int luaB_collectgarbage (lua_State *L) {
       int stepsize = (int)luaL_optinteger(L, 4, 0);
       return pushmode(L, lua_gc(L, o, pause, stepmul, stepsize));
     }
+#if defined(LUAGLM_EXT_GCPOOL)
+    case LUA_GCPOOL: {
+      int pooled = lua_gc(L, o, 0);
+      checkvalres(pooled);
+      lua_pushinteger(L, pooled);
+      lua_pushinteger(L, lua_gc(L, o, 1));
+      lua_pushinteger(L, lua_gc(L, o, 2));
+      return 3;
+    }
+    case LUA_GCSETPOOL: {
+      int max = (int)luaL_optinteger(L, 2, -1);
+      int previous = lua_gc(L, o, max);
+      checkvalres(previous);
+      lua_pushinteger(L, previous);
+      return 1;
+    }
+#endif
     default: {
       int res = lua_gc(L, o);
       checkvalres(res);
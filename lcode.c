@@ -14,6 +14,7 @@
 #include <limits.h>
 #include <math.h>
 #include <stdlib.h>
+#include <string.h>
 
 #include "lua.h"
 
@@ -21,6 +22,7 @@
 #include "ldebug.h"
 #include "ldo.h"
 #include "lgc.h"
+#include "lglm_core.h"
 #include "llex.h"
 #include "lmem.h"
 #include "lobject.h"
@@ -38,6 +40,19 @@
 #define hasjumps(e)	((e)->t != (e)->f)
 
 
+#if defined(LUAGLM_EXT_CONSTVEC)
+/* vector constants must be compared with OP_EQ, which respects '__eq' */
+#define isvectorK(fs,e)	((e)->k == VK && ttisvector(&(fs)->f->k[(e)->u.info]))
+#else
+#define isvectorK(fs,e)	0
+#endif
+
+#if defined(LUAGLM_EXT_INPLACE)
+/* opcodes whose results are created by 'luaT_trybinTM' */
+#define isarithop(op)	((OP_ADDI <= (op) && (op) <= OP_SHR) || (op) == OP_UNM)
+#endif
+
+
 static int codesJ (FuncState *fs, OpCode o, int sj, int k);
 
 
@@ -102,6 +117,14 @@ int luaK_exp2const (FuncState *fs, const expdesc *e, TValue *v) {
       setobj(fs->ls->L, v, const2val(fs, e));
       return 1;
     }
+#if defined(LUAGLM_EXT_CONSTVEC)
+    case VK: {  /* folded vector constructor (see 'luaK_constvec') */
+      if (!ttisvector(&fs->f->k[e->u.info]))
+        return 0;
+      setobj(fs->ls->L, v, &fs->f->k[e->u.info]);
+      return 1;
+    }
+#endif
     default: return tonumeral(e, v);
   }
 }
@@ -619,6 +642,26 @@ static int luaK_numberK (FuncState *fs, lua_Number r) {
 }
 
 
+#if defined(LUAGLM_EXT_CONSTVEC)
+/*
+** Add a vector (or quaternion) to list of constants and return its index.
+** Its key is a string holding the raw bytes of the value and its variant,
+** so constants are only reused when bitwise identical (e.g., signed zeros
+** are kept apart, even though they compare equal).
+*/
+static int vectorK (FuncState *fs, const TValue *v) {
+  char buff[sizeof(lua_Float4) + 1];
+  const lua_Float4 f4 = vvalue_(v);
+  TValue o, kv;
+  memcpy(buff, &f4, sizeof(lua_Float4));
+  buff[sizeof(lua_Float4)] = cast_char(ttypetag(v));
+  setsvalue(fs->ls->L, &kv, luaX_newstring(fs->ls, buff, sizeof(buff)));
+  setobj(fs->ls->L, &o, v);
+  return addk(fs, &kv, &o);
+}
+#endif
+
+
 /*
 ** Add a false to list of constants and return its index.
 */
@@ -775,6 +818,13 @@ void luaK_setoneret (FuncState *fs, expdesc *e) {
 void luaK_dischargevars (FuncState *fs, expdesc *e) {
   switch (e->k) {
     case VCONST: {
+#if defined(LUAGLM_EXT_CONSTVEC)
+      if (ttisvector(const2val(fs, e))) {  /* vectors only live in 'k' */
+        e->u.info = vectorK(fs, const2val(fs, e));
+        e->k = VK;
+        break;
+      }
+#endif
       const2exp(const2val(fs, e), e);
       break;
     }
@@ -1360,6 +1410,78 @@ static int constfolding (FuncState *fs, int op, expdesc *e1,
 }
 
 
+/*
+** Check whether 'v' is a constant that can be compared at compile time
+*/
+static int isbasicK (const TValue *v) {
+  return ttisnil(v) || ttisboolean(v) || ttisnumber(v) || ttisstring(v);
+}
+
+
+/*
+** Concatenate string constants 's1' and 's2'
+*/
+static TString *concatK (FuncState *fs, TString *s1, TString *s2) {
+  lua_State *L = fs->ls->L;
+  TValue *res;
+  TString *ts;
+  setsvalue2s(L, L->top, s1);
+  luaD_inctop(L);
+  setsvalue2s(L, L->top, s2);
+  luaD_inctop(L);
+  luaV_concat(L, 2);  /* leaves result on the top */
+  res = s2v(L->top - 1);
+  ts = luaX_newstring(fs->ls, svalue(res), vslen(res));  /* anchor it */
+  L->top--;
+  return ts;
+}
+
+
+/*
+** Try to "constant-fold" a concatenation of strings or a comparison of
+** constants; return 1 iff successful. (In this case, 'e1' has the final
+** result.) Order comparisons are only folded for numbers: the order of
+** strings depends on the locale in use when the code runs.
+*/
+int luaK_foldconst (FuncState *fs, BinOpr opr, expdesc *e1,
+                                   const expdesc *e2) {
+  lua_State *L = fs->ls->L;
+  TValue v1, v2;
+  int res;
+  if (!luaK_exp2const(fs, e1, &v1) || !luaK_exp2const(fs, e2, &v2))
+    return 0;
+  switch (opr) {
+    case OPR_CONCAT: {
+      if (!ttisstring(&v1) || !ttisstring(&v2))
+        return 0;
+      e1->u.strval = concatK(fs, tsvalue(&v1), tsvalue(&v2));
+      e1->k = VKSTR;
+      return 1;
+    }
+    case OPR_EQ: case OPR_NE: {
+      if (!isbasicK(&v1) || !isbasicK(&v2))
+        return 0;
+      res = (luaV_rawequalobj(&v1, &v2) == (opr == OPR_EQ));
+      break;
+    }
+    case OPR_LT: case OPR_LE: case OPR_GT: case OPR_GE: {
+      if (!ttisnumber(&v1) || !ttisnumber(&v2))
+        return 0;
+      switch (opr) {
+        case OPR_LT: res = luaV_lessthan(L, &v1, &v2); break;
+        case OPR_LE: res = luaV_lessequal(L, &v1, &v2); break;
+        case OPR_GT: res = luaV_lessthan(L, &v2, &v1); break;
+        default: res = luaV_lessequal(L, &v2, &v1); break;
+      }
+      break;
+    }
+    default: return 0;
+  }
+  e1->k = (res) ? VTRUE : VFALSE;
+  return 1;
+}
+
+
 /*
 ** Emit code for unary expressions that "produce values"
 ** (everything but 'not').
@@ -1401,8 +1523,13 @@ static void finishbinexpval (FuncState *fs, expdesc *e1, expdesc *e2,
 static void codebinexpval (FuncState *fs, OpCode op,
                            expdesc *e1, expdesc *e2, int line) {
   int v2 = luaK_exp2anyreg(fs, e2);  /* both operands are in registers */
+  int tmp = 0;
+#if defined(LUAGLM_EXT_INPLACE)
+  /* 'k' in OP_MMBIN: R[A] is an unshared temporary that dies here */
+  tmp = e1->tmp && e1->k == VNONRELOC;
+#endif
   lua_assert(OP_ADD <= op && op <= OP_SHR);
-  finishbinexpval(fs, e1, e2, op, v2, 0, line, OP_MMBIN,
+  finishbinexpval(fs, e1, e2, op, v2, tmp, line, OP_MMBIN,
                   cast(TMS, (op - OP_ADD) + TM_ADD));
 }
 
@@ -1448,12 +1575,14 @@ static void swapexps (expdesc *e1, expdesc *e2) {
 
 /*
 ** Code arithmetic operators ('+', '-', ...). If second operand is a
-** constant in the proper range, use variant opcodes with K operands.
+** constant (numeric or vector) in the proper range, use variant opcodes
+** with K operands.
 */
 static void codearith (FuncState *fs, BinOpr opr,
                        expdesc *e1, expdesc *e2, int flip, int line) {
   TMS event = cast(TMS, opr + TM_ADD);
-  if (tonumeral(e2, NULL) && luaK_exp2K(fs, e2)) {  /* K operand? */
+  if ((tonumeral(e2, NULL) || isvectorK(fs, e2))
+      && luaK_exp2K(fs, e2)) {  /* K operand? */
     int v2 = e2->u.info;  /* K index */
     OpCode op = cast(OpCode, opr + OP_ADDK);
     finishbinexpval(fs, e1, e2, op, v2, flip, line, OP_MMBINK, event);
@@ -1469,13 +1598,15 @@ static void codearith (FuncState *fs, BinOpr opr,
 
 /*
 ** Code commutative operators ('+', '*'). If first operand is a
-** numeric constant, change order of operands to try to use an
-** immediate or K operator.
+** numeric constant (or a vector constant and the second operand is not
+** numeric), change order of operands to try to use an immediate or K
+** operator.
 */
 static void codecommutative (FuncState *fs, BinOpr op,
                              expdesc *e1, expdesc *e2, int line) {
   int flip = 0;
-  if (tonumeral(e1, NULL)) {  /* is first operand a numeric constant? */
+  if (tonumeral(e1, NULL) ||  /* is first operand a numeric constant? */
+      (isvectorK(fs, e1) && !tonumeral(e2, NULL))) {
     swapexps(e1, e2);  /* change order */
     flip = 1;
   }
@@ -1560,7 +1691,7 @@ static void codeeq (FuncState *fs, BinOpr opr, expdesc *e1, expdesc *e2) {
     op = OP_EQI;
     r2 = im;  /* immediate operand */
   }
-  else if (luaK_exp2RK(fs, e2)) {  /* 1st expression is constant? */
+  else if (!isvectorK(fs, e2) && luaK_exp2RK(fs, e2)) {  /* 1st expression is constant? */
     op = OP_EQK;
     r2 = e2->u.info;  /* constant index */
   }
@@ -1578,7 +1709,11 @@ static void codeeq (FuncState *fs, BinOpr opr, expdesc *e1, expdesc *e2) {
 ** Apply prefix operation 'op' to expression 'e'.
 */
 void luaK_prefix (FuncState *fs, UnOpr op, expdesc *e, int line) {
+#if defined(LUAGLM_EXT_INPLACE)
+  static const expdesc ef = {VKINT, {0}, NO_JUMP, NO_JUMP, 0};
+#else
   static const expdesc ef = {VKINT, {0}, NO_JUMP, NO_JUMP};
+#endif
   luaK_dischargevars(fs, e);
   switch (op) {
     case OPR_MINUS: case OPR_BNOT:  /* use 'ef' as fake 2nd operand */
@@ -1586,6 +1721,11 @@ void luaK_prefix (FuncState *fs, UnOpr op, expdesc *e, int line) {
         break;
       /* else */ /* FALLTHROUGH */
     case OPR_LEN:
+      if (op == OPR_LEN && e->k == VKSTR && !hasjumps(e)) {
+        e->u.ival = cast(lua_Integer, tsslen(e->u.strval));  /* fold '#"s"' */
+        e->k = VKINT;
+        break;
+      }
       codeunexpval(fs, cast(OpCode, op + OP_UNM), e, line);
       break;
     case OPR_NOT: codenot(fs, e); break;
@@ -1618,9 +1758,16 @@ void luaK_infix (FuncState *fs, BinOpr op, expdesc *v) {
     case OPR_MOD: case OPR_POW:
     case OPR_BAND: case OPR_BOR: case OPR_BXOR:
     case OPR_SHL: case OPR_SHR: {
-      if (!tonumeral(v, NULL))
+#if defined(LUAGLM_EXT_INPLACE)
+      /* result of an arithmetic operation that is only referenced by the
+         (fresh) register it is about to be put in */
+      v->tmp = (v->k == VRELOC && !hasjumps(v)
+                && isarithop(GET_OPCODE(getinstruction(fs, v))));
+#endif
+      if (!tonumeral(v, NULL) && !isvectorK(fs, v))
         luaK_exp2anyreg(fs, v);
-      /* else keep numeral, which may be folded with 2nd operand */
+      /* else keep numeral, which may be folded with 2nd operand, or
+         vector constant, which may be a K operand */
       break;
     }
     case OPR_EQ: case OPR_NE: {
@@ -1806,6 +1953,51 @@ static int finaltarget (Instruction *code, int i) {
 }
 
 
+/*
+** Get the line of instruction 'pc' while the function is still being
+** built (see 'luaG_getfuncline', which needs the closed prototype).
+*/
+static int getinstrline (FuncState *fs, int pc) {
+  Proto *f = fs->f;
+  int i = fs->nabslineinfo - 1;
+  int basepc = -1;
+  int line = f->linedefined;
+  while (i >= 0 && f->abslineinfo[i].pc > pc)
+    i--;
+  if (i >= 0) {
+    basepc = f->abslineinfo[i].pc;
+    line = f->abslineinfo[i].line;
+  }
+  while (basepc++ < pc)
+    line += f->lineinfo[basepc];
+  return line;
+}
+
+
+/*
+** Optimizing pass (load mode 'O', 'luac -O'): an unconditional jump whose
+** final target is OP_RETURN0/OP_RETURN1 is replaced by that return. Jumps
+** following a test are kept, as the VM executes them together with the
+** test. Only forward jumps to a return on the same line are replaced, so
+** line hooks see the same events.
+*/
+static void jumpstoreturns (FuncState *fs) {
+  Instruction *code = fs->f->code;
+  int i;
+  for (i = 0; i < fs->pc; i++) {
+    if (GET_OPCODE(code[i]) == OP_JMP
+        && !(i > 0 && testTMode(GET_OPCODE(code[i - 1])))) {
+      int target = finaltarget(code, i);
+      Instruction ret = code[target];
+      if ((GET_OPCODE(ret) == OP_RETURN0 || GET_OPCODE(ret) == OP_RETURN1)
+          && target > i  /* a backward jump would trigger a line hook */
+          && getinstrline(fs, i) == getinstrline(fs, target))
+        code[i] = ret;
+    }
+  }
+}
+
+
 /*
 ** Do a final pass over the code of a function, doing small peephole
 ** optimizations and adjustments.
@@ -1813,6 +2005,8 @@ static int finaltarget (Instruction *code, int i) {
 void luaK_finish (FuncState *fs) {
   int i;
   Proto *p = fs->f;
+  if (fs->ls->dyd->optimize)
+    jumpstoreturns(fs);
   for (i = 0; i < fs->pc; i++) {
     Instruction *pc = &p->code[i];
     lua_assert(i == 0 || isOT(*(pc - 1)) == isIT(*pc));
@@ -1839,3 +2033,170 @@ void luaK_finish (FuncState *fs) {
     }
   }
 }
+
+
+#if defined(LUAGLM_EXT_CONSTVEC)
+/*
+** {======================================================================
+** Constant vector constructors
+** =======================================================================
+*/
+
+static const struct {
+  const char *name;
+  lu_byte variant;
+} vecctors[] = {
+  {"vec2", LUA_VVECTOR2}, {"vector2", LUA_VVECTOR2},
+  {"vec3", LUA_VVECTOR3}, {"vector3", LUA_VVECTOR3},
+  {"vec4", LUA_VVECTOR4}, {"vector4", LUA_VVECTOR4},
+  {"qua", LUA_VQUAT}, {"quat", LUA_VQUAT},
+  {NULL, 0}
+};
+
+
+/*
+** Return the vector variant built by the constructor 'name' or 0 if 'name'
+** is not a (foldable) builtin constructor.
+*/
+int luaK_ctorvariant (TString *name) {
+  int i;
+  for (i = 0; vecctors[i].name != NULL; i++) {
+    if (strcmp(getstr(name), vecctors[i].name) == 0)
+      return vecctors[i].variant;
+  }
+  return 0;
+}
+
+
+/*
+** Return the variant of the constructor loaded into register 'base' by
+** instruction 'i', that is, the variant of a local variable or upvalue
+** of kind RDKCTOR, or 0 if 'i' does not load such a variable.
+*/
+static int ctorcallee (FuncState *fs, Instruction i, int base) {
+  if (GETARG_A(i) != base)
+    return 0;
+  else if (GET_OPCODE(i) == OP_MOVE) {
+    Dyndata *dyd = fs->ls->dyd;
+    int v;
+    for (v = 0; v < fs->nactvar; v++) {
+      Vardesc *vd = &dyd->actvar.arr[fs->firstlocal + v];
+      if (vd->vd.kind == RDKCTOR && vd->vd.ridx == GETARG_B(i))
+        return luaK_ctorvariant(vd->vd.name);
+    }
+  }
+  else if (GET_OPCODE(i) == OP_GETUPVAL) {
+    Upvaldesc *up = &fs->f->upvalues[GETARG_B(i)];
+    if (up->kind == RDKCTOR)
+      return luaK_ctorvariant(up->name);
+  }
+  return 0;
+}
+
+
+/*
+** Evaluate the constructor of vector variant 'tt' over the numeric
+** arguments 'args' at compile time, mirroring the rules of the builtin
+** constructors: no arguments produce the zero vector (identity quaternion),
+** a single number is broadcast, otherwise each dimension must be given.
+** Returns 0 if the call cannot be folded, i.e., it would raise an error or
+** involves an alternate form of the constructor (e.g., quat(angle, axis)).
+*/
+static int ctorvalue (lua_State *L, int tt, const TValue *args, int nargs,
+                                                TValue *res) {
+  lua_Float4 f4;
+  int i;
+  f4.raw[0] = f4.raw[1] = f4.raw[2] = f4.raw[3] = cast(lua_VecF, 0);
+  if (tt == LUA_VQUAT) {
+    if (nargs == 0)
+      f4.raw[LUAGLM_QUAT_WXYZ ? 0 : 3] = cast(lua_VecF, 1);
+    else if (nargs == 4) {  /* <w, x, y, z> */
+      for (i = 0; i < 4; i++)
+        f4.raw[LUAGLM_QUAT_WXYZ ? i : ((i + 3) % 4)] = cast(lua_VecF, nvalue(&args[i]));
+    }
+    else
+      return 0;
+  }
+  else if (nargs == 1) {
+    const lua_VecF x = ttisinteger(&args[0]) ? cast(lua_VecF, ivalue(&args[0]))
+                                             : cast(lua_VecF, fltvalue(&args[0]));
+    f4.raw[0] = f4.raw[1] = f4.raw[2] = f4.raw[3] = x;
+  }
+  else if (nargs == 0 || nargs == cast_int(glm_dimensions(cast_byte(tt)))) {
+    for (i = 0; i < nargs; i++)
+      f4.raw[i] = ttisinteger(&args[i]) ? cast(lua_VecF, ivalue(&args[i]))
+                                        : cast(lua_VecF, fltvalue(&args[i]));
+  }
+  else
+    return 0;
+  setvvalue(L, res, f4, tt);
+  return 1;
+}
+
+
+/*
+** Remove the last 'n' instructions. Once the line information of one of
+** them was absolute, the next instruction is forced to have absolute line
+** information too (see 'removelastlineinfo').
+*/
+static void removeinstructions (FuncState *fs, int n) {
+  int abs = 0;
+  for (; n > 0; n--) {
+    abs |= (fs->f->lineinfo[fs->pc - 1] == ABSLINEINFO);
+    removelastinstruction(fs);
+  }
+  if (abs)
+    fs->iwthabs = MAXIWTHABS + 1;
+}
+
+
+/*
+** Fold a call expression 'e' into a vector constant when it invokes a
+** builtin constructor through a variable of kind RDKCTOR, i.e., a
+** '<const>' variable guarded by OP_CHECKCTOR, with only numeric literals
+** as arguments. The call must be the last code emitted: the instructions
+** loading the function and its arguments are simply removed.
+*/
+void luaK_constvec (FuncState *fs, expdesc *e) {
+  TValue args[4];
+  TValue v;
+  Instruction *code = fs->f->code;
+  int pc, base, nargs, first, tt, i;
+  if (e->k != VCALL || e->u.info != fs->pc - 1)
+    return;
+  pc = e->u.info;
+  base = GETARG_A(code[pc]);
+  nargs = GETARG_B(code[pc]) - 1;  /* fixed number of arguments? */
+  first = pc - nargs - 1;  /* instruction loading the function */
+  if (nargs < 0 || nargs > 4 || first < 0 || fs->lasttarget > first)
+    return;
+  else if ((tt = ctorcallee(fs, code[first], base)) == 0)
+    return;
+  for (i = 0; i < nargs; i++) {
+    Instruction ins = code[first + 1 + i];
+    if (GETARG_A(ins) != base + 1 + i)
+      return;
+    switch (GET_OPCODE(ins)) {
+      case OP_LOADI: setivalue(&args[i], GETARG_sBx(ins)); break;
+      case OP_LOADF: setfltvalue(&args[i], cast_num(GETARG_sBx(ins))); break;
+      case OP_LOADK: {
+        const TValue *k = &fs->f->k[GETARG_Bx(ins)];
+        if (!ttisnumber(k))
+          return;
+        setobj(fs->ls->L, &args[i], k);
+        break;
+      }
+      default: return;
+    }
+  }
+  if (!ctorvalue(fs->ls->L, tt, args, nargs, &v))
+    return;
+  lua_assert(fs->freereg == base + 1);
+  removeinstructions(fs, nargs + 2);
+  fs->freereg = base;  /* free the register of the function */
+  e->k = VK;
+  e->u.info = vectorK(fs, &v);
+}
+
+/* }====================================================================== */
+#endif
@@ -94,11 +94,17 @@ LUAI_FUNC void luaK_prefix (FuncState *fs, UnOpr op, expdesc *v, int line);
 LUAI_FUNC void luaK_infix (FuncState *fs, BinOpr op, expdesc *v);
 LUAI_FUNC void luaK_posfix (FuncState *fs, BinOpr op, expdesc *v1,
                             expdesc *v2, int line);
+LUAI_FUNC int luaK_foldconst (FuncState *fs, BinOpr op, expdesc *e1,
+                                               const expdesc *e2);
 LUAI_FUNC void luaK_settablesize (FuncState *fs, int pc,
                                   int ra, int asize, int hsize);
 LUAI_FUNC void luaK_setlist (FuncState *fs, int base, int nelems, int tostore);
 LUAI_FUNC void luaK_finish (FuncState *fs);
 LUAI_FUNC l_noret luaK_semerror (LexState *ls, const char *msg);
+#if defined(LUAGLM_EXT_CONSTVEC)
+LUAI_FUNC int luaK_ctorvariant (TString *name);
+LUAI_FUNC void luaK_constvec (FuncState *fs, expdesc *e);
+#endif
 
 
 #endif
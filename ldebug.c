@@ -755,6 +755,19 @@ l_noret luaG_forerror (lua_State *L, const TValue *o, const char *what) {
 }
 
 
+#if defined(LUAGLM_EXT_CONSTVEC)
+/*
+** Error raised by OP_CHECKCTOR: calls through a '<const>' variable named
+** after a vector constructor have been folded into constants, so the
+** variable must hold that builtin function.
+*/
+l_noret luaG_ctorerror (lua_State *L, const TValue *o) {
+  luaG_runerror(L, "constant constructor%s is not a builtin (got %s)",
+                   varinfo(L, o), luaT_objtypename(L, o));
+}
+#endif
+
+
 l_noret luaG_concaterror (lua_State *L, const TValue *p1, const TValue *p2) {
   if (ttisstring(p1) || cvt2str(p1)) p1 = p2;
   luaG_typeerror(L, p1, "concatenate");
@@ -44,6 +44,9 @@ LUAI_FUNC l_noret luaG_typeerror (lua_State *L, const TValue *o,
 LUAI_FUNC l_noret luaG_callerror (lua_State *L, const TValue *o);
 LUAI_FUNC l_noret luaG_forerror (lua_State *L, const TValue *o,
                                                const char *what);
+#if defined(LUAGLM_EXT_CONSTVEC)
+LUAI_FUNC l_noret luaG_ctorerror (lua_State *L, const TValue *o);
+#endif
 LUAI_FUNC l_noret luaG_concaterror (lua_State *L, const TValue *p1,
                                                   const TValue *p2);
 LUAI_FUNC l_noret luaG_opinterror (lua_State *L, const TValue *p1,
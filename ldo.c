@@ -387,6 +387,9 @@ void luaD_inctop (lua_State *L) {
 void luaD_hook (lua_State *L, int event, int line,
                               int ftransfer, int ntransfer) {
   lua_Hook hook = L->hook;
+#if defined(LUAGLM_EXT_INPLACE)
+  G(L)->lastmat = NULL;  /* hooks may reach any temporary */
+#endif
   if (hook && L->allowhook) {  /* make sure there is a hook */
     int mask = CIST_HOOKED;
     CallInfo *ci = L->ci;
@@ -621,6 +624,9 @@ l_sinline int precallC (lua_State *L, StkId func, int nresults,
 */
 int luaD_pretailcall (lua_State *L, CallInfo *ci, StkId func,
                                     int narg1, int delta) {
+#if defined(LUAGLM_EXT_INPLACE)
+  G(L)->lastmat = NULL;
+#endif
  retry:
   switch (ttypetag(s2v(func))) {
     case LUA_VCCL:  /* C closure */
@@ -665,6 +671,9 @@ int luaD_pretailcall (lua_State *L, CallInfo *ci, StkId func,
 ** original function position.
 */
 CallInfo *luaD_precall (lua_State *L, StkId func, int nresults) {
+#if defined(LUAGLM_EXT_INPLACE)
+  G(L)->lastmat = NULL;  /* callee may reach the temporaries of its caller */
+#endif
  retry:
   switch (ttypetag(s2v(func))) {
     case LUA_VCCL:  /* C closure */
@@ -1091,6 +1100,7 @@ int luaD_protectedparser (lua_State *L, ZIO *z, const char *name,
   p.dyd.actvar.arr = NULL; p.dyd.actvar.size = 0;
   p.dyd.gt.arr = NULL; p.dyd.gt.size = 0;
   p.dyd.label.arr = NULL; p.dyd.label.size = 0;
+  p.dyd.optimize = (mode != NULL && strchr(mode, 'O') != NULL);
   luaZ_initbuffer(L, &p.buff);
   status = luaD_pcall(L, f_parser, &p, savestack(L, L->top), L->errfunc);
   luaZ_freebuffer(L, &p.buff);
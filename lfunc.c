@@ -18,6 +18,7 @@
 #include "ldo.h"
 #include "lfunc.h"
 #include "lgc.h"
+#include "ljit.h"
 #include "lmem.h"
 #include "lobject.h"
 #include "lstate.h"
@@ -297,11 +298,18 @@ Proto *luaF_newproto (lua_State *L) {
   f->linedefined = 0;
   f->lastlinedefined = 0;
   f->source = NULL;
+#if defined(LUAGLM_EXT_JIT)
+  f->jit = NULL;
+  f->jithot = JIT_HOT;
+#endif
   return f;
 }
 
 
 void luaF_freeproto (lua_State *L, Proto *f) {
+#if defined(LUAGLM_EXT_JIT)
+  luaJ_freecode(L, f);
+#endif
   luaM_freearray(L, f->code, f->sizecode);
   luaM_freearray(L, f->p, f->sizep);
   luaM_freearray(L, f->k, f->sizek);
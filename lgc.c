@@ -192,6 +192,12 @@ static int iscleared (global_State *g, const GCObject *o) {
     markobject(g, o);  /* strings are 'values', so are never weak */
     return 0;
   }
+#if defined(LUAGLM_COMPACT_VALUE)
+  else if (novariant(o->tt) == LUA_TVECTOR) {
+    markobject(g, o);  /* as are vectors */
+    return 0;
+  }
+#endif
   else return iswhite(o);
 }
 
@@ -255,13 +261,148 @@ void luaC_fix (lua_State *L, GCObject *o) {
 }
 
 
+#if defined(LUAGLM_EXT_GCPOOL)
+/*
+** {======================================================
+** Object pools: released blocks of fixed-size objects are kept in
+** per-class free lists and reused by 'luaC_newobj' instead of going
+** through 'frealloc'. Pooled blocks are accounted as freed memory.
+** =======================================================
+*/
+
+static const size_t poolsizes[GCPOOL_N] = {
+  sizematrix(LUAGLM_MATRIX_LENGTH(LUAGLM_MATRIX_4x4)), sizeof(UpVal),
+#if defined(LUAGLM_COMPACT_VALUE)
+  sizeof(GCVector),
+#endif
+};
+
+
+/*
+** Return the size class of an object with the given tag and size or -1
+** if objects of that kind are not pooled.
+*/
+static int poolclass (int tt, size_t sz) {
+  switch (tt) {
+    case LUA_VMATRIX:  /* only mat4x4-sized objects */
+      return (sz == poolsizes[GCPOOL_MATRIX]) ? GCPOOL_MATRIX : -1;
+    case LUA_VUPVAL: return (sz == sizeof(UpVal)) ? GCPOOL_UPVAL : -1;
+#if defined(LUAGLM_COMPACT_VALUE)
+    case LUA_VVECTOR3: case LUA_VVECTOR4: case LUA_VQUAT:
+      return (sz == sizeof(GCVector)) ? GCPOOL_VECTOR : -1;
+#endif
+    default: return -1;
+  }
+}
+
+
+static GCObject *poolget (global_State *g, int c) {
+  GCPool *p = &g->gcpool[c];
+  GCObject *o = p->list;
+  if (o != NULL) {
+    p->list = o->next;
+    p->n--;
+    p->hits++;
+    g->GCdebt += poolsizes[c];
+  }
+  else
+    p->misses++;
+  return o;
+}
+
+
+/*
+** Return a dead object to the free list of its class. Returns 0 if the
+** list is full and the block must be released to 'frealloc'.
+*/
+static int poolput (global_State *g, GCObject *o, size_t sz) {
+  int c = poolclass(o->tt, sz);
+  if (c >= 0 && g->gcpool[c].n < g->gcpoolmax) {
+    GCPool *p = &g->gcpool[c];
+    o->next = p->list;
+    p->list = o;
+    p->n++;
+    g->GCdebt -= sz;
+    return 1;
+  }
+  return 0;
+}
+
+
+/*
+** Release pooled blocks back to 'frealloc' until no list has more than
+** 'max' elements.
+*/
+static void pooltrim (global_State *g, int max) {
+  int c;
+  for (c = 0; c < GCPOOL_N; c++) {
+    GCPool *p = &g->gcpool[c];
+    while (p->n > max) {
+      GCObject *o = p->list;
+      p->list = o->next;
+      p->n--;
+      (*g->frealloc)(g->ud, o, poolsizes[c], 0);
+    }
+  }
+}
+
+
+/*
+** Set the maximum number of blocks retained per class (if 'max' is not
+** negative), resetting the pool statistics. Returns the previous value.
+*/
+int luaC_setpoolmax (lua_State *L, int max) {
+  global_State *g = G(L);
+  int res = g->gcpoolmax;
+  int c;
+  if (max >= 0) {
+    g->gcpoolmax = max;
+    pooltrim(g, max);
+  }
+  for (c = 0; c < GCPOOL_N; c++)
+    g->gcpool[c].hits = g->gcpool[c].misses = 0;
+  return res;
+}
+
+
+/*
+** Pool statistics over all classes: 0 - number of pooled blocks;
+** 1 - allocations served by a pool; 2 - allocations that missed.
+*/
+lu_mem luaC_poolstat (lua_State *L, int what) {
+  global_State *g = G(L);
+  lu_mem res = 0;
+  int c;
+  for (c = 0; c < GCPOOL_N; c++) {
+    const GCPool *p = &g->gcpool[c];
+    switch (what) {
+      case 0: res += cast(lu_mem, p->n); break;
+      case 1: res += p->hits; break;
+      case 2: res += p->misses; break;
+      default: break;
+    }
+  }
+  return res;
+}
+
+/* }====================================================== */
+#endif
+
+
 /*
 ** create a new collectable object (with given type and size) and link
 ** it to 'allgc' list.
 */
 GCObject *luaC_newobj (lua_State *L, int tt, size_t sz) {
   global_State *g = G(L);
+#if defined(LUAGLM_EXT_GCPOOL)
+  int c = poolclass(tt, sz);
+  GCObject *o = (c >= 0) ? poolget(g, c) : NULL;
+  if (o == NULL)
+    o = cast(GCObject *, luaM_newobject(L, novariant(tt), sz));
+#else
   GCObject *o = cast(GCObject *, luaM_newobject(L, novariant(tt), sz));
+#endif
   o->marked = luaC_white(g);
   o->tt = tt;
   o->next = g->allgc;
@@ -294,6 +435,9 @@ GCObject *luaC_newobj (lua_State *L, int tt, size_t sz) {
 */
 static void reallymarkobject (global_State *g, GCObject *o) {
   switch (o->tt) {
+#if defined(LUAGLM_COMPACT_VALUE)
+    case LUA_VVECTOR3: case LUA_VVECTOR4: case LUA_VQUAT:
+#endif
     case LUA_VMATRIX:
     case LUA_VSHRSTR:
 #if defined(LUAGLM_EXT_BLOB)
@@ -338,6 +482,9 @@ static void markmt (global_State *g) {
   int i;
   for (i=0; i < LUA_NUMTAGS; i++)
     markobjectN(g, g->mt[i]);
+#if defined(LUAGLM_EXT_BLOB)
+  markobjectN(g, g->viewmt);
+#endif
 }
 
 
@@ -765,6 +912,10 @@ static void clearbyvalues (global_State *g, GCObject *l, GCObject *f) {
 static void freeupval (lua_State *L, UpVal *uv) {
   if (upisopen(uv))
     luaF_unlinkupval(uv);
+#if defined(LUAGLM_EXT_GCPOOL)
+  if (poolput(G(L), obj2gco(uv), sizeof(UpVal)))
+    return;
+#endif
   luaM_free(L, uv);
 }
 
@@ -790,9 +941,26 @@ static void freeobj (lua_State *L, GCObject *o) {
     case LUA_VTABLE:
       luaH_free(L, gco2t(o));
       break;
-    case LUA_VMATRIX:
-      luaM_free_(L, gco2mat(o), sizeof(GCMatrix));
+    case LUA_VMATRIX: {
+      GCMatrix *mat = gco2mat(o);
+      if (mat->boxed)
+        luaM_freearray(L, mat->u.ext, LUAGLM_MATRIX_LENGTH(LUAGLM_MATRIX_4x4));
+#if defined(LUAGLM_EXT_GCPOOL)
+      if (poolput(G(L), o, sizematrix(mat->size)))
+        break;
+#endif
+      luaM_free_(L, mat, sizematrix(mat->size));
       break;
+    }
+#if defined(LUAGLM_COMPACT_VALUE)
+    case LUA_VVECTOR3: case LUA_VVECTOR4: case LUA_VQUAT:
+#if defined(LUAGLM_EXT_GCPOOL)
+      if (poolput(G(L), o, sizeof(GCVector)))
+        break;
+#endif
+      luaM_free(L, gco2vec(o));
+      break;
+#endif
     case LUA_VTHREAD:
       luaE_freethread(L, gco2th(o));
       break;
@@ -1526,6 +1694,9 @@ void luaC_freeallobjects (lua_State *L) {
   lua_assert(g->finobj == NULL);  /* no new finalizers */
   deletelist(L, g->fixedgc, NULL);  /* collect fixed objects */
   lua_assert(g->strt.nuse == 0);
+#if defined(LUAGLM_EXT_GCPOOL)
+  pooltrim(g, 0);  /* release pooled blocks */
+#endif
 }
 
 
@@ -1737,6 +1908,10 @@ void luaC_fullgc (lua_State *L, int isemergency) {
     fullinc(L, g);
   else
     fullgen(L, g);
+#if defined(LUAGLM_EXT_GCPOOL)
+  if (isemergency)  /* give pooled blocks back to the allocator */
+    pooltrim(g, 0);
+#endif
   g->gcemergency = 0;
 }
 
@@ -140,6 +140,13 @@
 /* how much to allocate before next GC step (log2) */
 #define LUAI_GCSTEPSIZE 13      /* 8 KB */
 
+#if defined(LUAGLM_EXT_GCPOOL)
+/* maximum number of released blocks retained per size class */
+#if !defined(LUAI_GCPOOLMAX)
+#define LUAI_GCPOOLMAX  256
+#endif
+#endif
+
 
 /*
 ** Check whether the declared GC mode is generational. While in
@@ -171,6 +178,16 @@
 /* more often than not, 'pre'/'pos' are empty */
 #define luaC_checkGC(L)		luaC_condGC(L,(void)0,(void)0)
 
+/*
+** 'luaC_checkGC' for code that may have created a vector: a no-op unless
+** vectors are collectable (LUAGLM_COMPACT_VALUE).
+*/
+#if defined(LUAGLM_COMPACT_VALUE)
+#define luaC_checkvecGC(L)	luaC_checkGC(L)
+#else
+#define luaC_checkvecGC(L)	((void)0)
+#endif
+
 
 #define luaC_barrier(L,p,v) (  \
 	(iscollectable(v) && isblack(p) && iswhite(gcvalue(v))) ?  \
@@ -194,6 +211,10 @@ LUAI_FUNC void luaC_barrier_ (lua_State *L, GCObject *o, GCObject *v);
 LUAI_FUNC void luaC_barrierback_ (lua_State *L, GCObject *o);
 LUAI_FUNC void luaC_checkfinalizer (lua_State *L, GCObject *o, Table *mt);
 LUAI_FUNC void luaC_changemode (lua_State *L, int newmode);
+#if defined(LUAGLM_EXT_GCPOOL)
+LUAI_FUNC int luaC_setpoolmax (lua_State *L, int max);
+LUAI_FUNC lu_mem luaC_poolstat (lua_State *L, int what);
+#endif
 
 
 #endif
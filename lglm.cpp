@@ -206,27 +206,38 @@ static inline lua_Integer glm_flttointeger(const TValue *obj) {
 /* convert an object to an integer (without string coercion) */
 #define glm_tointeger(o) (ttisinteger(o) ? ivalue(o) : glm_flttointeger(o))
 
-/* raw object fields */
-#define glm_vvalue_raw(o) glm_constvec_boundary(&vvalue_raw(o))
-#define glm_v2value_raw(o) glm_vvalue_raw(o).v2
-#define glm_v3value_raw(o) glm_vvalue_raw(o).v3
-#define glm_v4value_raw(o) glm_vvalue_raw(o).v4
-#define glm_qvalue_raw(o) glm_vvalue_raw(o).q
-
-/* glm::type references */
+/*
+** glm::type references; copies when vectors are collectable, as only vector2
+** is stored inline (see LUAGLM_COMPACT_VALUE).
+*/
+#if defined(LUAGLM_COMPACT_VALUE)
+#define glm_vvalue_raw(v, rtt) glmVectorBoundary(vvalue_raw(v, rtt)).glm
+#define glm_vvalue(o) glmVectorBoundary(vvalue_(o)).glm
+#define glm_setvvalue2s(L, s, x, o) \
+  setvvalue(L, s2v(s), glmVectorBoundary(glmVector(x)).lua, o)
+#else
+#define glm_vvalue_raw(v, rtt) glm_constvec_boundary(&vvalue_raw(v, rtt))
 #define glm_vvalue(o) glm_constvec_boundary(vvalue_ref(o))
-#define glm_v2value(o) glm_vvalue(o).v2
-#define glm_v3value(o) glm_vvalue(o).v3
-#define glm_v4value(o) glm_vvalue(o).v4
-#define glm_qvalue(o) glm_vvalue(o).q
-#define glm_setvvalue2s(s, x, o)        \
+#define glm_setvvalue2s(L, s, x, o)     \
   LUA_MLM_BEGIN                         \
   TValue *io = s2v(s);                  \
   glm_vec_boundary(&vvalue_(io)) = (x); \
   settt_(io, (o));                      \
+  checkliveness(L, io);                 \
   LUA_MLM_END
+#endif
+
+/* raw object fields, e.g., node keys */
+#define glm_v2value_raw(v, rtt) glm_vvalue_raw(v, rtt).v2
+#define glm_v3value_raw(v, rtt) glm_vvalue_raw(v, rtt).v3
+#define glm_v4value_raw(v, rtt) glm_vvalue_raw(v, rtt).v4
+#define glm_qvalue_raw(v, rtt) glm_vvalue_raw(v, rtt).q
+
+#define glm_v2value(o) glm_vvalue(o).v2
+#define glm_v3value(o) glm_vvalue(o).v3
+#define glm_v4value(o) glm_vvalue(o).v4
+#define glm_qvalue(o) glm_vvalue(o).q
 
-#define glm_mvalue(o) glm_constmat_boundary(mvalue_ref(o))
 #define glm_setmvalue2s(L, o, x) glm_setmvalue(L, s2v(o), x)
 #define glm_setmvalue(L, obj, x) \
   LUA_MLM_BEGIN                  \
@@ -237,6 +248,23 @@ static inline lua_Integer glm_flttointeger(const TValue *obj) {
   checkliveness(L, io);          \
   LUA_MLM_END
 
+/*
+** Matrix values are expanded into a temporary glmMatrix: the components of a
+** collectable matrix are sized to its dimensions (see glmMat_load) and inline
+** mat2x2 values (LUA_VMATRIX2) are stored in the Value payload.
+*/
+#define glm_gcmvalue(o) glmMatrixBoundary(glmMat_load(mvalue(o))).glm
+#if defined(LUAGLM_INLINE_MATRIX)
+#define glm_m2value(o) glm_m2unpack(m2value(o))
+#define glm_mvalue(o) (ttisinlinematrix(o) ? glm_m2value(o) : glm_gcmvalue(o))
+#define glm_setm2value2s(L, o, x) setm2value(L, s2v(o), glm_m2pack(x))
+#else
+#define glm_mvalue(o) glm_gcmvalue(o)
+#endif
+
+/* glmMatrix -> GCMatrix */
+#define glm_mstore(L, mat, x) glmMat_store((L), (mat), &lua_constmat_boundary(&(x)))
+
 /* }================================================================== */
 
 /*
@@ -277,7 +305,7 @@ static void vec_finishget(lua_State *L, const TValue *obj, TValue *key, StkId re
       }
       else if (strcmp(str, "axis") == 0) {
         const glmVector out(glm::axis(glm_qvalue(obj)));
-        glm_setvvalue2s(res, out, LUA_VVECTOR3);
+        glm_setvvalue2s(L, res, out, LUA_VVECTOR3);
         return;
       }
     }
@@ -299,24 +327,39 @@ static void vec_finishget(lua_State *L, const TValue *obj, TValue *key, StkId re
 }
 
 /// <summary>
-/// Runtime swizzle operation: returning the number of copied vector fields on
-/// success, zero on failure.
+/// Runtime swizzle decoding: only 2-, 3-, and 4-component "xyzw" swizzles are
+/// cached as swizzles. Single-component fields are handled by vecgets.
 /// </summary>
-template<glm::length_t L>
-static glm::length_t swizzle(const lua_Float4 &v, const char *key, lua_Float4 &out) {
-  glm::length_t i = 0;
-  for (; i < 4 && key[i] != '\0'; ++i) {
-    switch (key[i]) {
-      case 'x': GLM_IF_CONSTEXPR(L < 1) return 0; out.raw[i] = static_cast<lua_VecF>(v.raw[0]); break;
-      case 'y': GLM_IF_CONSTEXPR(L < 2) return 0; out.raw[i] = static_cast<lua_VecF>(v.raw[1]); break;
-      case 'z': GLM_IF_CONSTEXPR(L < 3) return 0; out.raw[i] = static_cast<lua_VecF>(v.raw[2]); break;
-      case 'w': GLM_IF_CONSTEXPR(L < 4) return 0; out.raw[i] = static_cast<lua_VecF>(v.raw[3]); break;
+const Swizzle *glmVec_swizzle(lua_State *L, TString *key) {
+  Swizzle *sw = &G(L)->swizzle[lmod(key->hash, SWIZZLECACHE_N)];
+  const char *str = getstr(key);
+  const size_t len = tsslen(key);
+
+  sw->key = key;
+  sw->n = sw->dims = 0;
+  std::memset(sw->idx, 0, sizeof(sw->idx));
+  if (len < 2 || len > 4)
+    return sw;
+
+  lu_byte dims = 0;
+  for (size_t i = 0; i < len; ++i) {
+    lu_byte c = 0;
+    switch (str[i]) {
+      case 'x': c = 0; break;
+      case 'y': c = 1; break;
+      case 'z': c = 2; break;
+      case 'w': c = 3; break;
       default: {
-        return 0;
+        return sw;  // Not a swizzle
       }
     }
+    sw->idx[i] = c;
+    if (c >= dims)
+      dims = cast_byte(c + 1);
   }
-  return i;
+  sw->n = cast_byte(len);
+  sw->dims = dims;
+  return sw;
 }
 
 int glmVec_rawgeti(const TValue *obj, lua_Integer n, StkId res) {
@@ -389,31 +432,22 @@ void glmVec_get(lua_State *L, const TValue *obj, TValue *key, StkId res) {
     }
     // Allow runtime swizzle operations prior to metamethod access.
     else if (str_len <= 4) {
-      lua_Float4 out;
+      const Swizzle *sw = glm_getswizzle(L, tsvalue(key));
+      lua_Float4 out = { { 0, 0, 0, 0 } };
       glm::length_t count = 0;
-      switch (ttypetag(obj)) {
-        case LUA_VVECTOR2: count = swizzle<2>(vvalue_(obj), str, out); break;
-        case LUA_VVECTOR3: count = swizzle<3>(vvalue_(obj), str, out); break;
-        case LUA_VVECTOR4: count = swizzle<4>(vvalue_(obj), str, out); break;
-        case LUA_VQUAT: {
+      if (sw->n > 0 && sw->dims <= glm_dimensions(ttypetag(obj))) {
+        lua_Float4 v = vvalue_(obj);
 #if LUAGLM_QUAT_WXYZ  // quaternion has WXYZ layout
-          const lua_Float4 &v = vvalue_(obj);
-          const lua_Float4 swap = { { v.raw[1], v.raw[2], v.raw[3], v.raw[0] } };
-          count = swizzle<4>(swap, str, out);
-#else
-          count = swizzle<4>(vvalue_(obj), str, out);
+        if (ttisquat(obj))
+          v = lua_Float4{ { v.raw[1], v.raw[2], v.raw[3], v.raw[0] } };
 #endif
-          break;
-        }
-        default: {
-          break;
-        }
+        for (count = 0; count < sw->n; ++count)
+          out.raw[count] = v.raw[sw->idx[count]];
       }
 
       switch (count) {
-        case 1: setfltvalue(s2v(res), cast_num(out.raw[0])); return;
-        case 2: setvvalue(s2v(res), out, LUA_VVECTOR2); return;
-        case 3: setvvalue(s2v(res), out, LUA_VVECTOR3); return;
+        case 2: setvvalue(L, s2v(res), out, LUA_VVECTOR2); return;
+        case 3: setvvalue(L, s2v(res), out, LUA_VVECTOR3); return;
         case 4: {
           // Quaternion was swizzled and resultant vector is still normalized.
           // Keep quaternion semantics.
@@ -422,10 +456,10 @@ void glmVec_get(lua_State *L, const TValue *obj, TValue *key, StkId res) {
             const lua_Float4 &swap = out;
             out = { { swap.raw[3], swap.raw[0], swap.raw[1], swap.raw[2] } };
 #endif
-            setvvalue(s2v(res), out, LUA_VQUAT);
+            setvvalue(L, s2v(res), out, LUA_VQUAT);
           }
           else {
-            setvvalue(s2v(res), out, LUA_VVECTOR4);
+            setvvalue(L, s2v(res), out, LUA_VVECTOR4);
           }
           return;
         }
@@ -444,6 +478,41 @@ void glmVec_get(lua_State *L, const TValue *obj, TValue *key, StkId res) {
   vec_finishget(L, obj, key, res);  // Metatable Access
 }
 
+int glm_libraryindex(lua_State *L) {
+  lua_settop(L, 2);
+  if (lua_rawget(L, lua_upvalueindex(1)) != LUA_TFUNCTION) {  // Only functions can be accessed
+    lua_pop(L, 1);
+    lua_pushnil(L);
+  }
+  return 1;
+}
+
+void glm_cacheself(lua_State *L, const Instruction *pc, const TValue *obj, TString *key) {
+  Table *mt = G(L)->mt[ttype(obj)];
+  if (mt == GLM_NULLPTR || key->tt != LUA_VSHRSTR)
+    return;
+
+  // Swizzles and the dimension field take priority over tag methods; the
+  // swizzle validity of 'key' is independent of the receiver's dimensions.
+  if (ttisvector(obj) && (glm_getswizzle(L, key)->n > 0 || strcmp(getstr(key), "dim") == 0))
+    return;
+
+  const TValue *tm = luaH_getshortstr(mt, G(L)->tmname[TM_INDEX]);
+  const TValue *slot = luaH_getshortstr(mt, key);
+  if (glm_isselfindex(tm, mt) && ttisfunction(slot)) {
+    MethodCache *mc = luaE_methodcache(L);
+    if (mc == GLM_NULLPTR)  // no memory for the cache
+      return;
+    mc = cacheentry(mc, pc, METHODCACHE_N);
+    mc->pc = pc;
+    mc->mt = mt;
+    mc->node = mt->node;
+    mc->lsizenode = mt->lsizenode;
+    mc->tm = nodefromval(tm);
+    mc->slot = nodefromval(slot);
+  }
+}
+
 void glmVec_objlen(const TValue *obj, StkId res) {
   const glmVector &v = glm_vvalue(obj);
   switch (ttypetag(obj)) {
@@ -482,7 +551,7 @@ int glmVec_equalObj(lua_State *L, const TValue *o1, const TValue *o2) {
   return result;
 }
 
-int glmVec_concat(const TValue *obj, const TValue *value, StkId res) {
+int glmVec_concat(lua_State *L, const TValue *obj, const TValue *value, StkId res) {
   const glmVector &v = glm_vvalue(obj);
   glmVector result = v;  // Create a copy of the vector
   glm::length_t dims = glm_dimensions(ttypetag(obj));  // Current dimensions
@@ -506,7 +575,7 @@ int glmVec_concat(const TValue *obj, const TValue *value, StkId res) {
     return 0;
   }
 
-  glm_setvvalue2s(res, result, glm_variant(dims));
+  glm_setvvalue2s(L, res, result, glm_variant(dims));
   return 1;
 }
 
@@ -531,10 +600,13 @@ int glmVec_equalKey(const TValue *k1, const Node *n2, int rtt) {
   // @NOTE: Ideally _glmeq would be used. However, that would put the table in
   // an invalid state: mainposition != equalkey.
   switch (withvariant(rtt)) {
-    case LUA_VVECTOR2: return glm_v2value(k1) == glm_v2value_raw(keyval(n2));
-    case LUA_VVECTOR3: return glm_v3value(k1) == glm_v3value_raw(keyval(n2));
-    case LUA_VVECTOR4: return glm_v4value(k1) == glm_v4value_raw(keyval(n2));
-    case LUA_VQUAT: return glm_qvalue(k1) == glm_qvalue_raw(keyval(n2));
+    case LUA_VVECTOR2: return glm_v2value(k1) == glm_v2value_raw(keyval(n2), rtt);
+    case LUA_VVECTOR3: return glm_v3value(k1) == glm_v3value_raw(keyval(n2), rtt);
+    case LUA_VVECTOR4: return glm_v4value(k1) == glm_v4value_raw(keyval(n2), rtt);
+    case LUA_VQUAT: return glm_qvalue(k1) == glm_qvalue_raw(keyval(n2), rtt);
+#if defined(LUAGLM_INLINE_MATRIX)
+    case LUA_VMATRIX2: return glm_constvec_boundary(&m2value(k1)).v4 == glm_constvec_boundary(&keyval(n2).f4).v4;
+#endif
     default: {
       return 0;
     }
@@ -548,6 +620,9 @@ size_t glmVec_hash(const TValue *obj) {
     case LUA_VVECTOR3: return glm::hash::hash(glm_v3value(obj));
     case LUA_VVECTOR4: return glm::hash::hash(glm_v4value(obj));
     case LUA_VQUAT: return glm::hash::hash(glm_qvalue(obj));
+#if defined(LUAGLM_INLINE_MATRIX)
+    case LUA_VMATRIX2: return glm::hash::hash(glm_constvec_boundary(&m2value(obj)).v4);
+#endif
     default: {
       return 0xDEAD;  // C0D3
     }
@@ -577,6 +652,9 @@ int glmVec_isfinite(const TValue *obj) {
     case LUA_VVECTOR3: return glm::__isfinite(glm_v3value(obj));
     case LUA_VVECTOR4: return glm::__isfinite(glm_v4value(obj));
     case LUA_VQUAT: return glm::__isfinite(glm_v4value(obj));  // @HACK
+#if defined(LUAGLM_INLINE_MATRIX)
+    case LUA_VMATRIX2: return glm::__isfinite(glm_constvec_boundary(&m2value(obj)).v4);
+#endif
     default: {
       break;
     }
@@ -612,7 +690,15 @@ int glmVec_next(const TValue *obj, StkId key) {
 int glm_trybinTM(lua_State *L, const TValue *p1, const TValue *p2, StkId res, TMS event) {
   switch (ttype(p1)) {
     case LUA_TNUMBER: return num_trybinTM(L, p1, p2, res, event);
-    case LUA_TMATRIX: return mat_trybinTM(L, p1, p2, res, event);
+    case LUA_TMATRIX: {
+#if defined(LUAGLM_EXT_INPLACE)
+      const int result = mat_trybinTM(L, p1, p2, res, event);
+      G(L)->deadmat = NULL;  // Only valid for the operation it was granted to
+      return result;
+#else
+      return mat_trybinTM(L, p1, p2, res, event);
+#endif
+    }
     case LUA_TVECTOR: {
       if (ttisquat(p1))  // quaternion-specific implementation
         return quat_trybinTM(L, p1, p2, res, event);
@@ -635,6 +721,28 @@ int glm_trybinTM(lua_State *L, const TValue *p1, const TValue *p2, StkId res, TM
 
 #define INVALID_MATRIX_DIMENSIONS "invalid " GLM_STRING_MATRIX " dimension"
 
+#if defined(LUAGLM_INLINE_MATRIX)
+/// <summary>
+/// Write the modified copy of an inline matrix back to its slot. A matrix that
+/// no longer has 2x2 dimensions is promoted to a collectable matrix; 'obj' is
+/// either a stack slot or an upvalue of the running C function.
+/// </summary>
+static int glmMat_setinline(lua_State *L, const TValue *obj, const glmMatrix &m) {
+  TValue *slot = const_cast<TValue *>(obj);
+  if (m.dimensions == LUAGLM_MATRIX_2x2) {
+    setm2value(L, slot, glm_m2pack(m.m22));
+  }
+  else {
+    GCMatrix *mat = glmMat_new(L, m.dimensions);
+    glm_mstore(L, mat, m);
+    glm_setmvalue(L, slot, mat);
+    if (!(cast(StkId, slot) >= L->stack && cast(StkId, slot) < L->stack_last))
+      luaC_objbarrier(L, clCvalue(s2v(L->ci->func)), mat);
+  }
+  return 1;
+}
+#endif
+
 /// <summary>
 /// If "raw" is true (denoting 'rawset'), the function will throw a Lua runtime
 /// error when attempting to operate on invalid keys/fields. Otherwise, this
@@ -645,7 +753,7 @@ static int glmMat_auxset(lua_State *L, const TValue *obj, TValue *key, TValue *v
     return raw ? glm_typeError(L, key, "index") : glm_finishset(L, obj, key, val);
   }
 
-  glmMatrix &m = glm_mat_boundary(mvalue_ref(obj));
+  glmMatrix m = glm_mvalue(obj);  // Copy of the matrix; written back on success
   const glm::length_t m_size = LUAGLM_MATRIX_COLS(m.dimensions);
   const glm::length_t m_secondary = LUAGLM_MATRIX_ROWS(m.dimensions);
   const glm::length_t dim = static_cast<glm::length_t>(glm_tointeger(key));
@@ -678,11 +786,16 @@ static int glmMat_auxset(lua_State *L, const TValue *obj, TValue *key, TValue *v
     }
 
     m.dimensions = LUAGLM_MATRIX_TYPE(m_size + (expanding ? 1 : 0), m_secondary);
+#if defined(LUAGLM_INLINE_MATRIX)
+    if (ttisinlinematrix(obj))
+      return glmMat_setinline(L, obj, m);
+#endif
+    glm_mstore(L, mvalue(obj), m);
     return 1;
   }
   else if (ttisnil(val)) {  // Attempt to shrink the dimension of the matrix
     if (dim == m_size && dim > 2) {  // Matrices must have at least two columns; >= 2x2
-      m.dimensions = LUAGLM_MATRIX_TYPE(m_size - 1, m_secondary);
+      mvalue(obj)->dimensions = LUAGLM_MATRIX_TYPE(m_size - 1, m_secondary);
       return 1;
     }
     return raw ? glm_runerror(L, GLM_STRING_MATRIX " must have at least two columns")
@@ -695,14 +808,28 @@ static int glmMat_auxset(lua_State *L, const TValue *obj, TValue *key, TValue *v
 /// <summary>
 /// Helper function for generalized matrix int-access
 /// </summary>
-static int matgeti (const TValue *obj, lua_Integer n, StkId res) {
+static int matgeti (lua_State *L, const TValue *obj, lua_Integer n, StkId res) {
   const grit_length_t gidx = cast(grit_length_t, n);
-  const glmMatrix &m = glm_mvalue(obj);
-  if (l_likely(gidx >= 1 && gidx <= LUAGLM_MATRIX_COLS(m.dimensions))) {
-    switch (LUAGLM_MATRIX_ROWS(m.dimensions)) {
-      case 2: glm_setvvalue2s(res, m.m42[gidx - 1], LUA_VVECTOR2); return LUA_VVECTOR2;
-      case 3: glm_setvvalue2s(res, m.m43[gidx - 1], LUA_VVECTOR3); return LUA_VVECTOR3;  // @ImplicitAlign
-      case 4: glm_setvvalue2s(res, m.m44[gidx - 1], LUA_VVECTOR4); return LUA_VVECTOR4;
+#if defined(LUAGLM_INLINE_MATRIX)
+  if (ttisinlinematrix(obj)) {  // Avoid expanding the entire matrix
+    if (l_likely(gidx >= 1 && gidx <= 2)) {
+      const lua_Float4 &f = m2value(obj);
+      const glm::vec<2, glm_Float> col(f.raw[2 * (gidx - 1)], f.raw[2 * (gidx - 1) + 1]);
+      glm_setvvalue2s(L, res, col, LUA_VVECTOR2);
+      return LUA_VVECTOR2;
+    }
+    return LUA_TNONE;
+  }
+#endif
+
+  const GCMatrix *mat = mvalue(obj);
+  if (l_likely(gidx >= 1 && gidx <= LUAGLM_MATRIX_COLS(mat->dimensions))) {
+    const grit_length_t rows = LUAGLM_MATRIX_ROWS(mat->dimensions);
+    const lua_VecF *c = matdata(mat) + (gidx - 1) * LUAGLM_MATRIX_STRIDE(rows);  // @ImplicitAlign
+    switch (rows) {
+      case 2: glm_setvvalue2s(L, res, (glm::vec<2, glm_Float>(c[0], c[1])), LUA_VVECTOR2); return LUA_VVECTOR2;
+      case 3: glm_setvvalue2s(L, res, (glm::vec<3, glm_Float>(c[0], c[1], c[2])), LUA_VVECTOR3); return LUA_VVECTOR3;
+      case 4: glm_setvvalue2s(L, res, (glm::vec<4, glm_Float>(c[0], c[1], c[2], c[3])), LUA_VVECTOR4); return LUA_VVECTOR4;
       default: {
         break;
       }
@@ -711,15 +838,29 @@ static int matgeti (const TValue *obj, lua_Integer n, StkId res) {
   return LUA_TNONE;
 }
 
-GCMatrix *glmMat_new(lua_State *L) {
-  GCObject *o = luaC_newobj(L, LUA_VMATRIX, sizeof(GCMatrix));
+GCMatrix *glmMat_new(lua_State *L, grit_length_t dimensions) {
+  const size_t n = cast_sizet(LUAGLM_MATRIX_LENGTH(dimensions));
+  GCObject *o = luaC_newobj(L, LUA_VMATRIX, sizematrix(n));
   GCMatrix *mat = gco2mat(o);
-  glm_mat_boundary(&mat->mat4) = glm::identity<glm::mat<4, 4, glm_Float>>();
+  mat->size = cast_byte(n);
+  mat->boxed = 0;
+  mat->dimensions = dimensions;
   return mat;
 }
 
-int glmMat_rawgeti(const TValue *obj, lua_Integer n, StkId res) {
-  const int result = matgeti(obj, n, res);
+void glmMat_store(lua_State *L, GCMatrix *mat, const lua_Mat4 *m) {
+  if (l_unlikely(!matfits(mat, m->dimensions))) {  // Expanded beyond its allocation
+    lua_VecF *ext = luaM_newvector(L, LUAGLM_MATRIX_LENGTH(LUAGLM_MATRIX_4x4), lua_VecF);
+    std::memcpy(ext, mat->u.v, mat->size * sizeof(lua_VecF));
+    mat->u.ext = ext;
+    mat->boxed = 1;
+  }
+  std::memcpy(matdata(mat), &m->m, LUAGLM_MATRIX_LENGTH(m->dimensions) * sizeof(lua_VecF));
+  mat->dimensions = m->dimensions;
+}
+
+int glmMat_rawgeti(lua_State *L, const TValue *obj, lua_Integer n, StkId res) {
+  const int result = matgeti(L, obj, n, res);
   if (result == LUA_TNONE) {
     setnilvalue(s2v(res));
     return LUA_TNIL;
@@ -727,16 +868,16 @@ int glmMat_rawgeti(const TValue *obj, lua_Integer n, StkId res) {
   return result;
 }
 
-int glmMat_vmgeti(const TValue *obj, lua_Integer n, StkId res) {
-  return matgeti(obj, n, res);
+int glmMat_vmgeti(lua_State *L, const TValue *obj, lua_Integer n, StkId res) {
+  return matgeti(L, obj, n, res);
 }
 
-int glmMat_rawget(const TValue *obj, TValue *key, StkId res) {
+int glmMat_rawget(lua_State *L, const TValue *obj, TValue *key, StkId res) {
   if (!ttisnumber(key)) {  // Allow float-to-int coercion
     setnilvalue(s2v(res));
     return LUA_TNIL;
   }
-  return glmMat_rawgeti(obj, glm_tointeger(key), res);
+  return glmMat_rawgeti(L, obj, glm_tointeger(key), res);
 }
 
 void glmMat_rawset(lua_State *L, const TValue *obj, TValue *key, TValue *val) {
@@ -744,13 +885,13 @@ void glmMat_rawset(lua_State *L, const TValue *obj, TValue *key, TValue *val) {
 }
 
 void glmMat_get(lua_State *L, const TValue *obj, TValue *key, StkId res) {
-  if (!ttisnumber(key) || matgeti(obj, glm_tointeger(key), res) == LUA_TNONE) {
+  if (!ttisnumber(key) || matgeti(L, obj, glm_tointeger(key), res) == LUA_TNONE) {
     vec_finishget(L, obj, key, res);
   }
 }
 
 void glmMat_geti(lua_State *L, const TValue *obj, lua_Integer c, StkId res) {
-  if (matgeti(obj, c, res) == LUA_TNONE) {
+  if (matgeti(L, obj, c, res) == LUA_TNONE) {
     TValue key;
     setivalue(&key, c);
     vec_finishget(L, obj, &key, res);
@@ -797,11 +938,11 @@ int glmMat_tostr(const TValue *obj, char *buff, size_t len) {
   return copy;
 }
 
-int glmMat_next(const TValue *obj, StkId key) {
+int glmMat_next(lua_State *L, const TValue *obj, StkId key) {
   TValue *key_value = s2v(key);
   if (ttisnil(key_value)) {
     setivalue(key_value, 1);
-    glmMat_rawgeti(obj, 1, key + 1);
+    glmMat_rawgeti(L, obj, 1, key + 1);
     return 1;
   }
   else if (ttisnumber(key_value)) {
@@ -811,7 +952,7 @@ int glmMat_next(const TValue *obj, StkId key) {
     const lua_Integer D = cast(lua_Integer, LUAGLM_MATRIX_COLS(mvalue_dims(obj)));
     if (l_nextIdx >= 1 && l_nextIdx <= D) {
       setivalue(key_value, l_nextIdx);  // Iterator values are 1-based
-      glmMat_rawgeti(obj, l_nextIdx, key + 1);
+      glmMat_rawgeti(L, obj, l_nextIdx, key + 1);
       return 1;
     }
   }
@@ -852,6 +993,142 @@ int glmMat_equalObj(lua_State *L, const TValue *o1, const TValue *o2) {
 
 /* }================================================================== */
 
+/*
+** {==================================================================
+** String Blob Views
+** ===================================================================
+*/
+#if defined(LUAGLM_EXT_BLOB)
+
+/* Number of single-precision components in an element of the given type */
+#define blob_components(T) (lua_blobsize(T) / sizeof(float))
+
+void glmBlob_load(lua_State *L, const char *p, int type, StkId res) {
+  float f[16];
+  std::memcpy(f, p, lua_blobsize(type));
+  if (type == LUA_BLOBFLOAT) {
+    setfltvalue(s2v(res), cast_num(f[0]));
+  }
+  else if (type == LUA_BLOBMAT4) {
+    GCMatrix *mat = glmMat_new(L, LUAGLM_MATRIX_4x4);
+    for (int i = 0; i < 16; ++i)
+      matdata(mat)[i] = cast(lua_VecF, f[i]);
+    glm_setmvalue2s(L, res, mat);
+  }
+  else {
+    lua_Float4 v = { { 0, 0, 0, 0 } };
+    for (size_t i = 0; i < blob_components(type); ++i)
+      v.raw[i] = cast(lua_VecF, f[i]);
+#if LUAGLM_QUAT_WXYZ  // quaternion has WXYZ layout
+    if (type == LUA_BLOBQUAT)
+      v = lua_Float4{ { v.raw[3], v.raw[0], v.raw[1], v.raw[2] } };
+#endif
+    setvvalue(L, s2v(res), v, cast_byte(makevariant(LUA_TVECTOR, type)));
+  }
+}
+
+int glmBlob_store(char *p, int type, const TValue *v) {
+  float f[16];
+  if (type == LUA_BLOBFLOAT) {
+    if (!ttisnumber(v))
+      return 0;
+    f[0] = cast(float, nvalue(v));
+  }
+  else if (type == LUA_BLOBMAT4) {
+    if (!ttismatrix(v) || mvalue_dims(v) != LUAGLM_MATRIX_4x4)
+      return 0;
+    for (int i = 0; i < 16; ++i)
+      f[i] = cast(float, matdata(mvalue(v))[i]);
+  }
+  else {
+    if (ttypetag(v) != makevariant(LUA_TVECTOR, type))
+      return 0;
+    for (size_t i = 0; i < blob_components(type); ++i)
+      f[i] = cast(float, vvalue_comp(v, i));
+#if LUAGLM_QUAT_WXYZ  // quaternion has WXYZ layout
+    if (type == LUA_BLOBQUAT) {
+      const float w = f[0];
+      f[0] = f[1]; f[1] = f[2]; f[2] = f[3]; f[3] = w;
+    }
+#endif
+  }
+  std::memcpy(p, f, lua_blobsize(type));
+  return 1;
+}
+
+/*
+** Return a pointer to the element 'key' (one-based) of the view 't', or NULL
+** if 't' is not a view or 'key' is not an in-bounds index.
+*/
+static char *blob_viewelem(lua_State *L, const TValue *t, const TValue *key, int *type) {
+  if (ttisfulluserdata(t) && ttisinteger(key)) {
+    Udata *u = uvalue(t);
+    if (u->metatable == G(L)->viewmt && u->metatable != GLM_NULLPTR
+        && u->nuvalue >= 1 && ttisblobstring(&u->uv[0].uv)) {
+      const lua_BlobView *view = reinterpret_cast<const lua_BlobView *>(getudatamem(u));
+      const TValue *blob = &u->uv[0].uv;
+      const size_t len = vslen(blob);
+      const size_t size = lua_blobsize(view->type);
+      const lua_Unsigned i = l_castS2U(ivalue(key)) - 1u;
+      if (i < view->count && view->offset <= len && i < (len - view->offset) / size) {
+        *type = view->type;
+        return svalue(blob) + view->offset + i * size;
+      }
+    }
+  }
+  return GLM_NULLPTR;
+}
+
+int glmBlob_viewget(lua_State *L, const TValue *t, const TValue *key, StkId res) {
+  int type = 0;
+  const char *p = blob_viewelem(L, t, key, &type);
+  if (p != GLM_NULLPTR) {
+    glmBlob_load(L, p, type, res);
+    luaC_checkGC(L);
+    return 1;
+  }
+  return 0;
+}
+
+int glmBlob_viewset(lua_State *L, const TValue *t, const TValue *key, const TValue *val) {
+  int type = 0;
+  char *p = blob_viewelem(L, t, key, &type);
+  return p != GLM_NULLPTR && glmBlob_store(p, type, val);
+}
+
+LUA_API int lua_blobget(lua_State *L, int idx, size_t offset, int type) {
+  int result = LUA_TNIL;
+  lua_lock(L);
+  const TValue *o = glm_index2value(L, idx);
+  if (ttisstring(o) && offset <= vslen(o) && lua_blobsize(type) <= vslen(o) - offset) {
+    glmBlob_load(L, svalue(o) + offset, type, L->top);
+    result = ttype(s2v(L->top));
+  }
+  else {
+    setnilvalue(s2v(L->top));
+  }
+  api_incr_top(L);
+  luaC_checkGC(L);
+  lua_unlock(L);
+  return result;
+}
+
+LUA_API int lua_blobset(lua_State *L, int idx, size_t offset, int type) {
+  int result = 0;
+  lua_lock(L);
+  api_checknelems(L, 1);
+  const TValue *o = glm_index2value(L, idx);
+  if (ttisblobstring(o) && offset <= vslen(o) && lua_blobsize(type) <= vslen(o) - offset) {
+    result = glmBlob_store(svalue(o) + offset, type, s2v(L->top - 1));
+  }
+  L->top--;
+  lua_unlock(L);
+  return result;
+}
+
+#endif
+/* }================================================================== */
+
 /*
 ** {==================================================================
 ** GLM Interface
@@ -898,8 +1175,9 @@ LUAGLM_API int glm_pushvec(lua_State *L, const glmVector &v, glm::length_t dimen
   GLM_STATIC_ASSERT(LUAGLM_Q == glm::defaultp, "LUAGLM_QUALIFIER");  // Sanitize LUAGLM_FORCES_ALIGNED_GENTYPES
   if (l_likely(dimensions >= 2 && dimensions <= 4)) {
     lua_lock(L);
-    glm_setvvalue2s(L->top, v, glm_variant(dimensions));
+    glm_setvvalue2s(L, L->top, v, glm_variant(dimensions));
     api_incr_top(L);
+    luaC_checkvecGC(L);
     lua_unlock(L);
   }
   else if (dimensions == 1)  // @ImplicitVec
@@ -916,8 +1194,9 @@ LUAGLM_API int glm_pushvec(lua_State *L, const glmVector &v, glm::length_t dimen
 LUAGLM_API int glm_pushvec_quat(lua_State *L, const glmVector &q) {
   GLM_STATIC_ASSERT(LUAGLM_Q == glm::defaultp, "LUAGLM_QUALIFIER");
   lua_lock(L);
-  glm_setvvalue2s(L->top, q, LUA_VQUAT);
+  glm_setvvalue2s(L, L->top, q, LUA_VQUAT);
   api_incr_top(L);
+  luaC_checkvecGC(L);
   lua_unlock(L);
   return 1;
 }
@@ -935,8 +1214,16 @@ LUAGLM_API int glm_pushmat(lua_State *L, const glmMatrix &m) {
 #endif
 
   lua_lock(L);
-  mat = glmMat_new(L);
-  glm_mat_boundary(&mat->mat4) = m;
+#if defined(LUAGLM_INLINE_MATRIX)
+  if (m.dimensions == LUAGLM_MATRIX_2x2) {
+    glm_setm2value2s(L, L->top, m.m22);
+    api_incr_top(L);
+    lua_unlock(L);
+    return 1;
+  }
+#endif
+  mat = glmMat_new(L, m.dimensions);
+  glm_mstore(L, mat, m);
   glm_setmvalue2s(L, L->top, mat);
   api_incr_top(L);
   luaC_checkGC(L);
@@ -1468,9 +1755,10 @@ static int glm_createMatrix(lua_State *L, glm::length_t dimensions) {
       }
 
       // The first argument was a 'matrix' intended to be recycled. The stack
-      // *should* be untouched during PopulateMatrix so using 'o' should be safe
-      if (recycle) {
-        glm_mat_boundary(mvalue_ref(o)) = result;
+      // *should* be untouched during PopulateMatrix so using 'o' should be safe.
+      // Inline matrices are values: a new matrix is pushed instead.
+      if (recycle && ttisfullmatrix(o)) {
+        glm_mstore(L, mvalue(o), result);
         lua_unlock(L);
         lua_pushvalue(L, 1);
         return 1;
@@ -1577,6 +1865,7 @@ LUA_API const char *glm_typename(lua_State *L, int idx) {
     case LUA_VVECTOR4: return GLM_STRING_VECTOR4;
     case LUA_VQUAT: return GLM_STRING_QUATERN;
     case LUA_VMATRIX: return GLM_STRING_MATRIX;
+    case LUA_VMATRIX2: return GLM_STRING_MATRIX;
     default: {
       return "Unknown GLM Type";
     }
@@ -1875,8 +2164,9 @@ LUA_API void lua_pushvector(lua_State *L, lua_Float4 f4, int variant) {
       f4 = lua_Float4{ { f4.raw[3], f4.raw[0], f4.raw[1], f4.raw[2] } };
 #endif
     lua_lock(L);
-    setvvalue(s2v(L->top), f4, cast_byte(withvariant(variant)));
+    setvvalue(L, s2v(L->top), f4, cast_byte(withvariant(variant)));
     api_incr_top(L);
+    luaC_checkvecGC(L);
     lua_unlock(L);
   }
   else if (variant == LUA_VVECTOR1)  // @ImplicitVec
@@ -1895,8 +2185,9 @@ LUA_API void lua_pushquatf4(lua_State *L, lua_Float4 f4) {
   f4 = lua_Float4{ { f4.raw[3], f4.raw[0], f4.raw[1], f4.raw[2] } };
 #endif
   lua_lock(L);
-  setvvalue(s2v(L->top), f4, LUA_VQUAT);
+  setvvalue(L, s2v(L->top), f4, LUA_VQUAT);
   api_incr_top(L);
+  luaC_checkvecGC(L);
   lua_unlock(L);
 }
 
@@ -1920,7 +2211,7 @@ LUA_API int lua_tomatrix(lua_State *L, int idx, lua_Mat4 *matrix) {
   const TValue *o = glm_index2value(L, idx);
   if (l_likely(ttismatrix(o) && matrix != GLM_NULLPTR)) {
     result = 1;
-    *matrix = mvalue(o);
+    glm_mat_boundary(matrix) = glm_mvalue(o);
   }
   lua_unlock(L);
   return result;
@@ -1963,15 +2254,54 @@ LUA_API void lua_pushmatrix(lua_State *L, const lua_Mat4 *matrix) {
 ** A dimension override is included to simplify the below logic for operations
 ** that operate on a per-value basis. Allowing the use of more generalized
 ** operations instead of logic for all nine matrix types.
+**
+** @LUAGLM_EXT_INPLACE: If the first operand is a dying temporary, i.e., the
+** unshared result of the previous arithmetic operation (see OP_MMBIN), its
+** storage is overwritten instead; 'x' is evaluated before the store.
+**
+** @LUAGLM_INLINE_MATRIX: 2x2 results are stored inline; the first four
+** components of 'x' are used when the operation is over the m44 member.
 */
-#define glm_newmvalue(L, obj, x, dims)  \
-  LUA_MLM_BEGIN                         \
-  GCMatrix *mat = glmMat_new(L);        \
-  glm_mat_boundary(&(mat->mat4)) = (x); \
-  mat->mat4.dimensions = dims;          \
-  glm_setmvalue2s(L, obj, mat);         \
-  luaC_checkGC(L);                      \
+#if defined(LUAGLM_INLINE_MATRIX)
+#define glm_newmvalue(L, obj, x, dims)            \
+  LUA_MLM_BEGIN                                   \
+  if ((dims) == LUAGLM_MATRIX_2x2) {              \
+    glm_setm2value2s(L, obj, glmMatrix((x)).m22); \
+  }                                               \
+  else {                                          \
+    glm_newgcmvalue(L, obj, x, dims);             \
+  }                                               \
+  LUA_MLM_END
+#else
+#define glm_newmvalue(L, obj, x, dims) glm_newgcmvalue(L, obj, x, dims)
+#endif
+
+#if defined(LUAGLM_EXT_INPLACE)
+#define glm_newgcmvalue(L, obj, x, dims)                                          \
+  LUA_MLM_BEGIN                                                                   \
+  global_State *g_ = G(L);                                                        \
+  GCObject *dead_ = g_->deadmat;                                                  \
+  g_->deadmat = NULL; /* cleared before any allocation may raise an error */      \
+  glmMatrix m_(x);                                                                \
+  m_.dimensions = dims;                                                           \
+  GCMatrix *mat = (dead_ != GLM_NULLPTR && matfits(gco2mat(dead_), m_.dimensions)) \
+                  ? gco2mat(dead_) : glmMat_new(L, m_.dimensions);               \
+  glm_mstore(L, mat, m_);                                                         \
+  g_->lastmat = obj2gco(mat);                                                     \
+  glm_setmvalue2s(L, obj, mat);                                                   \
+  luaC_checkGC(L);                                                                \
+  LUA_MLM_END
+#else
+#define glm_newgcmvalue(L, obj, x, dims)              \
+  LUA_MLM_BEGIN                                       \
+  glmMatrix m_(x);                                    \
+  m_.dimensions = dims;                               \
+  GCMatrix *mat = glmMat_new(L, m_.dimensions);       \
+  glm_mstore(L, mat, m_);                             \
+  glm_setmvalue2s(L, obj, mat);                       \
+  luaC_checkGC(L);                                    \
   LUA_MLM_END
+#endif
 
 /*
 ** Operations on integer vectors (or floating-point vectors that are int-casted).
@@ -1980,14 +2310,14 @@ LUA_API void lua_pushmatrix(lua_State *L, const lua_Mat4 *matrix) {
   LUA_MLM_BEGIN                                     \
   if ((t1) == (t2)) { /* @GLMIndependent */         \
     const glmVector &v2 = glm_vvalue(p2);           \
-    glm_setvvalue2s(res, F(                         \
+    glm_setvvalue2s(L, res, F(                         \
       glm::vec<4, lua_Integer, LUAGLM_Q>((v).v4),   \
       glm::vec<4, lua_Integer, LUAGLM_Q>((v2).v4)   \
     ), (t1));                                       \
     return 1;                                       \
   }                                                 \
   else if ((t2) == LUA_VNUMINT) {                   \
-    glm_setvvalue2s(res, F(                         \
+    glm_setvvalue2s(L, res, F(                         \
       glm::vec<4, lua_Integer, LUAGLM_Q>((v).v4),   \
       ivalue(p2)                                    \
     ), (t1));                                       \
@@ -2023,7 +2353,7 @@ static int num_trybinTM(lua_State *L, const TValue *p1, const TValue *p2, StkId
     case TM_ADD: {
       switch (ttype(p2)) {
         case LUA_TVECTOR:
-          glm_setvvalue2s(res, operator+(s, glm_v4value(p2)), ttypetag(p2));
+          glm_setvvalue2s(L, res, operator+(s, glm_v4value(p2)), ttypetag(p2));
           return 1;
         case LUA_TMATRIX: {
           // GLM only supports operator+(T, mat...) on symmetric matrices. This
@@ -2041,7 +2371,7 @@ static int num_trybinTM(lua_State *L, const TValue *p1, const TValue *p2, StkId
     case TM_SUB: {  // @GLMIndependent
       switch (ttype(p2)) {
         case LUA_TVECTOR:
-          glm_setvvalue2s(res, operator-(s, glm_v4value(p2)), ttypetag(p2));
+          glm_setvvalue2s(L, res, operator-(s, glm_v4value(p2)), ttypetag(p2));
           return 1;
         case LUA_TMATRIX: {
           const glmMatrix &m2 = glm_mvalue(p2);
@@ -2059,12 +2389,13 @@ static int num_trybinTM(lua_State *L, const TValue *p1, const TValue *p2, StkId
         case LUA_VVECTOR2:
         case LUA_VVECTOR3:
         case LUA_VVECTOR4:
-          glm_setvvalue2s(res, operator*(s, glm_v4value(p2)), ttypetag(p2));
+          glm_setvvalue2s(L, res, operator*(s, glm_v4value(p2)), ttypetag(p2));
           return 1;
         case LUA_VQUAT:
-          glm_setvvalue2s(res, operator*(s, glm_qvalue(p2)), LUA_VQUAT);
+          glm_setvvalue2s(L, res, operator*(s, glm_qvalue(p2)), LUA_VQUAT);
           return 1;
-        case LUA_VMATRIX: {
+        case LUA_VMATRIX:
+        case LUA_VMATRIX2: {
           const glmMatrix &m2 = glm_mvalue(p2);
           glm_newmvalue(L, res, operator*(s, m2.m44), m2.dimensions);
           return 1;
@@ -2081,9 +2412,10 @@ static int num_trybinTM(lua_State *L, const TValue *p1, const TValue *p2, StkId
         case LUA_VVECTOR3:
         case LUA_VVECTOR4:
         case LUA_VQUAT:
-          glm_setvvalue2s(res, operator/(s, glm_v4value(p2)), ttypetag(p2));
+          glm_setvvalue2s(L, res, operator/(s, glm_v4value(p2)), ttypetag(p2));
           return 1;
-        case LUA_VMATRIX: {
+        case LUA_VMATRIX:
+        case LUA_VMATRIX2: {
           const glmMatrix &m2 = glm_mvalue(p2);
           glm_newmvalue(L, res, operator/(s, m2.m44), m2.dimensions);
           return 1;
@@ -2102,28 +2434,28 @@ static int num_trybinTM(lua_State *L, const TValue *p1, const TValue *p2, StkId
 }
 
 static int vec_trybinTM(lua_State *L, const TValue *p1, const TValue *p2, StkId res, TMS event) {
-  UNUSED(L);
+  cast_void(L);
   const glmVector &v = glm_vvalue(p1);
   const lu_byte tt_p1 = ttypetag(p1);
   switch (event) {
     case TM_ADD: {  // @GLMIndependent
       if (tt_p1 == ttypetag(p2)) {
-        glm_setvvalue2s(res, operator+(v.v4, glm_v4value(p2)), tt_p1);
+        glm_setvvalue2s(L, res, operator+(v.v4, glm_v4value(p2)), tt_p1);
         return 1;
       }
       else if (ttype(p2) == LUA_TNUMBER) {
-        glm_setvvalue2s(res, operator+(v.v4, glm_toflt(p2)), tt_p1);
+        glm_setvvalue2s(L, res, operator+(v.v4, glm_toflt(p2)), tt_p1);
         return 1;
       }
       break;
     }
     case TM_SUB: {  // @GLMIndependent
       if (tt_p1 == ttypetag(p2)) {
-        glm_setvvalue2s(res, operator-(v.v4, glm_v4value(p2)), tt_p1);
+        glm_setvvalue2s(L, res, operator-(v.v4, glm_v4value(p2)), tt_p1);
         return 1;
       }
       else if (ttype(p2) == LUA_TNUMBER) {
-        glm_setvvalue2s(res, operator-(v.v4, glm_toflt(p2)), tt_p1);
+        glm_setvvalue2s(L, res, operator-(v.v4, glm_toflt(p2)), tt_p1);
         return 1;
       }
       break;
@@ -2131,11 +2463,11 @@ static int vec_trybinTM(lua_State *L, const TValue *p1, const TValue *p2, StkId
     case TM_MUL: {  // @GLMIndependent
       const lu_byte tt_p2 = ttypetag(p2);
       if (tt_p1 == tt_p2) {
-        glm_setvvalue2s(res, operator*(v.v4, glm_v4value(p2)), tt_p1);
+        glm_setvvalue2s(L, res, operator*(v.v4, glm_v4value(p2)), tt_p1);
         return 1;
       }
       else if (ttype(p2) == LUA_TNUMBER) {
-        glm_setvvalue2s(res, operator*(v.v4, glm_toflt(p2)), tt_p1);
+        glm_setvvalue2s(L, res, operator*(v.v4, glm_toflt(p2)), tt_p1);
         return 1;
       }
       else if (tt_p2 == LUA_VQUAT) {
@@ -2145,12 +2477,12 @@ static int vec_trybinTM(lua_State *L, const TValue *p1, const TValue *p2, StkId
             const glm::vec<3, glm_Float, glm::qualifier::highp> vx(v.v3);
             const glm::qua<glm_Float, glm::qualifier::highp> qy(glm_qvalue(p2));
             const glm::vec<3, glm_Float> result(vx * qy);
-            glm_setvvalue2s(res, result, LUA_VVECTOR3);
+            glm_setvvalue2s(L, res, result, LUA_VVECTOR3);
             return 1;
           }
 #else
           case LUA_VVECTOR3: {
-            glm_setvvalue2s(res, v.v3 * glm_qvalue(p2), LUA_VVECTOR3);
+            glm_setvvalue2s(L, res, v.v3 * glm_qvalue(p2), LUA_VVECTOR3);
             return 1;
           }
 #endif
@@ -2159,12 +2491,12 @@ static int vec_trybinTM(lua_State *L, const TValue *p1, const TValue *p2, StkId
             const glm::vec<4, glm_Float, glm::qualifier::highp> vx(v.v4);
             const glm::qua<glm_Float, glm::qualifier::highp> qy(glm_qvalue(p2));
             const glm::vec<4, glm_Float> result(vx * qy);
-            glm_setvvalue2s(res, result, LUA_VVECTOR4);
+            glm_setvvalue2s(L, res, result, LUA_VVECTOR4);
             return 1;
           }
 #else
           case LUA_VVECTOR4: {
-            glm_setvvalue2s(res, operator*(v.v4, glm_qvalue(p2)), LUA_VVECTOR4);
+            glm_setvvalue2s(L, res, operator*(v.v4, glm_qvalue(p2)), LUA_VVECTOR4);
             return 1;
           }
 #endif
@@ -2173,19 +2505,19 @@ static int vec_trybinTM(lua_State *L, const TValue *p1, const TValue *p2, StkId
           }
         }
       }
-      else if (tt_p2 == LUA_VMATRIX) {
+      else if (ttismatrix(p2)) {
         const glmMatrix &m2 = glm_mvalue(p2);
         if (LUAGLM_MATRIX_ROWS(m2.dimensions) == glm_dimensions(tt_p1)) {
           switch (m2.dimensions) {
-            case LUAGLM_MATRIX_2x2: glm_setvvalue2s(res, operator*(v.v2, m2.m22), LUA_VVECTOR2); return 1;
-            case LUAGLM_MATRIX_2x3: glm_setvvalue2s(res, operator*(v.v3, m2.m23), LUA_VVECTOR2); return 1;
-            case LUAGLM_MATRIX_2x4: glm_setvvalue2s(res, operator*(v.v4, m2.m24), LUA_VVECTOR2); return 1;
-            case LUAGLM_MATRIX_3x2: glm_setvvalue2s(res, operator*(v.v2, m2.m32), LUA_VVECTOR3); return 1;
-            case LUAGLM_MATRIX_3x3: glm_setvvalue2s(res, operator*(v.v3, m2.m33), LUA_VVECTOR3); return 1;
-            case LUAGLM_MATRIX_3x4: glm_setvvalue2s(res, operator*(v.v4, m2.m34), LUA_VVECTOR3); return 1;
-            case LUAGLM_MATRIX_4x2: glm_setvvalue2s(res, operator*(v.v2, m2.m42), LUA_VVECTOR4); return 1;
-            case LUAGLM_MATRIX_4x3: glm_setvvalue2s(res, operator*(v.v3, m2.m43), LUA_VVECTOR4); return 1;
-            case LUAGLM_MATRIX_4x4: glm_setvvalue2s(res, operator*(v.v4, m2.m44), LUA_VVECTOR4); return 1;
+            case LUAGLM_MATRIX_2x2: glm_setvvalue2s(L, res, operator*(v.v2, m2.m22), LUA_VVECTOR2); return 1;
+            case LUAGLM_MATRIX_2x3: glm_setvvalue2s(L, res, operator*(v.v3, m2.m23), LUA_VVECTOR2); return 1;
+            case LUAGLM_MATRIX_2x4: glm_setvvalue2s(L, res, operator*(v.v4, m2.m24), LUA_VVECTOR2); return 1;
+            case LUAGLM_MATRIX_3x2: glm_setvvalue2s(L, res, operator*(v.v2, m2.m32), LUA_VVECTOR3); return 1;
+            case LUAGLM_MATRIX_3x3: glm_setvvalue2s(L, res, operator*(v.v3, m2.m33), LUA_VVECTOR3); return 1;
+            case LUAGLM_MATRIX_3x4: glm_setvvalue2s(L, res, operator*(v.v4, m2.m34), LUA_VVECTOR3); return 1;
+            case LUAGLM_MATRIX_4x2: glm_setvvalue2s(L, res, operator*(v.v2, m2.m42), LUA_VVECTOR4); return 1;
+            case LUAGLM_MATRIX_4x3: glm_setvvalue2s(L, res, operator*(v.v3, m2.m43), LUA_VVECTOR4); return 1;
+            case LUAGLM_MATRIX_4x4: glm_setvvalue2s(L, res, operator*(v.v4, m2.m44), LUA_VVECTOR4); return 1;
             default: {
               break;
             }
@@ -2196,22 +2528,22 @@ static int vec_trybinTM(lua_State *L, const TValue *p1, const TValue *p2, StkId
     }
     case TM_MOD: {  // @GLMIndependent; Using fmod for the same reasons described in llimits.h
       if (tt_p1 == ttypetag(p2)) {
-        glm_setvvalue2s(res, glm::fmod(v.v4, glm_v4value(p2)), tt_p1);
+        glm_setvvalue2s(L, res, glm::fmod(v.v4, glm_v4value(p2)), tt_p1);
         return 1;
       }
       else if (ttype(p2) == LUA_TNUMBER) {
-        glm_setvvalue2s(res, glm::fmod(v.v4, glm_toflt(p2)), tt_p1);
+        glm_setvvalue2s(L, res, glm::fmod(v.v4, glm_toflt(p2)), tt_p1);
         return 1;
       }
       break;
     }
     case TM_POW: {  // @GLMIndependent
       if (tt_p1 == ttypetag(p2)) {
-        glm_setvvalue2s(res, glm::pow(v.v4, glm_v4value(p2)), tt_p1);
+        glm_setvvalue2s(L, res, glm::pow(v.v4, glm_v4value(p2)), tt_p1);
         return 1;
       }
       else if (ttype(p2) == LUA_TNUMBER) {
-        glm_setvvalue2s(res, glm::pow(v.v4, decltype(v.v4)(glm_toflt(p2))), tt_p1);
+        glm_setvvalue2s(L, res, glm::pow(v.v4, decltype(v.v4)(glm_toflt(p2))), tt_p1);
         return 1;
       }
       break;
@@ -2219,21 +2551,21 @@ static int vec_trybinTM(lua_State *L, const TValue *p1, const TValue *p2, StkId
     case TM_DIV: {  // @GLMIndependent
       const lu_byte tt_p2 = ttypetag(p2);
       if (tt_p1 == tt_p2) {
-        glm_setvvalue2s(res, operator/(v.v4, glm_v4value(p2)), tt_p1);
+        glm_setvvalue2s(L, res, operator/(v.v4, glm_v4value(p2)), tt_p1);
         return 1;
       }
       else if (ttype(p2) == LUA_TNUMBER) {
-        glm_setvvalue2s(res, operator/(v.v4, glm_toflt(p2)), tt_p1);
+        glm_setvvalue2s(L, res, operator/(v.v4, glm_toflt(p2)), tt_p1);
         return 1;
       }
-      else if (tt_p2 == LUA_VMATRIX) {
+      else if (ttismatrix(p2)) {
         const glmMatrix &m2 = glm_mvalue(p2);
         const grit_length_t cols = LUAGLM_MATRIX_COLS(m2.dimensions);
         if (cols == LUAGLM_MATRIX_ROWS(m2.dimensions) && tt_p1 == glm_variant(cols)) {
           switch (tt_p1) {
-            case LUA_VVECTOR2: glm_setvvalue2s(res, operator/(v.v2, m2.m22), LUA_VVECTOR2); return 1;
-            case LUA_VVECTOR3: glm_setvvalue2s(res, operator/(v.v3, m2.m33), LUA_VVECTOR3); return 1;
-            case LUA_VVECTOR4: glm_setvvalue2s(res, operator/(v.v4, m2.m44), LUA_VVECTOR4); return 1;
+            case LUA_VVECTOR2: glm_setvvalue2s(L, res, operator/(v.v2, m2.m22), LUA_VVECTOR2); return 1;
+            case LUA_VVECTOR3: glm_setvvalue2s(L, res, operator/(v.v3, m2.m33), LUA_VVECTOR3); return 1;
+            case LUA_VVECTOR4: glm_setvvalue2s(L, res, operator/(v.v4, m2.m44), LUA_VVECTOR4); return 1;
             default: {
               break;
             }
@@ -2245,11 +2577,11 @@ static int vec_trybinTM(lua_State *L, const TValue *p1, const TValue *p2, StkId
     }
     case TM_IDIV: {  // @GLMIndependent
       if (tt_p1 == ttypetag(p2)) {
-        glm_setvvalue2s(res, glm::floor(v.v4 / glm_v4value(p2)), tt_p1);
+        glm_setvvalue2s(L, res, glm::floor(v.v4 / glm_v4value(p2)), tt_p1);
         return 1;
       }
       else if (ttype(p2) == LUA_TNUMBER) {
-        glm_setvvalue2s(res, glm::floor(v.v4 / glm_toflt(p2)), tt_p1);
+        glm_setvvalue2s(L, res, glm::floor(v.v4 / glm_toflt(p2)), tt_p1);
         return 1;
       }
       break;
@@ -2270,10 +2602,10 @@ static int vec_trybinTM(lua_State *L, const TValue *p1, const TValue *p2, StkId
       INT_VECTOR_OPERATION(operator>>, res, v, p2, tt_p1, ttypetag(p2));
       break;
     case TM_UNM:  // @GLMIndependent
-      glm_setvvalue2s(res, operator-(v.v4), tt_p1);
+      glm_setvvalue2s(L, res, operator-(v.v4), tt_p1);
       return 1;
     case TM_BNOT:  // @GLMIndependent
-      glm_setvvalue2s(res, operator~(glm::vec<4, lua_Integer, LUAGLM_Q>(v.v4)), tt_p1);
+      glm_setvvalue2s(L, res, operator~(glm::vec<4, lua_Integer, LUAGLM_Q>(v.v4)), tt_p1);
       return 1;
     default: {
       break;
@@ -2283,17 +2615,17 @@ static int vec_trybinTM(lua_State *L, const TValue *p1, const TValue *p2, StkId
 }
 
 static int quat_trybinTM(lua_State *L, const TValue *p1, const TValue *p2, StkId res, TMS event) {
-  UNUSED(L);
+  cast_void(L);
   const glmVector &v = glm_vvalue(p1);
   switch (event) {
     case TM_ADD: {
       if (ttypetag(p2) == LUA_VQUAT) {
-        glm_setvvalue2s(res, operator+(glm_qvalue(p1), glm_qvalue(p2)), LUA_VQUAT);
+        glm_setvvalue2s(L, res, operator+(glm_qvalue(p1), glm_qvalue(p2)), LUA_VQUAT);
         return 1;
       }
       else if (ttype(p2) == LUA_TNUMBER) {
         // @GLMIndependent; Not supported by GLM but allow vector semantics.
-        glm_setvvalue2s(res, operator+(v.v4, glm_toflt(p2)), LUA_VQUAT);
+        glm_setvvalue2s(L, res, operator+(v.v4, glm_toflt(p2)), LUA_VQUAT);
         return 1;
       }
       break;
@@ -2303,16 +2635,16 @@ static int quat_trybinTM(lua_State *L, const TValue *p1, const TValue *p2, StkId
 #if defined(LUAGLM_ALIGNED)  // @QuatHack
         const glm::qua<glm_Float, glm::qualifier::highp> qx(glm_qvalue(p1));
         const glm::qua<glm_Float, glm::qualifier::highp> qy(glm_qvalue(p2));
-        glm_setvvalue2s(res, glm::qua<glm_Float>(qx - qy), LUA_VQUAT);
+        glm_setvvalue2s(L, res, glm::qua<glm_Float>(qx - qy), LUA_VQUAT);
         return 1;
 #else
-        glm_setvvalue2s(res, operator-(glm_qvalue(p1), glm_qvalue(p2)), LUA_VQUAT);
+        glm_setvvalue2s(L, res, operator-(glm_qvalue(p1), glm_qvalue(p2)), LUA_VQUAT);
         return 1;
 #endif
       }
       else if (ttype(p2) == LUA_TNUMBER) {
         // @GLMIndependent; Not supported by GLM but allow vector semantics.
-        glm_setvvalue2s(res, operator-(v.v4, glm_toflt(p2)), LUA_VQUAT);
+        glm_setvvalue2s(L, res, operator-(v.v4, glm_toflt(p2)), LUA_VQUAT);
         return 1;
       }
       break;
@@ -2320,22 +2652,22 @@ static int quat_trybinTM(lua_State *L, const TValue *p1, const TValue *p2, StkId
     case TM_MUL: {
       switch (ttypetag(p2)) {
         case LUA_VNUMINT:
-          glm_setvvalue2s(res, operator*(v.q, glm_castfloat(ivalue(p2))), LUA_VQUAT);
+          glm_setvvalue2s(L, res, operator*(v.q, glm_castfloat(ivalue(p2))), LUA_VQUAT);
           return 1;
         case LUA_VNUMFLT:
-          glm_setvvalue2s(res, operator*(v.q, glm_castfloat(fltvalue(p2))), LUA_VQUAT);
+          glm_setvvalue2s(L, res, operator*(v.q, glm_castfloat(fltvalue(p2))), LUA_VQUAT);
           return 1;
 #if defined(LUAGLM_FORCE_HIGHP)  // @GCCHack
         case LUA_VVECTOR3: {
           const glm::qua<glm_Float, glm::qualifier::highp> qx(glm_qvalue(p1));
           const glm::vec<3, glm_Float, glm::qualifier::highp> vy(glm_v3value(p2));
           const glm::vec<3, glm_Float> result(qx * vy);
-          glm_setvvalue2s(res, result, LUA_VVECTOR3);
+          glm_setvvalue2s(L, res, result, LUA_VVECTOR3);
           return 1;
         }
 #else
         case LUA_VVECTOR3:
-          glm_setvvalue2s(res, operator*(v.q, glm_v3value(p2)), LUA_VVECTOR3);
+          glm_setvvalue2s(L, res, operator*(v.q, glm_v3value(p2)), LUA_VVECTOR3);
           return 1;
 #endif
 #if defined(LUAGLM_ALIGNED)  // @QuatHack
@@ -2343,16 +2675,16 @@ static int quat_trybinTM(lua_State *L, const TValue *p1, const TValue *p2, StkId
           const glm::qua<glm_Float, glm::qualifier::highp> qx(glm_qvalue(p1));
           const glm::vec<4, glm_Float, glm::qualifier::highp> vy(glm_v4value(p2));
           const glm::vec<4, glm_Float> result(qx * vy);
-          glm_setvvalue2s(res, result, LUA_VVECTOR4);
+          glm_setvvalue2s(L, res, result, LUA_VVECTOR4);
           return 1;
         }
 #else
         case LUA_VVECTOR4:
-          glm_setvvalue2s(res, operator*(v.q, glm_v4value(p2)), LUA_VVECTOR4);
+          glm_setvvalue2s(L, res, operator*(v.q, glm_v4value(p2)), LUA_VVECTOR4);
           return 1;
 #endif
         case LUA_VQUAT:
-          glm_setvvalue2s(res, operator*(v.q, glm_qvalue(p2)), LUA_VQUAT);
+          glm_setvvalue2s(L, res, operator*(v.q, glm_qvalue(p2)), LUA_VQUAT);
           return 1;
         default: {
           break;
@@ -2362,7 +2694,7 @@ static int quat_trybinTM(lua_State *L, const TValue *p1, const TValue *p2, StkId
     }
     case TM_POW: {
       if (ttype(p2) == LUA_TNUMBER) {
-        glm_setvvalue2s(res, glm::pow(v.q, glm_toflt(p2)), LUA_VQUAT);
+        glm_setvvalue2s(L, res, glm::pow(v.q, glm_toflt(p2)), LUA_VQUAT);
         return 1;
       }
       break;
@@ -2375,13 +2707,13 @@ static int quat_trybinTM(lua_State *L, const TValue *p1, const TValue *p2, StkId
           result = v.q / s;
         }
 
-        glm_setvvalue2s(res, result, LUA_VQUAT);
+        glm_setvvalue2s(L, res, result, LUA_VQUAT);
         return 1;
       }
       break;
     }
     case TM_UNM:
-      glm_setvvalue2s(res, operator-(v.q), LUA_VQUAT);
+      glm_setvvalue2s(L, res, operator-(v.q), LUA_VQUAT);
       return 1;
     default: {
       break;
@@ -2395,7 +2727,7 @@ static int mat_trybinTM(lua_State *L, const TValue *p1, const TValue *p2, StkId
   const grit_length_t cols = LUAGLM_MATRIX_COLS(m.dimensions);
   switch (event) {
     case TM_ADD: {  // @GLMIndependent
-      if (ttypetag(p2) == LUA_VMATRIX && m.dimensions == mvalue_dims(p2)) {
+      if (ttismatrix(p2) && m.dimensions == mvalue_dims(p2)) {
         const glmMatrix &m2 = glm_mvalue(p2);
         glm_newmvalue(L, res, operator+(m.m44, m2.m44), m.dimensions);
         return 1;
@@ -2407,7 +2739,7 @@ static int mat_trybinTM(lua_State *L, const TValue *p1, const TValue *p2, StkId
       break;
     }
     case TM_SUB: {  // @GLMIndependent
-      if (ttypetag(p2) == LUA_VMATRIX && m.dimensions == mvalue_dims(p2)) {
+      if (ttismatrix(p2) && m.dimensions == mvalue_dims(p2)) {
         const glmMatrix &m2 = glm_mvalue((p2));
         glm_newmvalue(L, res, operator-(m.m44, m2.m44), m.dimensions);
         return 1;
@@ -2420,7 +2752,7 @@ static int mat_trybinTM(lua_State *L, const TValue *p1, const TValue *p2, StkId
     }
     case TM_MUL: {
       const lu_byte tt_p2 = ttypetag(p2);
-      if (tt_p2 == LUA_VMATRIX) {
+      if (ttismatrix(p2)) {
         const glmMatrix &m2 = glm_mvalue(p2);
         if (cols == LUAGLM_MATRIX_ROWS(m2.dimensions)) {
           switch (m.dimensions) {
@@ -2442,15 +2774,15 @@ static int mat_trybinTM(lua_State *L, const TValue *p1, const TValue *p2, StkId
       else if (tt_p2 == glm_variant(cols)) {
         const glmVector &v2 = glm_vvalue(p2);
         switch (m.dimensions) {
-          case LUAGLM_MATRIX_2x2: glm_setvvalue2s(res, operator*(m.m22, v2.v2), LUA_VVECTOR2); return 1;
-          case LUAGLM_MATRIX_2x3: glm_setvvalue2s(res, operator*(m.m23, v2.v2), LUA_VVECTOR3); return 1;
-          case LUAGLM_MATRIX_2x4: glm_setvvalue2s(res, operator*(m.m24, v2.v2), LUA_VVECTOR4); return 1;
-          case LUAGLM_MATRIX_3x2: glm_setvvalue2s(res, operator*(m.m32, v2.v3), LUA_VVECTOR2); return 1;
-          case LUAGLM_MATRIX_3x3: glm_setvvalue2s(res, operator*(m.m33, v2.v3), LUA_VVECTOR3); return 1;
-          case LUAGLM_MATRIX_3x4: glm_setvvalue2s(res, operator*(m.m34, v2.v3), LUA_VVECTOR4); return 1;
-          case LUAGLM_MATRIX_4x2: glm_setvvalue2s(res, operator*(m.m42, v2.v4), LUA_VVECTOR2); return 1;
-          case LUAGLM_MATRIX_4x3: glm_setvvalue2s(res, operator*(m.m43, v2.v4), LUA_VVECTOR3); return 1;
-          case LUAGLM_MATRIX_4x4: glm_setvvalue2s(res, operator*(m.m44, v2.v4), LUA_VVECTOR4); return 1;
+          case LUAGLM_MATRIX_2x2: glm_setvvalue2s(L, res, operator*(m.m22, v2.v2), LUA_VVECTOR2); return 1;
+          case LUAGLM_MATRIX_2x3: glm_setvvalue2s(L, res, operator*(m.m23, v2.v2), LUA_VVECTOR3); return 1;
+          case LUAGLM_MATRIX_2x4: glm_setvvalue2s(L, res, operator*(m.m24, v2.v2), LUA_VVECTOR4); return 1;
+          case LUAGLM_MATRIX_3x2: glm_setvvalue2s(L, res, operator*(m.m32, v2.v3), LUA_VVECTOR2); return 1;
+          case LUAGLM_MATRIX_3x3: glm_setvvalue2s(L, res, operator*(m.m33, v2.v3), LUA_VVECTOR3); return 1;
+          case LUAGLM_MATRIX_3x4: glm_setvvalue2s(L, res, operator*(m.m34, v2.v3), LUA_VVECTOR4); return 1;
+          case LUAGLM_MATRIX_4x2: glm_setvvalue2s(L, res, operator*(m.m42, v2.v4), LUA_VVECTOR2); return 1;
+          case LUAGLM_MATRIX_4x3: glm_setvvalue2s(L, res, operator*(m.m43, v2.v4), LUA_VVECTOR3); return 1;
+          case LUAGLM_MATRIX_4x4: glm_setvvalue2s(L, res, operator*(m.m44, v2.v4), LUA_VVECTOR4); return 1;
           default: {
             break;
           }
@@ -2460,8 +2792,8 @@ static int mat_trybinTM(lua_State *L, const TValue *p1, const TValue *p2, StkId
       else if (tt_p2 == LUA_VVECTOR3) {
         const glm::mat<4, 4, glm_Float>::col_type p(glm_v3value(p2), MAT_VEC3_W);
         switch (m.dimensions) {
-          case LUAGLM_MATRIX_4x3: glm_setvvalue2s(res, operator*(m.m43, p), LUA_VVECTOR3); return 1;
-          case LUAGLM_MATRIX_4x4: glm_setvvalue2s(res, operator*(m.m44, p), LUA_VVECTOR3); return 1;
+          case LUAGLM_MATRIX_4x3: glm_setvvalue2s(L, res, operator*(m.m43, p), LUA_VVECTOR3); return 1;
+          case LUAGLM_MATRIX_4x4: glm_setvvalue2s(L, res, operator*(m.m44, p), LUA_VVECTOR3); return 1;
           default:
             break;
         }
@@ -2475,7 +2807,7 @@ static int mat_trybinTM(lua_State *L, const TValue *p1, const TValue *p2, StkId
     }
     case TM_DIV: {
       const lu_byte tt_p2 = ttypetag(p2);
-      if (tt_p2 == LUA_VMATRIX) {  // operator/(matNxN, matNxN)
+      if (ttismatrix(p2)) {  // operator/(matNxN, matNxN)
         const glmMatrix &m2 = glm_mvalue(p2);
         if (m.dimensions == m2.dimensions && cols == LUAGLM_MATRIX_ROWS(m.dimensions)) {
           switch (m.dimensions) {
@@ -2491,9 +2823,9 @@ static int mat_trybinTM(lua_State *L, const TValue *p1, const TValue *p2, StkId
       else if (tt_p2 == glm_variant(cols)) {  // operator/(matrix, vector)
         const glmVector &v2 = glm_vvalue(p2);
         switch (cols) {
-          case 2: glm_setvvalue2s(res, operator/(m.m22, v2.v2), LUA_VVECTOR2); return 1;
-          case 3: glm_setvvalue2s(res, operator/(m.m33, v2.v3), LUA_VVECTOR3); return 1;
-          case 4: glm_setvvalue2s(res, operator/(m.m44, v2.v4), LUA_VVECTOR4); return 1;
+          case 2: glm_setvvalue2s(L, res, operator/(m.m22, v2.v2), LUA_VVECTOR2); return 1;
+          case 3: glm_setvvalue2s(L, res, operator/(m.m33, v2.v3), LUA_VVECTOR3); return 1;
+          case 4: glm_setvvalue2s(L, res, operator/(m.m44, v2.v4), LUA_VVECTOR4); return 1;
           default: {
             break;
           }
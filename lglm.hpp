@@ -452,7 +452,38 @@ union glmMatrixBoundary {
     && sizeof(glmMatrixBoundary) == sizeof(lua_Mat4)
     && sizeof(glmMatrixBoundary) == sizeof(glmMatrix), "Inconsistent Boundary Types!"
   );
+
+  GLM_STATIC_ASSERT(sizeof(glm::mat<2, 2, glm_Float, LUAGLM_Q>) == sizeof(lua_Float4), "Inconsistent Structures: lua_Float4 / glm::mat<2, 2, glm_Float>");
+
+  /* Collectable matrices store (and are read as) packed glm::mat<C, R>; see GCMatrix */
+  GLM_STATIC_ASSERT(true
+    && sizeof(glm::mat<2, 3, glm_Float, LUAGLM_Q>) == LUAGLM_MATRIX_LENGTH(LUAGLM_MATRIX_2x3) * sizeof(lua_VecF)
+    && sizeof(glm::mat<2, 4, glm_Float, LUAGLM_Q>) == LUAGLM_MATRIX_LENGTH(LUAGLM_MATRIX_2x4) * sizeof(lua_VecF)
+    && sizeof(glm::mat<3, 2, glm_Float, LUAGLM_Q>) == LUAGLM_MATRIX_LENGTH(LUAGLM_MATRIX_3x2) * sizeof(lua_VecF)
+    && sizeof(glm::mat<3, 3, glm_Float, LUAGLM_Q>) == LUAGLM_MATRIX_LENGTH(LUAGLM_MATRIX_3x3) * sizeof(lua_VecF)
+    && sizeof(glm::mat<3, 4, glm_Float, LUAGLM_Q>) == LUAGLM_MATRIX_LENGTH(LUAGLM_MATRIX_3x4) * sizeof(lua_VecF)
+    && sizeof(glm::mat<4, 2, glm_Float, LUAGLM_Q>) == LUAGLM_MATRIX_LENGTH(LUAGLM_MATRIX_4x2) * sizeof(lua_VecF)
+    && sizeof(glm::mat<4, 3, glm_Float, LUAGLM_Q>) == LUAGLM_MATRIX_LENGTH(LUAGLM_MATRIX_4x3) * sizeof(lua_VecF)
+    && sizeof(glm::mat<4, 4, glm_Float, LUAGLM_Q>) == LUAGLM_MATRIX_LENGTH(LUAGLM_MATRIX_4x4) * sizeof(lua_VecF), "Inconsistent Structures: LUAGLM_MATRIX_STRIDE"
+  );
 #endif
+
+/*
+** lua_Float4 <-> glmMatrix for 2x2 matrices stored, column-major, in a Value
+** payload (see LUA_VMATRIX2). The remaining components of an unpacked matrix
+** are zeroed so operations over the m44 member remain well-defined.
+*/
+static LUA_INLINE glmMatrix glm_m2unpack(const lua_Float4 &f) {
+  glmMatrix m(glm::mat<4, 4, glm_Float, LUAGLM_Q>(glm_Float(0)));
+  m.m22 = glm::mat<2, 2, glm_Float, LUAGLM_Q>(f.raw[0], f.raw[1], f.raw[2], f.raw[3]);
+  m.dimensions = LUAGLM_MATRIX_2x2;
+  return m;
+}
+
+static LUA_INLINE lua_Float4 glm_m2pack(const glm::mat<2, 2, glm_Float, LUAGLM_Q> &m) {
+  const lua_Float4 f = { { m[0].x, m[0].y, m[1].x, m[1].y } };
+  return f;
+}
 #endif
 /* }================================================================== */
 
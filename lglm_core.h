@@ -7,9 +7,14 @@
 #ifndef lglm_core_h
 #define lglm_core_h
 
+#include <string.h>
+
 #include "luaconf.h"
 #include "lua.h"
+#include "lgc.h"
 #include "lobject.h"
+#include "lstate.h"
+#include "ltable.h"
 #include "ltm.h"
 
 /*
@@ -76,6 +81,41 @@ static LUA_INLINE grit_length_t glm_dimensions (lu_byte rtt) {
 #define glmVec_fastgeti(T, I, S) (vecgeti((T), (I), (S)) != LUA_TNONE)
 #define glmVec_fastgets(T, K, S) \
   ((tsslen((K)) == 1) && (vecgets((T), getstr((K)), (S)) != LUA_TNONE))
+#define glmVec_fastswizzle(L, T, K, S) \
+  ((tsslen((K)) > 1) && vecswizzle((L), (T), (K), (S)))
+
+/*
+** Decode the swizzle of a short string key, e.g., "zyx", and store it in the
+** swizzle cache (see lstate.h).
+*/
+LUAI_FUNC const Swizzle *glmVec_swizzle (lua_State *L, TString *key);
+
+/* Swizzle cache lookup: decoding 'key' on a miss. */
+static LUA_INLINE const Swizzle *glm_getswizzle (lua_State *L, TString *key) {
+  const Swizzle *sw = &G(L)->swizzle[lmod(key->hash, SWIZZLECACHE_N)];
+  return l_likely(sw->key == key) ? sw : glmVec_swizzle(L, key);
+}
+
+/*
+** Multi-character swizzle for the luaV_execute fast path. Returns zero when the
+** access requires glmVec_get: invalid swizzles, quaternions (which may keep
+** quaternion semantics), and (LUAGLM_COMPACT_VALUE) results that are boxed.
+*/
+static LUA_INLINE int vecswizzle (lua_State *L, const TValue *obj, TString *key, StkId res) {
+  const Swizzle *sw = glm_getswizzle(L, key);
+  lua_Float4 out = { { 0, 0, 0, 0 } };
+  lu_byte i;
+  if (sw->n == 0 || sw->dims > glm_dimensions(ttypetag(obj)) || ttisquat(obj))
+    return 0;
+#if defined(LUAGLM_COMPACT_VALUE)
+  if (sw->n != 2)
+    return 0;
+#endif
+  for (i = 0; i < sw->n; ++i)
+    out.raw[i] = vvalue_comp(obj, sw->idx[i]);
+  setvvalue(L, s2v(res), out, glm_variant(sw->n));
+  return 1;
+}
 
 /* Helper function for generalized vector int-access. */
 static LUA_INLINE int vecgeti (const TValue *obj, lua_Integer n, StkId res) {
@@ -86,7 +126,7 @@ static LUA_INLINE int vecgeti (const TValue *obj, lua_Integer n, StkId res) {
 #endif
 
     /* Assumes a packed x,y,z,w struct */
-    setfltvalue(s2v(res), cast_num(vvalue_(obj).raw[n - 1]));
+    setfltvalue(s2v(res), cast_num(vvalue_comp(obj, n - 1)));
     return LUA_TNUMBER;
   }
   return LUA_TNONE;
@@ -113,12 +153,75 @@ static LUA_INLINE int vecgets (const TValue *obj, const char *k, StkId res) {
 #if LUAGLM_QUAT_WXYZ  /* quaternion has WXYZ layout */
     if (ttypetag(obj) == LUA_VQUAT) _n = ((_n + 1) % 4);
 #endif
-    setfltvalue(s2v(res), cast_num(vvalue_(obj).raw[_n]));
+    setfltvalue(s2v(res), cast_num(vvalue_comp(obj, _n)));
     return LUA_TNUMBER;
   }
   return LUA_TNONE;
 }
 
+/*
+** Component-wise arithmetic for the luaV_execute fast path, i.e., <vec, vec>,
+** <vec, number>, <number, vec>, <quat, quat> (addition and subtraction), and
+** <quat, number> (excluding division). This function must replicate the
+** semantics of num_trybinTM, vec_trybinTM, and quat_trybinTM. Returning zero
+** defers the operation to OP_MMBIN/luaT_trybinTM. The caller is responsible
+** for luaC_checkvecGC.
+*/
+#define glmVec_hasfastarith(E) \
+  ((E) == TM_ADD || (E) == TM_SUB || (E) == TM_MUL || (E) == TM_DIV || (E) == TM_UNM)
+
+static LUA_INLINE int glmVec_fastarith (lua_State *L, const TValue *p1, const TValue *p2, StkId res, TMS event) {
+  lua_Float4 a, b, r;
+  lu_byte tt;
+  int i;
+  if (ttisvector(p1)) {
+    tt = ttypetag(p1);
+    a = vvalue_(p1);
+    if (event == TM_UNM) {
+      for (i = 0; i < 4; ++i) r.raw[i] = -a.raw[i];
+      setvvalue(L, s2v(res), r, tt);
+      return 1;
+    }
+    else if (ttypetag(p2) == tt) {
+      if (tt == LUA_VQUAT && event != TM_ADD && event != TM_SUB)
+        return 0;  /* Hamilton product */
+      b = vvalue_(p2);
+    }
+    else if (ttisnumber(p2)) {
+      lua_VecF s;
+      if (tt == LUA_VQUAT && event == TM_DIV)
+        return 0;  /* epsilon-checked division */
+      else if (tt == LUA_VQUAT && event == TM_MUL && ttisinteger(p2))
+        s = cast(lua_VecF, ivalue(p2));  /* quat_trybinTM: no lua_Number cast */
+      else
+        s = cast(lua_VecF, nvalue(p2));
+      b.raw[0] = b.raw[1] = b.raw[2] = b.raw[3] = s;
+    }
+    else {
+      return 0;
+    }
+  }
+  else if (ttisnumber(p1) && ttisvector(p2)) {
+    if (event == TM_UNM) return 0;
+    tt = ttypetag(p2);
+    a.raw[0] = a.raw[1] = a.raw[2] = a.raw[3] = cast(lua_VecF, nvalue(p1));
+    b = vvalue_(p2);
+  }
+  else {
+    return 0;
+  }
+
+  switch (event) {
+    case TM_ADD: for (i = 0; i < 4; ++i) r.raw[i] = a.raw[i] + b.raw[i]; break;
+    case TM_SUB: for (i = 0; i < 4; ++i) r.raw[i] = a.raw[i] - b.raw[i]; break;
+    case TM_MUL: for (i = 0; i < 4; ++i) r.raw[i] = a.raw[i] * b.raw[i]; break;
+    case TM_DIV: for (i = 0; i < 4; ++i) r.raw[i] = a.raw[i] / b.raw[i]; break;
+    default: return 0;
+  }
+  setvvalue(L, s2v(res), r, tt);
+  return 1;
+}
+
 /* rawgeti variant for vector types */
 LUAI_FUNC int glmVec_rawgeti (const TValue *obj, lua_Integer n, StkId res);
 
@@ -141,7 +244,7 @@ LUAI_FUNC void glmVec_objlen (const TValue *obj, StkId res);
 LUAI_FUNC int glmVec_equalObj (lua_State *L, const TValue *o1, const TValue *o2);
 
 /* Attempt to concatenate a number (or vector) to another  */
-LUAI_FUNC int glmVec_concat (const TValue *obj, const TValue *value, StkId res);
+LUAI_FUNC int glmVec_concat (lua_State *L, const TValue *obj, const TValue *value, StkId res);
 
 /* converts a vector to a string. */
 LUAI_FUNC int glmVec_tostr (const TValue *obj, char *buff, size_t len);
@@ -167,6 +270,55 @@ LUAI_FUNC int glmVec_next (const TValue *obj, StkId key);
 /* trybinTM handler for GLM objects */
 LUAI_FUNC int glm_trybinTM (lua_State *L, const TValue *p1, const TValue *p2, StkId res, TMS event);
 
+/*
+** '__index' metamethod of library metatables, e.g., the glm library installed
+** as the vector/matrix metatable: a raw lookup of the key in the first upvalue
+** of the closure that only returns functions.
+*/
+LUAI_FUNC int glm_libraryindex (lua_State *L);
+
+/*
+** Fill the OP_SELF inline cache of the instruction 'pc' when the method 'key'
+** of the vector/matrix 'obj' resolves to a function of its own metatable, i.e.,
+** the metatable is its own '__index' or glm_libraryindex closes over it. Keys
+** that name vector fields (swizzles and "dim") are never cached. The first
+** call allocates the cache: the caller must have saved the state of the VM.
+*/
+LUAI_FUNC void glm_cacheself (lua_State *L, const Instruction *pc, const TValue *obj, TString *key);
+
+/* Return true if 'tm' (the '__index' of 'mt') resolves methods from 'mt' */
+static LUA_INLINE int glm_isselfindex (const TValue *tm, const Table *mt) {
+  if (ttistable(tm))
+    return hvalue(tm) == mt;
+  else if (ttisCclosure(tm)) {
+    const CClosure *f = clCvalue(tm);
+    return f->f == glm_libraryindex && f->nupvalues > 0
+           && ttistable(&f->upvalue[0]) && hvalue(&f->upvalue[0]) == mt;
+  }
+  return 0;
+}
+
+/*
+** OP_SELF inline cache lookup for vector/matrix receivers. A hit requires the
+** receiver metatable, its hash part, and the '__index' field to be unchanged;
+** the method is read from the live table.
+*/
+static LUA_INLINE int glm_fastself (lua_State *L, const Instruction *pc, const TValue *obj, TString *key, StkId res) {
+  const MethodCache *mc = G(L)->methodcache;
+  const Table *mt = G(L)->mt[ttype(obj)];
+  if (mc == NULL)  /* no method cached yet */
+    return 0;
+  mc = cacheentry(mc, pc, METHODCACHE_N);
+  if (mc->pc == pc && mc->mt == mt && mc->node == mt->node && mc->lsizenode == mt->lsizenode
+      && keyisshrstr(mc->tm) && keystrval(mc->tm) == G(L)->tmname[TM_INDEX]
+      && glm_isselfindex(gval(mc->tm), mt)
+      && keyisshrstr(mc->slot) && keystrval(mc->slot) == key && ttisfunction(gval(mc->slot))) {
+    setobj2s(L, res, gval(mc->slot));
+    return 1;
+  }
+  return 0;
+}
+
 /* }================================================================== */
 
 /*
@@ -176,13 +328,35 @@ LUAI_FUNC int glm_trybinTM (lua_State *L, const TValue *p1, const TValue *p2, St
 */
 
 /* Fast path equivalent macros. */
-#define glmMat_fastgeti(T, I, S) (glmMat_vmgeti((T), (I), (S)) != LUA_TNONE)
+#define glmMat_fastgeti(L, T, I, S) (glmMat_vmgeti((L), (T), (I), (S)) != LUA_TNONE)
 
-/* Create a new collectible matrix object, linking it to the allgc list */
-LUAI_FUNC GCMatrix *glmMat_new (lua_State *L);
+/*
+** Create a new collectible matrix object, linking it to the allgc list. The
+** object is sized for (and its components are left uninitialized for) a
+** matrix of the given dimensions.
+*/
+LUAI_FUNC GCMatrix *glmMat_new (lua_State *L, grit_length_t dimensions);
+
+/*
+** Replace the contents of a matrix object; moving its components to external
+** storage if the object was allocated for smaller dimensions.
+*/
+LUAI_FUNC void glmMat_store (lua_State *L, GCMatrix *mat, const lua_Mat4 *m);
+
+/*
+** Expand the contents of a matrix object into a lua_Mat4; components outside
+** of its dimensions are zeroed.
+*/
+static LUA_INLINE lua_Mat4 glmMat_load (const GCMatrix *mat) {
+  lua_Mat4 m;
+  memset(&m.m, 0, sizeof(m.m));
+  memcpy(&m.m, matdata(mat), LUAGLM_MATRIX_LENGTH(mat->dimensions) * sizeof(lua_VecF));
+  m.dimensions = mat->dimensions;
+  return m;
+}
 
 /* rawgeti variant for matrix types */
-LUAI_FUNC int glmMat_rawgeti (const TValue *obj, lua_Integer n, StkId res);
+LUAI_FUNC int glmMat_rawgeti (lua_State *L, const TValue *obj, lua_Integer n, StkId res);
 
 /*
 ** glmMat_rawgeti: That does not set 'res' to nil on invalid access.
@@ -194,10 +368,10 @@ LUAI_FUNC int glmMat_rawgeti (const TValue *obj, lua_Integer n, StkId res);
 ** This should incur a ~5% hit on the throughput of matrix accessing, e.g.,
 ** 305657101.637 Mi/s vs. 285964300.217 Mi/
 */
-LUAI_FUNC int glmMat_vmgeti (const TValue *obj, lua_Integer n, StkId res);
+LUAI_FUNC int glmMat_vmgeti (lua_State *L, const TValue *obj, lua_Integer n, StkId res);
 
 /* rawget variant for matrix types */
-LUAI_FUNC int glmMat_rawget (const TValue *obj, TValue *key, StkId res);
+LUAI_FUNC int glmMat_rawget (lua_State *L, const TValue *obj, TValue *key, StkId res);
 
 /* lua_rawset variant for matrix types */
 LUAI_FUNC void glmMat_rawset (lua_State *L, const TValue *obj, TValue *key, TValue *val);
@@ -227,13 +401,40 @@ LUAI_FUNC int glmMat_tostr (const TValue *obj, char *buff, size_t len);
 ** If there are no more elements in the vector, then returns 0 and pushes
 ** nothing.
 */
-LUAI_FUNC int glmMat_next (const TValue *obj, StkId key);
+LUAI_FUNC int glmMat_next (lua_State *L, const TValue *obj, StkId key);
 
 /* luaV_equalobj variant for matrix types */
 LUAI_FUNC int glmMat_equalObj (lua_State *L, const TValue *o1, const TValue *o2);
 
 /* }================================================================== */
 
+/*
+** {==================================================================
+** String blob views
+** ===================================================================
+*/
+#if defined(LUAGLM_EXT_BLOB)
+
+/*
+** Place the element of the given type (LUA_BLOBVEC2, ...) stored at 'p' at the
+** specified stack index. The caller is responsible for luaC_checkGC.
+*/
+LUAI_FUNC void glmBlob_load (lua_State *L, const char *p, int type, StkId res);
+
+/* Store 'v' at 'p'; returning zero if the value is not of the element type. */
+LUAI_FUNC int glmBlob_store (char *p, int type, const TValue *v);
+
+/*
+** luaV_finishget/luaV_finishset fast paths for typed blob views. Returning zero
+** if 't' is not a view or 'key' is not an in-bounds index (or 'val' is not of
+** the element type) to defer to the metamethods of the view.
+*/
+LUAI_FUNC int glmBlob_viewget (lua_State *L, const TValue *t, const TValue *key, StkId res);
+LUAI_FUNC int glmBlob_viewset (lua_State *L, const TValue *t, const TValue *key, const TValue *val);
+
+#endif
+/* }================================================================== */
+
 /*
 ** {==================================================================
 ** Miscellaneous
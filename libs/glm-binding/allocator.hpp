@@ -384,7 +384,11 @@ public:
     if (m_size == m_capacity)
       return;
 
-    LUA_ALLOC_IF_CONSTEXPR(LUA_ALLOC_IS_TRIVIAL(T)) {
+    if (m_size == 0) {  // lua_Alloc returns NULL when freeing.
+      free_(static_cast<void *>(m_data), internal_capacity());
+      m_data = LUA_ALLOC_NULLPTR;
+    }
+    else LUA_ALLOC_IF_CONSTEXPR(LUA_ALLOC_IS_TRIVIAL(T)) {
       m_data = static_cast<T *>(realloc_(static_cast<void *>(m_data), internal_capacity(), m_size * sizeof(T)));
       assert(m_data != LUA_ALLOC_NULLPTR && "Reallocation failed");
     }
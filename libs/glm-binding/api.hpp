@@ -248,7 +248,8 @@
       case LUA_VVECTOR3: LAYOUT_GENERIC_EQUAL(LB, F, gLuaVec3<>::fast, gLuaVec3<>::fast); break; \
       case LUA_VVECTOR4: LAYOUT_GENERIC_EQUAL(LB, F, gLuaVec4<>::fast, gLuaVec4<>::fast); break; \
       case LUA_VQUAT: LAYOUT_GENERIC_EQUAL(LB, F, gLuaQuat<>::fast, gLuaVec4<>::fast); break;    \
-      case LUA_VMATRIX: PARSE_MATRIX(LB, mvalue_dims(o), F, LAYOUT_MATRIX_EQUAL); break;         \
+      case LUA_VMATRIX:                                                                          \
+      case LUA_VMATRIX2: PARSE_MATRIX(LB, mvalue_dims(o), F, LAYOUT_MATRIX_EQUAL); break;        \
       default:                                                                                   \
         break;                                                                                   \
     }                                                                                            \
@@ -294,7 +295,8 @@ GLM_BINDING_QUALIFIER(hash) { /* glm/gtx/hash.hpp */
       case LUA_VVECTOR3: LAYOUT_HASH(LB, std::hash, gLuaVec3<>::fast); break;
       case LUA_VVECTOR4: LAYOUT_HASH(LB, std::hash, gLuaVec4<>::fast); break;
       case LUA_VQUAT: LAYOUT_HASH(LB, std::hash, gLuaQuat<>); break;
-      case LUA_VMATRIX: PARSE_MATRIX(LB, mvalue_dims(o), std::hash, LAYOUT_HASH); break;
+      case LUA_VMATRIX:
+      case LUA_VMATRIX2: PARSE_MATRIX(LB, mvalue_dims(o), std::hash, LAYOUT_HASH); break;
       default: {
         return LUAGLM_TYPE_ERROR(LB.L, LB.idx, GLM_STRING_VECTOR " or " GLM_STRING_QUATERN " or " GLM_STRING_MATRIX);
       }
@@ -397,7 +399,8 @@ GLM_BINDING_QUALIFIER(mat_mul) {  // @TODO: Reduce bloat!
     case LUA_VVECTOR3: LAYOUT_MULTIPLICATION_OP(LB, operator*, gLuaVec3<>::fast); break;
     case LUA_VVECTOR4: LAYOUT_MULTIPLICATION_OP(LB, operator*, gLuaVec4<>::fast); break;
     // @TODO: Special case for handling mat4x4 * vec3 and mat4x3 * vec3; see LUAGLM_MUL_DIRECTION.
-    case LUA_VMATRIX: PARSE_MATRIX(LB, mvalue_dims(o), operator*, LAYOUT_MULTIPLICATION_OP); break;
+    case LUA_VMATRIX:
+    case LUA_VMATRIX2: PARSE_MATRIX(LB, mvalue_dims(o), operator*, LAYOUT_MULTIPLICATION_OP); break;
     default: {
       break;
     }
@@ -962,7 +965,8 @@ ROTATION_MATRIX_DEFN(axisAngle, glm::__axisAngle, LAYOUT_AXIS_ANGLE)
       case LUA_VVECTOR2: LAYOUT_BINARY(LB, F##2, gLuaVec2<>::fast); break;              \
       case LUA_VVECTOR3: LAYOUT_TERNARY(LB, F##3, gLuaVec3<>::fast); break;             \
       case LUA_VVECTOR4: LAYOUT_QUATERNARY(LB, F##4, gLuaVec4<>::fast); break;          \
-      case LUA_VMATRIX: {                                                               \
+      case LUA_VMATRIX:                                                                 \
+      case LUA_VMATRIX2: {                                                              \
         switch (mvalue_dims(o)) {                                                       \
           case LUAGLM_MATRIX_2x2: BIND_FUNC(LB, F##2, gLuaMat2x2<>::fast);              \
           case LUAGLM_MATRIX_3x3: BIND_FUNC(LB, F##3, gLuaMat3x3<>::fast);              \
@@ -1197,7 +1201,10 @@ GLM_BINDING_QUALIFIER(toint) { /* @MathlibCompat */
   LUA_MLM_BEGIN /* <Tr, 0, 1>, <Tr, minVal, maxVal>, <Tr, TrMin, TrMax> */                                                      \
   if (gLuaBase::isnoneornil((LB).L, (LB).idx + Tr::stack_size) && gLuaBase::isnoneornil((LB).L, (LB).idx + 2 * Tr::stack_size)) \
     VA_CALL(BIND_FUNC, LB, F, Tr, ##__VA_ARGS__);                                                                               \
-  else if (LB.Is<Tr::value_trait>(Tr::stack_size) && LB.Is<Tr::value_trait>(Tr::stack_size + Tr::value_trait::stack_size))      \
+  const unsigned _sig = (LB).Signature(3);                                                                                      \
+  BIND_PACKED3(LB, _sig, F, Tr, Tr::value_trait, Tr::value_trait, ##__VA_ARGS__);                                              \
+  BIND_PACKED3(LB, _sig, F, Tr, Tr, Tr, ##__VA_ARGS__);                                                                         \
+  if (LB.Is<Tr::value_trait>(Tr::stack_size) && LB.Is<Tr::value_trait>(Tr::stack_size + Tr::value_trait::stack_size))           \
     VA_CALL(BIND_FUNC, LB, F, Tr, Tr::value_trait, Tr::value_trait, ##__VA_ARGS__);                                             \
   VA_CALL(BIND_FUNC, LB, F, Tr, Tr::safe, Tr::safe, ##__VA_ARGS__);                                                             \
   LUA_MLM_END
@@ -1259,6 +1266,8 @@ GLM_BINDING_QUALIFIER(max) { /* @MathlibCompat */
 #if defined(COMMON_HPP) || defined(EXT_MATRIX_COMMON_HPP)
 #define LAYOUT_MIX(LB, F, Tr, ...)                                           \
   LUA_MLM_BEGIN                                                              \
+  const unsigned _sig = (LB).Signature(3);                                   \
+  BIND_PACKED3(LB, _sig, F, Tr, Tr, Tr::value_trait, ##__VA_ARGS__);         \
   if (LB.Is<gLuaTrait<bool>>(2 * Tr::stack_size))                            \
     VA_CALL(BIND_FUNC, LB, F, Tr, Tr::safe, gLuaTrait<bool>, ##__VA_ARGS__); \
   else if (LB.Is<Tr::value_trait>(2 * Tr::stack_size))                       \
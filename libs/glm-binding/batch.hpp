@@ -0,0 +1,491 @@
+/*
+** $Id: batch.hpp $
+** Batched vector/matrix operations over arrays packed into (string) blobs.
+**
+** Each array is a sequence of tightly packed single-precision elements, e.g., a
+** vec3 array of N elements is N * 12 bytes (string.pack("fff", ...) compatible)
+** and a mat4 array is column-major. Element-wise operands may also be single
+** values (numbers, vectors, or matrices) that are broadcast to each element of
+** the result.
+**
+** Elements are loaded into temporaries qualified by LUAGLM_BATCH_Q. When GLM is
+** configured with GLM_FORCE_INTRINSICS and GLM_FORCE_DEFAULT_ALIGNED_GENTYPES
+** the vec4/mat4 kernels are the SSE/AVX implementations of GLM.
+**
+** Kernels never touch the lua_State once their operands are parsed: large
+** arrays may be split across the worker thread pool (threads.hpp).
+**
+** Polygons (geom.hpp) are vec3 arrays of their points when those points are
+** packed single-precision vectors: kernels read and write them in place.
+**
+** See Copyright Notice in lua.h
+*/
+#ifndef BINDING_BATCH_HPP
+#define BINDING_BATCH_HPP
+#if defined(LUAGLM_EXT_BLOB)
+
+#include <cstring>
+
+#include <lua.hpp>
+#include <lglm.hpp>
+
+#include <glm/glm.hpp>
+#include "threads.hpp"
+#if defined(LUAGLM_INCLUDE_GEOM)
+  #include "geom.hpp"
+#endif
+
+/*
+@@ LUAGLM_BATCH_Q Qualifier of the temporaries that array elements are loaded
+** into/stored from.
+*/
+#if !defined(LUAGLM_BATCH_Q)
+  #if GLM_CONFIG_ALIGNED_GENTYPES == GLM_ENABLE
+    #define LUAGLM_BATCH_Q glm::qualifier::aligned_highp
+  #else
+    #define LUAGLM_BATCH_Q glm::qualifier::highp
+  #endif
+#endif
+
+/* Component type of all batch arrays (independent of glm_Float) */
+using gBatchFloat = float;
+using gBatchVec2 = glm::vec<2, gBatchFloat, LUAGLM_BATCH_Q>;
+using gBatchVec3 = glm::vec<3, gBatchFloat, LUAGLM_BATCH_Q>;
+using gBatchVec4 = glm::vec<4, gBatchFloat, LUAGLM_BATCH_Q>;
+using gBatchMat4 = glm::mat<4, 4, gBatchFloat, LUAGLM_BATCH_Q>;
+
+/*
+** {==================================================================
+** Elements
+** ===================================================================
+*/
+
+/// <summary>
+/// Load/Store an element of an array and parse a single (broadcast) element
+/// from the Lua stack.
+/// </summary>
+template<typename T>
+struct gBatchElement;
+
+template<>
+struct gBatchElement<gBatchFloat> {
+  using type = gBatchFloat;
+  static const size_t size = sizeof(gBatchFloat);
+
+  LUA_INLINE static type Load(const char *p) {
+    type v;
+    std::memcpy(&v, p, size);
+    return v;
+  }
+
+  LUA_INLINE static void Store(char *p, const type &v) {
+    std::memcpy(p, &v, size);
+  }
+
+  static bool To(lua_State *L, int idx, type &v) {
+    if (lua_type(L, idx) == LUA_TNUMBER) {
+      v = static_cast<type>(lua_tonumber(L, idx));
+      return true;
+    }
+    return false;
+  }
+};
+
+/* Convert the vector at the given index into a batch element */
+static LUA_INLINE void glm_tobatch(lua_State *L, int idx, gBatchVec2 &v) { v = gBatchVec2(glm_tovec2(L, idx)); }
+static LUA_INLINE void glm_tobatch(lua_State *L, int idx, gBatchVec3 &v) { v = gBatchVec3(glm_tovec3(L, idx)); }
+static LUA_INLINE void glm_tobatch(lua_State *L, int idx, gBatchVec4 &v) { v = gBatchVec4(glm_tovec4(L, idx)); }
+
+template<glm::length_t L>
+struct gBatchElement<glm::vec<L, gBatchFloat, LUAGLM_BATCH_Q>> {
+  using type = glm::vec<L, gBatchFloat, LUAGLM_BATCH_Q>;
+  static const size_t size = L * sizeof(gBatchFloat);
+
+  LUA_INLINE static type Load(const char *p) {
+    type v;
+    std::memcpy(&v[0], p, size);
+    return v;
+  }
+
+  LUA_INLINE static void Store(char *p, const type &v) {
+    std::memcpy(p, &v[0], size);
+  }
+
+  static bool To(lua_State *L_, int idx, type &v) {
+    if (lua_type(L_, idx) == LUA_TNUMBER) {
+      v = type(static_cast<gBatchFloat>(lua_tonumber(L_, idx)));
+      return true;
+    }
+    else if (glm_vector_length(L_, idx) == L) {
+      glm_tobatch(L_, idx, v);
+      return true;
+    }
+    return false;
+  }
+};
+
+template<>
+struct gBatchElement<glm::mat<4, 4, gBatchFloat, LUAGLM_BATCH_Q>> {
+  using type = glm::mat<4, 4, gBatchFloat, LUAGLM_BATCH_Q>;
+  static const size_t size = 16 * sizeof(gBatchFloat);
+
+  LUA_INLINE static type Load(const char *p) {
+    type m;
+    for (glm::length_t i = 0; i < 4; ++i)
+      std::memcpy(&m[i][0], p + i * (4 * sizeof(gBatchFloat)), 4 * sizeof(gBatchFloat));
+    return m;
+  }
+
+  LUA_INLINE static void Store(char *p, const type &m) {
+    for (glm::length_t i = 0; i < 4; ++i)
+      std::memcpy(p + i * (4 * sizeof(gBatchFloat)), &m[i][0], 4 * sizeof(gBatchFloat));
+  }
+
+  static bool To(lua_State *L, int idx, type &m) {
+    glm::length_t dims = 0;
+    if (glm_ismatrix(L, idx, dims) && dims == LUAGLM_MATRIX_4x4) {
+      m = type(glm_tomat4x4(L, idx));
+      return true;
+    }
+    return false;
+  }
+};
+
+/// <summary>
+/// Return the points of the polygon at 'idx' as a packed array and set 'len' to
+/// its length in bytes. Returns GLM_NULLPTR if the value is not a polygon or if
+/// polygon points are not laid out as batch vec3 elements, e.g., double or
+/// aligned vectors.
+/// </summary>
+static char *glm_batchpolygon(lua_State *L, int idx, size_t &len) {
+#if defined(LUAGLM_INCLUDE_GEOM)
+  using Point = gLuaPolygon<>::point_trait::type;
+  LUA_IF_CONSTEXPR(std::is_same<gLuaPolygon<>::value_type, gBatchFloat>::value
+                   && sizeof(Point) == gBatchElement<gBatchVec3>::size) {
+    void *ud = luaL_testudata(L, idx, gLuaPolygon<>::Metatable());
+    if (ud != GLM_NULLPTR) {
+      gLuaPolygon<>::type::list_type *list = static_cast<gLuaPolygon<>::type::list_type *>(ud);
+      len = list->count * sizeof(Point);
+      return reinterpret_cast<char *>(list->data);
+    }
+  }
+#else
+  ((void)L); ((void)idx); ((void)len);
+#endif
+  return GLM_NULLPTR;
+}
+
+/// <summary>
+/// An array of packed elements or a single element broadcast to all indices.
+/// </summary>
+template<typename T>
+struct gBatchOperand {
+  using element = gBatchElement<T>;
+
+  const char *data = GLM_NULLPTR;  // Packed array; GLM_NULLPTR for a single element
+  size_t count = 0;  // Number of elements in 'data'
+  T value = T();
+
+  gBatchOperand(lua_State *L, int idx, const char *label) {
+    size_t len = 0;
+    if (lua_type(L, idx) == LUA_TSTRING) {
+      data = lua_tolstring(L, idx, &len);
+      count = len / element::size;
+    }
+    else if ((data = glm_batchpolygon(L, idx, len)) != GLM_NULLPTR) {
+      count = len / element::size;
+    }
+    else if (!element::To(L, idx, value)) {
+      luaL_typeerror(L, idx, label);
+    }
+  }
+
+  LUA_INLINE T operator[](size_t i) const {
+    return (data == GLM_NULLPTR) ? value : element::Load(data + i * element::size);
+  }
+
+  /// <summary>
+  /// Limit 'n' to the number of elements in the operand.
+  /// </summary>
+  LUA_INLINE size_t clamp(size_t n) const {
+    return (data != GLM_NULLPTR && count < n) ? count : n;
+  }
+};
+
+/* }================================================================== */
+
+/*
+** {==================================================================
+** Kernels
+** ===================================================================
+*/
+
+/* Sentinel for an unbounded number of elements: all operands are single values */
+#define BATCH_UNBOUNDED (~static_cast<size_t>(0))
+
+/* Minimum number of elements per chunk when split across the thread pool */
+#define BATCH_GRAIN 1024
+
+/// <summary>
+/// Resolve the number of elements to process: the explicit 'count' argument at
+/// 'idx' or the length of the shortest array operand.
+/// </summary>
+static size_t glm_batchcount(lua_State *L, int idx, size_t n) {
+  if (!lua_isnoneornil(L, idx)) {
+    const lua_Integer count = luaL_checkinteger(L, idx);
+    luaL_argcheck(L, count >= 0 && static_cast<size_t>(count) <= n, idx, "count out of range");
+    return static_cast<size_t>(count);
+  }
+  else if (n == BATCH_UNBOUNDED) {
+    luaL_argerror(L, idx, "count expected when no operand is an array");
+  }
+  return n;
+}
+
+/// <summary>
+/// Return a pointer to an output array of 'n' elements, each 'size' bytes. If
+/// the value at 'idx' is nil a new blob is created; otherwise it must be a blob
+/// (or polygon) of sufficient length. The output array is placed on top of the
+/// stack.
+/// </summary>
+static char *glm_batchoutput(lua_State *L, int idx, size_t n, size_t size) {
+  if (lua_isnoneornil(L, idx)) {
+    luaL_argcheck(L, n <= (~static_cast<size_t>(0)) / size, idx, "resulting blob too large");
+    return lua_pushblob(L, n * size);
+  }
+
+  size_t len = 0;
+  char *out = glm_batchpolygon(L, idx, len);
+  if (out == GLM_NULLPTR) {
+    if (!lua_isstringblob(L, idx))
+      luaL_typeerror(L, idx, "blob");
+    out = lua_tostringblob(L, idx, &len);
+  }
+  luaL_argcheck(L, n <= len / size, idx, "blob too small");
+  lua_pushvalue(L, idx);
+  return out;
+}
+
+/// <summary>
+/// out[i] = F(a[i]); the result is placed on top of the stack.
+/// </summary>
+template<typename R, typename A, typename F>
+static int glm_batchmap1(lua_State *L, int idx, F f) {
+  const gBatchOperand<A> a(L, idx + 1, "blob or value");
+  const size_t n = glm_batchcount(L, idx + 2, a.clamp(BATCH_UNBOUNDED));
+  char *out = glm_batchoutput(L, idx, n, gBatchElement<R>::size);
+  auto kernel = [&](size_t begin, size_t end) {
+    for (size_t i = begin; i < end; ++i)
+      gBatchElement<R>::Store(out + i * gBatchElement<R>::size, f(a[i]));
+  };
+  glm_parallel_for(n, BATCH_GRAIN, kernel);
+  return 1;
+}
+
+/// <summary>
+/// out[i] = F(a[i], b[i]); the result is placed on top of the stack.
+/// </summary>
+template<typename R, typename A, typename B, typename F>
+static int glm_batchmap2(lua_State *L, int idx, F f) {
+  const gBatchOperand<A> a(L, idx + 1, "blob or value");
+  const gBatchOperand<B> b(L, idx + 2, "blob or value");
+  const size_t n = glm_batchcount(L, idx + 3, b.clamp(a.clamp(BATCH_UNBOUNDED)));
+  char *out = glm_batchoutput(L, idx, n, gBatchElement<R>::size);
+  auto kernel = [&](size_t begin, size_t end) {
+    for (size_t i = begin; i < end; ++i)
+      gBatchElement<R>::Store(out + i * gBatchElement<R>::size, f(a[i], b[i]));
+  };
+  glm_parallel_for(n, BATCH_GRAIN, kernel);
+  return 1;
+}
+
+/// <summary>
+/// out[i] = F(a[i], b[i], c[i]); the result is placed on top of the stack.
+/// </summary>
+template<typename R, typename A, typename B, typename C, typename F>
+static int glm_batchmap3(lua_State *L, int idx, F f) {
+  const gBatchOperand<A> a(L, idx + 1, "blob or value");
+  const gBatchOperand<B> b(L, idx + 2, "blob or value");
+  const gBatchOperand<C> c(L, idx + 3, "blob or value");
+  const size_t n = glm_batchcount(L, idx + 4, c.clamp(b.clamp(a.clamp(BATCH_UNBOUNDED))));
+  char *out = glm_batchoutput(L, idx, n, gBatchElement<R>::size);
+  auto kernel = [&](size_t begin, size_t end) {
+    for (size_t i = begin; i < end; ++i)
+      gBatchElement<R>::Store(out + i * gBatchElement<R>::size, f(a[i], b[i], c[i]));
+  };
+  glm_parallel_for(n, BATCH_GRAIN, kernel);
+  return 1;
+}
+
+/* }================================================================== */
+
+/*
+** {==================================================================
+** Library
+** ===================================================================
+*/
+
+/* Element types of a batch operation; the first argument of each function */
+#define BATCH_VEC2 0
+#define BATCH_VEC3 1
+#define BATCH_VEC4 2
+#define BATCH_MAT4 3
+
+static int glm_batchtype(lua_State *L, bool matrices) {
+  static const char *const types[] = { "vec2", "vec3", "vec4", "mat4", GLM_NULLPTR };
+  const int type = luaL_checkoption(L, 1, GLM_NULLPTR, types);
+  if (!matrices && type == BATCH_MAT4)
+    return luaL_argerror(L, 1, "vector type expected");
+  return type;
+}
+
+/* Define a component-wise binary operation for all element types. */
+#define BATCH_BINARY_DEFN(Name, Op)                                                                     \
+  GLM_BINDING_QUALIFIER(Name) {                                                                         \
+    switch (glm_batchtype(L, true)) {                                                                   \
+      case BATCH_VEC2:                                                                                  \
+        return glm_batchmap2<gBatchVec2, gBatchVec2, gBatchVec2>(L, 2, [](const gBatchVec2 &a, const gBatchVec2 &b) { return a Op b; }); \
+      case BATCH_VEC3:                                                                                  \
+        return glm_batchmap2<gBatchVec3, gBatchVec3, gBatchVec3>(L, 2, [](const gBatchVec3 &a, const gBatchVec3 &b) { return a Op b; }); \
+      case BATCH_VEC4:                                                                                  \
+        return glm_batchmap2<gBatchVec4, gBatchVec4, gBatchVec4>(L, 2, [](const gBatchVec4 &a, const gBatchVec4 &b) { return a Op b; }); \
+      default:                                                                                          \
+        return glm_batchmap2<gBatchMat4, gBatchMat4, gBatchMat4>(L, 2, [](const gBatchMat4 &a, const gBatchMat4 &b) { return a Op b; }); \
+    }                                                                                                   \
+  }
+
+/// <summary>
+/// batch.add(type, out, a, b [, count]): out[i] = a[i] + b[i]
+/// </summary>
+BATCH_BINARY_DEFN(batch_add, +)
+
+/// <summary>
+/// batch.sub(type, out, a, b [, count]): out[i] = a[i] - b[i]
+/// </summary>
+BATCH_BINARY_DEFN(batch_sub, -)
+
+/// <summary>
+/// batch.mul(type, out, a, b [, count]): out[i] = a[i] * b[i]; component-wise
+/// for vectors and the matrix product for mat4.
+/// </summary>
+BATCH_BINARY_DEFN(batch_mul, *)
+
+/// <summary>
+/// batch.transform(type, out, m, v [, count]): out[i] = m[i] * v[i], where m is
+/// a mat4 (or mat4 array). vec3 elements are transformed as points, or as
+/// directions if compiled with LUAGLM_MUL_DIRECTION; see lglm.cpp.
+/// </summary>
+GLM_BINDING_QUALIFIER(batch_transform) {
+#if defined(LUAGLM_MUL_DIRECTION)
+  static const gBatchFloat w = gBatchFloat(0);
+#else
+  static const gBatchFloat w = gBatchFloat(1);
+#endif
+  switch (glm_batchtype(L, false)) {
+    case BATCH_VEC3:
+      return glm_batchmap2<gBatchVec3, gBatchMat4, gBatchVec3>(L, 2, [](const gBatchMat4 &m, const gBatchVec3 &v) {
+        return gBatchVec3(m * gBatchVec4(v, w));
+      });
+    case BATCH_VEC4:
+      return glm_batchmap2<gBatchVec4, gBatchMat4, gBatchVec4>(L, 2, [](const gBatchMat4 &m, const gBatchVec4 &v) {
+        return m * v;
+      });
+    default:
+      return luaL_argerror(L, 1, "vec3 or vec4 expected");
+  }
+}
+
+/// <summary>
+/// batch.normalize(type, out, a [, count]): out[i] = normalize(a[i])
+/// </summary>
+GLM_BINDING_QUALIFIER(batch_normalize) {
+  switch (glm_batchtype(L, false)) {
+    case BATCH_VEC2: return glm_batchmap1<gBatchVec2, gBatchVec2>(L, 2, [](const gBatchVec2 &a) { return glm::normalize(a); });
+    case BATCH_VEC3: return glm_batchmap1<gBatchVec3, gBatchVec3>(L, 2, [](const gBatchVec3 &a) { return glm::normalize(a); });
+    default: return glm_batchmap1<gBatchVec4, gBatchVec4>(L, 2, [](const gBatchVec4 &a) { return glm::normalize(a); });
+  }
+}
+
+/// <summary>
+/// batch.dot(type, out, a, b [, count]): out[i] = dot(a[i], b[i]), where out is
+/// an array of floats.
+/// </summary>
+GLM_BINDING_QUALIFIER(batch_dot) {
+  switch (glm_batchtype(L, false)) {
+    case BATCH_VEC2:
+      return glm_batchmap2<gBatchFloat, gBatchVec2, gBatchVec2>(L, 2, [](const gBatchVec2 &a, const gBatchVec2 &b) { return glm::dot(a, b); });
+    case BATCH_VEC3:
+      return glm_batchmap2<gBatchFloat, gBatchVec3, gBatchVec3>(L, 2, [](const gBatchVec3 &a, const gBatchVec3 &b) { return glm::dot(a, b); });
+    default:
+      return glm_batchmap2<gBatchFloat, gBatchVec4, gBatchVec4>(L, 2, [](const gBatchVec4 &a, const gBatchVec4 &b) { return glm::dot(a, b); });
+  }
+}
+
+/// <summary>
+/// batch.lerp(type, out, a, b, t [, count]): out[i] = mix(a[i], b[i], t[i]),
+/// where t is a number or an array of floats.
+/// </summary>
+GLM_BINDING_QUALIFIER(batch_lerp) {
+  switch (glm_batchtype(L, false)) {
+    case BATCH_VEC2:
+      return glm_batchmap3<gBatchVec2, gBatchVec2, gBatchVec2, gBatchFloat>(L, 2, [](const gBatchVec2 &a, const gBatchVec2 &b, gBatchFloat t) { return glm::mix(a, b, t); });
+    case BATCH_VEC3:
+      return glm_batchmap3<gBatchVec3, gBatchVec3, gBatchVec3, gBatchFloat>(L, 2, [](const gBatchVec3 &a, const gBatchVec3 &b, gBatchFloat t) { return glm::mix(a, b, t); });
+    default:
+      return glm_batchmap3<gBatchVec4, gBatchVec4, gBatchVec4, gBatchFloat>(L, 2, [](const gBatchVec4 &a, const gBatchVec4 &b, gBatchFloat t) { return glm::mix(a, b, t); });
+  }
+}
+
+/// <summary>
+/// batch.size(type [, count]): Number of bytes of a single element (or of
+/// 'count' elements) of the given type.
+/// </summary>
+GLM_BINDING_QUALIFIER(batch_size) {
+  static const size_t sizes[] = {
+    gBatchElement<gBatchVec2>::size, gBatchElement<gBatchVec3>::size,
+    gBatchElement<gBatchVec4>::size, gBatchElement<gBatchMat4>::size,
+  };
+  const lua_Integer count = luaL_optinteger(L, 2, 1);
+  luaL_argcheck(L, count >= 0, 2, "count out of range");
+  lua_pushinteger(L, static_cast<lua_Integer>(sizes[glm_batchtype(L, true)]) * count);
+  return 1;
+}
+
+/// <summary>
+/// batch.threads([workers [, threshold]]): Configure the worker thread pool
+/// shared by all batch kernels and batched geometry queries. Arrays of at least
+/// 'threshold' elements are split across the workers and the calling thread;
+/// zero workers (the default) disables the pool and a negative count creates
+/// one worker per additional hardware thread. Returns the number of workers,
+/// always zero when compiled without LUAGLM_THREADS, and the threshold.
+/// </summary>
+GLM_BINDING_QUALIFIER(batch_threads) {
+  gLuaThreadPool &pool = gLuaThreadPool::Instance();
+  if (!lua_isnoneornil(L, 1)) {
+    const lua_Integer workers = luaL_checkinteger(L, 1);
+    const lua_Integer threshold = luaL_optinteger(L, 2, static_cast<lua_Integer>(pool.Threshold()));
+    luaL_argcheck(L, threshold >= 0, 2, "threshold out of range");
+    pool.Configure(workers < 0 ? gLuaThreadPool::Concurrency() - 1 : static_cast<size_t>(workers), static_cast<size_t>(threshold));
+  }
+  lua_pushinteger(L, static_cast<lua_Integer>(pool.Workers()));
+  lua_pushinteger(L, static_cast<lua_Integer>(pool.Threshold()));
+  return 2;
+}
+
+static const luaL_Reg luaglm_batchlib[] = {
+  { "add", GLM_NAME(batch_add) },
+  { "sub", GLM_NAME(batch_sub) },
+  { "mul", GLM_NAME(batch_mul) },
+  { "transform", GLM_NAME(batch_transform) },
+  { "normalize", GLM_NAME(batch_normalize) },
+  { "dot", GLM_NAME(batch_dot) },
+  { "lerp", GLM_NAME(batch_lerp) },
+  { "size", GLM_NAME(batch_size) },
+  { "threads", GLM_NAME(batch_threads) },
+  { GLM_NULLPTR, GLM_NULLPTR }
+};
+
+/* }================================================================== */
+
+#endif
+#endif
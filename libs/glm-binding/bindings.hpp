@@ -238,8 +238,18 @@ extern LUA_API_LINKAGE {
 
 /* TValue -> glmVector */
 #if !defined(glm_vvalue)
-  #define glm_mvalue(o) glm_constmat_boundary(mvalue_ref(o))
+  #define glm_gcmvalue(o) glmMatrixBoundary(glmMat_load(mvalue(o))).glm
+#if defined(LUAGLM_INLINE_MATRIX)
+  #define glm_m2value(o) glm_m2unpack(m2value(o))
+  #define glm_mvalue(o) (ttisinlinematrix(o) ? glm_m2value(o) : glm_gcmvalue(o))
+#else
+  #define glm_mvalue(o) glm_gcmvalue(o)
+#endif
+#if defined(LUAGLM_COMPACT_VALUE)
+  #define glm_vvalue(o) glmVectorBoundary(vvalue_(o)).glm
+#else
   #define glm_vvalue(o) glm_constvec_boundary(vvalue_ref(o))
+#endif
   #define glm_v2value(o) glm_vvalue(o).v2
   #define glm_v3value(o) glm_vvalue(o).v3
   #define glm_v4value(o) glm_vvalue(o).v4
@@ -305,6 +315,36 @@ public:
   #define LUA_NARROW_CAST(L, T, V) static_cast<T>((V))
 #endif
 
+/*
+** Packed argument signatures: the (folded) type tags of consecutive Lua values
+** packed one byte per argument. Bindings compare the signature of the stack
+** against one computed, at compile-time, from the traits of an overload
+** instead of testing each argument with Tr::Is and Tr::Next.
+**
+** Integers are folded into floats and false into true as a trait that accepts
+** one accepts the other. GLM_SIG_INVALID denotes a trait that cannot be
+** described by a single tag, e.g., matrices, integers, or traits spanning
+** multiple stack values; signatures containing it never match.
+*/
+#define GLM_SIG_INVALID 0xFF
+#define GLM_SIG_NONE (~0u)
+#define GLM_SIG_VALID(A) ((A) != GLM_SIG_INVALID)
+#define GLM_SIG2(A, B) \
+  ((GLM_SIG_VALID(A) && GLM_SIG_VALID(B)) ? (static_cast<unsigned>(A) | (static_cast<unsigned>(B) << 8)) : GLM_SIG_NONE)
+#define GLM_SIG3(A, B, C) \
+  ((GLM_SIG_VALID(A) && GLM_SIG_VALID(B) && GLM_SIG_VALID(C)) ? (static_cast<unsigned>(A) | (static_cast<unsigned>(B) << 8) | (static_cast<unsigned>(C) << 16)) : GLM_SIG_NONE)
+
+/// <summary>
+/// Return the signature tag of a Lua value.
+/// </summary>
+static LUA_INLINE unsigned glm_sigtag(const TValue *o) {
+  switch (ttypetag(o)) {
+    case LUA_VNUMINT: return LUA_VNUMFLT;
+    case LUA_VFALSE: return LUA_VTRUE;
+    default: return ttypetag(o);
+  }
+}
+
 /// <summary>
 /// Forward declaration of the Lua type trait: the interface that interacts with
 /// a stack iterator that converts sequences of Lua objects into function
@@ -531,6 +571,17 @@ struct gLuaBase {
     return glm_i2v(L, idx + offset);
   }
 
+  /// <summary>
+  /// Return the packed signature of the 'n' values starting at the iteration
+  /// pointer; values beyond the top of the stack are nil.
+  /// </summary>
+  LUA_INLINE unsigned Signature(int n) const {
+    unsigned sig = 0;
+    for (int i = n - 1; i >= 0; --i)
+      sig = (sig << 8) | glm_sigtag(glm_i2v(L, idx + i));
+    return sig;
+  }
+
   /// <summary>
   /// Tr::Is() wrapper.
   /// </summary>
@@ -697,6 +748,12 @@ struct gLuaAbstractTrait : glm::type<T> {
   /// </summary>
   static const LUA_CONSTEXPR int stack_size = 1;
 
+  /// <summary>
+  /// @Signature: Type tag of the Lua value that Tr::fast may parse without
+  /// additional type checking; GLM_SIG_INVALID otherwise.
+  /// </summary>
+  static const LUA_CONSTEXPR int signature = GLM_SIG_INVALID;
+
   /// <summary>
   /// Return a descriptive parameter literal for debugging/error messaging.
   /// </summary>
@@ -727,6 +784,9 @@ struct gLuaAbstractTrait : glm::type<T> {
 /// </summary>
 template<typename T, bool FastPath = false>
 struct gLuaPrimitive : gLuaAbstractTrait<T, T> {
+  static const LUA_CONSTEXPR int signature = std::is_same<T, bool>::value ? LUA_VTRUE  // @Signature
+                                             : (std::is_floating_point<T>::value ? LUA_VNUMFLT : GLM_SIG_INVALID);
+
   LUA_BIND_DECL LUA_CONSTEXPR_STATEMENT const char *Label() {
     LUA_IF_CONSTEXPR(std::is_same<T, bool>::value) return "bool";
     LUA_IF_CONSTEXPR(std::is_integral<T>::value) return GLM_STRING_INTEGER;
@@ -748,7 +808,7 @@ struct gLuaPrimitive : gLuaAbstractTrait<T, T> {
       const TValue *o = glm_i2v(L, idx++);
       LUA_IF_CONSTEXPR(std::is_same<T, bool>::value) return static_cast<T>(!l_isfalse(o));
       LUA_IF_CONSTEXPR(std::is_integral<T>::value) return LUA_NARROW_CAST(L, T, ivalue(o));
-      LUA_IF_CONSTEXPR(std::is_floating_point<T>::value) return static_cast<T>(fltvalue(o));
+      LUA_IF_CONSTEXPR(std::is_floating_point<T>::value) return static_cast<T>(nvalue(o));
     }
     else {
       LUA_IF_CONSTEXPR(std::is_same<T, bool>::value) { const TValue *o = glm_i2v(L, idx++); return !l_isfalse(o); }
@@ -815,9 +875,27 @@ struct gLuaAbstractVector : gLuaAbstractTrait<glm::vec<D, T, Q>> {
   /// </summary>
   using gLuaAbstractTrait<glm::vec<D, T, Q>>::Zero;
 
+  /// <summary>
+  /// @Signature: glm_variant(D)
+  /// </summary>
+  static const LUA_CONSTEXPR int signature = (D >= 2 && D <= 4) ? makevariant(LUA_TVECTOR, (D >= 2 ? D - 2 : 0)) : GLM_SIG_INVALID;
+
   LUA_BIND_QUALIFIER bool Is(lua_State *L, int idx) {
     const TValue *o = glm_i2v(L, idx);
-    return checktag((o), glm_variant(D));
+    return ttypetag(o) == glm_variant(D);
+  }
+
+  /// <summary>
+  /// Store a glm::vec into a TValue, e.g., a register of a fast call.
+  /// </summary>
+  LUA_BIND_QUALIFIER void Set(lua_State *L, TValue *o, const glm::vec<D, T, Q> &v) {
+#if defined(LUAGLM_COMPACT_VALUE)
+    setvvalue(L, o, glmVectorBoundary(glmVector(v)).lua, glm_variant(D));
+#else
+    ((void)L);
+    glm_vec_boundary(&vvalue_(o)) = v;  // May use explicit copy constructor
+    settt_(o, glm_variant(D));
+#endif
   }
 
   /// <summary>
@@ -826,10 +904,9 @@ struct gLuaAbstractVector : gLuaAbstractTrait<glm::vec<D, T, Q>> {
   LUA_BIND_QUALIFIER int Push(const gLuaBase &LB, const glm::vec<D, T, Q> &v) {
     //GLM_STATIC_ASSERT(D >= 2 && D <= 4, "invalid vector specialization");
     lua_LockScope _lock(LB.L);
-    TValue *o = s2v(LB.L->top);
-    glm_vec_boundary(&vvalue_(o)) = v;  // May use explicit copy constructor
-    settt_(o, glm_variant(D));
+    Set(LB.L, s2v(LB.L->top), v);
     api_incr_top(LB.L);
+    luaC_checkvecGC(LB.L);
     return 1;
   }
 };
@@ -900,6 +977,7 @@ struct gLuaTrait<const char *, FastPath> : gLuaAbstractTrait<const char *, const
 /// </summary>
 template<typename T, glm::qualifier Q, bool FastPath>
 struct gLuaTrait<glm::vec<1, T, Q>, FastPath> : gLuaAbstractVector<1, T, Q> {
+  static const LUA_CONSTEXPR int signature = gLuaTrait<T>::signature;  // @Signature
   LUA_BIND_DECL LUA_CONSTEXPR const char *Label() { return GLM_STRING_VECTOR1; }
 
   LUA_BIND_QUALIFIER bool Is(lua_State *L, int idx) {
@@ -976,6 +1054,7 @@ template<typename T, glm::qualifier Q, bool FastPath>
 struct gLuaTrait<glm::qua<T, Q>, FastPath> : gLuaAbstractTrait<glm::qua<T, Q>> {
   template<typename Type = T>
   using as_type = gLuaTrait<glm::qua<Type, Q>>;  // @CastBinding
+  static const LUA_CONSTEXPR int signature = LUA_VQUAT;  // @Signature
   LUA_BIND_DECL LUA_CONSTEXPR const char *Label() { return GLM_STRING_QUATERN; }
 
   LUA_BIND_QUALIFIER bool Is(lua_State *L, int idx) {
@@ -996,9 +1075,14 @@ struct gLuaTrait<glm::qua<T, Q>, FastPath> : gLuaAbstractTrait<glm::qua<T, Q>> {
   LUA_BIND_QUALIFIER int Push(const gLuaBase &LB, const glm::qua<T, Q> &q) {
     lua_LockScope _lock(LB.L);
     TValue *io = s2v(LB.L->top);
+#if defined(LUAGLM_COMPACT_VALUE)
+    setvvalue(LB.L, io, glmVectorBoundary(glmVector(q)).lua, LUA_VQUAT);
+#else
     glm_vec_boundary(&vvalue_(io)) = q;  // May use explicit copy constructor
     settt_(io, LUA_VQUAT);
+#endif
     api_incr_top(LB.L);
+    luaC_checkvecGC(LB.L);
     return 1;
   }
 };
@@ -1064,21 +1148,20 @@ struct gLuaTrait<glm::mat<C, R, T, Q>, FastPath> : gLuaAbstractTrait<glm::mat<C,
   LUA_BIND_DECL glm::mat<C, R, T, Q> Next(lua_State *L, int &idx) {
     lua_LockScope _lock(L);
     const TValue *o = glm_i2v(L, idx++);
-    if (FastPath || l_likely(ttismatrix(o))) {
+#if defined(LUAGLM_INLINE_MATRIX)
+    LUA_IF_CONSTEXPR(C == 2 && R == 2) {
+      if (ttisinlinematrix(o))
+        return glm_mat_cast(glm_m2value(o).m22, C, R, T, Q);
+    }
+#endif
+    if (FastPath || l_likely(ttisfullmatrix(o))) {
       // @TODO: LUA_IF_CONSTEXPR(std::is_same<T, glm_Float>::value && Q == LUAGLM_Q)
       // At the moment this relies on the compiler eliding this cast.
-      const glmMatrix &mat = glm_mvalue(o);
-      if (FastPath || l_likely(mat.dimensions == LUAGLM_MATRIX_TYPE(C, R))) {
-        static const LUA_CONSTEXPR glm::length_t D = LUAGLM_MATRIX_TYPE(C, R);
-        LUA_IF_CONSTEXPR(D == LUAGLM_MATRIX_2x2) return glm_mat_cast(mat.m22, C, R, T, Q);
-        LUA_IF_CONSTEXPR(D == LUAGLM_MATRIX_2x3) return glm_mat_cast(mat.m23, C, R, T, Q);
-        LUA_IF_CONSTEXPR(D == LUAGLM_MATRIX_2x4) return glm_mat_cast(mat.m24, C, R, T, Q);
-        LUA_IF_CONSTEXPR(D == LUAGLM_MATRIX_3x2) return glm_mat_cast(mat.m32, C, R, T, Q);
-        LUA_IF_CONSTEXPR(D == LUAGLM_MATRIX_3x3) return glm_mat_cast(mat.m33, C, R, T, Q);
-        LUA_IF_CONSTEXPR(D == LUAGLM_MATRIX_3x4) return glm_mat_cast(mat.m34, C, R, T, Q);
-        LUA_IF_CONSTEXPR(D == LUAGLM_MATRIX_4x2) return glm_mat_cast(mat.m42, C, R, T, Q);
-        LUA_IF_CONSTEXPR(D == LUAGLM_MATRIX_4x3) return glm_mat_cast(mat.m43, C, R, T, Q);
-        LUA_IF_CONSTEXPR(D == LUAGLM_MATRIX_4x4) return glm_mat_cast(mat.m44, C, R, T, Q);
+      const GCMatrix *mat = mvalue(o);
+      if (FastPath || l_likely(mat->dimensions == LUAGLM_MATRIX_TYPE(C, R))) {
+        // Components are stored with the layout of glm::mat<C, R>; see LUAGLM_MATRIX_STRIDE.
+        typedef glm::mat<C, R, glm_Float, LUAGLM_Q> glm_Mat;
+        return glm_mat_cast(*reinterpret_cast<const glm_Mat *>(matdata(mat)), C, R, T, Q);
       }
     }
     _lock.Unlock();
@@ -1094,8 +1177,9 @@ struct gLuaTrait<glm::mat<C, R, T, Q>, FastPath> : gLuaAbstractTrait<glm::mat<C,
     if (LB.can_recycle()) {
       lua_LockScope _lock(LB.L);
       const TValue *o = glm_i2v(LB.L, LB.idx++);
-      if (l_likely(ttismatrix(o))) {  // lua_pushvalue
-        glm_mat_boundary(mvalue_ref(o)) = m;
+      if (l_likely(ttisfullmatrix(o))) {  // lua_pushvalue
+        const glmMatrix m_(m);
+        glmMat_store(LB.L, mvalue(o), &lua_constmat_boundary(&m_));
         setobj2s(LB.L, LB.L->top, o);
         api_incr_top(LB.L);
         return 1;
@@ -1384,6 +1468,28 @@ template<typename T = glm_Float> using gLuaDir3 = gLuaTrait<glm::vec<3, T, LUAGL
   BIND_RESULT(LB, F(_a, _b, _c, _d, _e, _g, _h, _i)); \
   LUA_MLM_END
 
+/*
+** Overload dispatch on a packed argument signature: if 'Sig', the signature of
+** the leading arguments (gLuaBase::Signature), matches the signatures of traits
+** A, B (and C), bind F using their fast paths. Otherwise, fall through. The
+** test is discarded at compile-time when any of the traits does not have a
+** signature.
+**
+** Only LAYOUT_CLAMP and the numeric weight of LAYOUT_MIX use these tests:
+** computing a signature costs about as much as a Tr::Is() test, and elsewhere
+** (e.g., LAYOUT_BINARY_OPTIONAL) the test was measured to be no faster than
+** the overload it skips.
+*/
+#define BIND_PACKED2(LB, Sig, F, A, B, ...)                          \
+  if (GLM_SIG2(A::signature, B::signature) != GLM_SIG_NONE           \
+      && (Sig) == GLM_SIG2(A::signature, B::signature))              \
+    VA_CALL(BIND_FUNC, LB, F, A::fast, B::fast, ##__VA_ARGS__)
+
+#define BIND_PACKED3(LB, Sig, F, A, B, C, ...)                                 \
+  if (GLM_SIG3(A::signature, B::signature, C::signature) != GLM_SIG_NONE       \
+      && (Sig) == GLM_SIG3(A::signature, B::signature, C::signature))          \
+    VA_CALL(BIND_FUNC, LB, F, A::fast, B::fast, C::fast, ##__VA_ARGS__)
+
 /*
 ** Place values onto the Lua stack in an order-of-evaluation independent nature;
 ** returning the number of values placed onto the Lua stack.
@@ -1457,6 +1563,7 @@ template<typename T = glm_Float> using gLuaDir3 = gLuaTrait<glm::vec<3, T, LUAGL
 #define LAYOUT_UNARY(LB, F, Tr, ...) VA_CALL(BIND_FUNC, LB, F, Tr, ##__VA_ARGS__)
 #define LAYOUT_BINARY(LB, F, Tr, ...) VA_CALL(BIND_FUNC, LB, F, Tr, Tr::safe, ##__VA_ARGS__)
 #define LAYOUT_TERNARY(LB, F, Tr, ...) VA_CALL(BIND_FUNC, LB, F, Tr, Tr::safe, Tr::safe, ##__VA_ARGS__)
+
 #define LAYOUT_QUATERNARY(LB, F, Tr, ...) VA_CALL(BIND_FUNC, LB, F, Tr, Tr::safe, Tr::safe, Tr::safe, ##__VA_ARGS__)
 #define LAYOUT_QUINARY(LB, F, Tr, ...) VA_CALL(BIND_FUNC, LB, F, Tr, Tr::safe, Tr::safe, Tr::safe, Tr::safe, ##__VA_ARGS__)
 #define LAYOUT_SENARY(LB, F, Tr, ...) VA_CALL(BIND_FUNC, LB, F, Tr, Tr::safe, Tr::safe, Tr::safe, Tr::safe, Tr::safe, ##__VA_ARGS__)
@@ -1644,7 +1751,8 @@ template<typename T = glm_Float> using gLuaDir3 = gLuaTrait<glm::vec<3, T, LUAGL
   const TValue *_tv = (LB).i2v();                                                           \
   switch (ttypetag(_tv)) {                                                                  \
     case LUA_VQUAT: ArgLayout(LB, F, gLuaQuat<>, ##__VA_ARGS__); break;                     \
-    case LUA_VMATRIX: {                                                                     \
+    case LUA_VMATRIX:                                                                       \
+    case LUA_VMATRIX2: {                                                                    \
       switch (mvalue_dims(_tv)) {                                                           \
         case LUAGLM_MATRIX_3x3: ArgLayout(LB, F, gLuaMat3x3<>::fast, ##__VA_ARGS__); break; \
         case LUAGLM_MATRIX_3x4: ArgLayout(LB, F, gLuaMat3x4<>::fast, ##__VA_ARGS__); break; \
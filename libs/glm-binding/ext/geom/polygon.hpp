@@ -5,7 +5,6 @@
 #define EXT_GEOM_POLYGON_HPP
 
 #include "setup.hpp"
-#include "allocator.hpp"
 
 #include "line.hpp"
 #include "linesegment.hpp"
@@ -19,10 +18,38 @@
 
 namespace glm {
   /// <summary>
-  /// A STL vector that uses the Lua allocator
+  /// Contiguous point storage of a polygon: a header followed by the inline
+  /// points of the polygon, i.e., both are a single allocation (userdata). Once
+  /// the inline capacity is exhausted all points are moved to a larger block
+  /// owned by the binding; 'data' always references the first point.
   /// </summary>
   template<typename T>
-  using List = LuaVector<T>;
+  struct List {
+    typedef T *iterator;
+    typedef const T *const_iterator;
+
+    T *data;
+    size_t count;  // Number of points.
+    size_t capacity;  // Number of points 'data' can store.
+
+    /// <summary>
+    /// Offset of the inline points from the start of the header.
+    /// </summary>
+    static size_t offset() {
+      return ((sizeof(List<T>) + alignof(T) - 1) / alignof(T)) * alignof(T);
+    }
+
+    /// <summary>
+    /// Size of a header with 'n' inline points.
+    /// </summary>
+    static size_t bytes(size_t n) {
+      return offset() + n * sizeof(T);
+    }
+
+    T *inlined() {
+      return reinterpret_cast<T *>(reinterpret_cast<char *>(this) + offset());
+    }
+  };
 
   /// <summary>
   /// Describes the thickness of the polygon (i.e., how the third dimension
@@ -38,7 +65,7 @@ namespace glm {
   /// A two-dimensional closed surface in three-dimensional space.
   ///
   /// @NOTE: This polygon implementation is tailored specifically to the Lua
-  ///   binding. The "glm::List" pointer is owned by the userdata bound to the
+  ///   binding. The "glm::List" pointer references the userdata bound to the
   ///   garbage collector.
   /// </summary>
   template<length_t L, typename T, qualifier Q>
@@ -49,6 +76,7 @@ namespace glm {
     typedef T value_type;
     typedef Polygon<L, T, Q> type;
     typedef vec<L, T, Q> point_type;
+    typedef List<point_type> list_type;
 
     // -- Data --
 
@@ -91,42 +119,42 @@ namespace glm {
 
     GLM_FUNC_QUALIFIER size_t size() const {
       lua_assert(p != GLM_NULLPTR);
-      return (p == GLM_NULLPTR) ? 0 : p->size();
+      return (p == GLM_NULLPTR) ? 0 : p->count;
     }
 
     GLM_FUNC_QUALIFIER const point_type &back() const {
-      lua_assert(p != GLM_NULLPTR);
-      return p->back();
+      lua_assert(p != GLM_NULLPTR && p->count > 0);
+      return p->data[p->count - 1];
     }
 
     GLM_FUNC_QUALIFIER point_type &operator[](size_t i) {
-      lua_assert(p != GLM_NULLPTR);
-      return p->operator[](i);
+      lua_assert(p != GLM_NULLPTR && i < p->count);
+      return p->data[i];
     }
 
     GLM_FUNC_QUALIFIER const point_type &operator[](size_t i) const {
-      lua_assert(p != GLM_NULLPTR);
-      return p->operator[](i);
+      lua_assert(p != GLM_NULLPTR && i < p->count);
+      return p->data[i];
     }
 
     GLM_FUNC_QUALIFIER typename List<point_type>::const_iterator begin() const {
       lua_assert(p != GLM_NULLPTR);
-      return p->begin();
+      return p->data;
     }
 
     GLM_FUNC_QUALIFIER typename List<point_type>::const_iterator cbegin() const {
       lua_assert(p != GLM_NULLPTR);
-      return p->cbegin();
+      return p->data;
     }
 
     GLM_FUNC_QUALIFIER typename List<point_type>::const_iterator end() const {
       lua_assert(p != GLM_NULLPTR);
-      return p->end();
+      return p->data + p->count;
     }
 
     GLM_FUNC_QUALIFIER typename List<point_type>::const_iterator cend() const {
       lua_assert(p != GLM_NULLPTR);
-      return p->cend();
+      return p->data + p->count;
     }
   };
 
@@ -7,13 +7,16 @@
 #ifndef BINDING_GEOM_HPP
 #define BINDING_GEOM_HPP
 
+#include <cstdint>
+#include <cstring>
+
 #include "lua.hpp"
 #include "lglm.hpp"
 #include "lglm_core.h"
 
-#include "allocator.hpp"
 #include "iterators.hpp"
 #include "bindings.hpp"
+#include "threads.hpp"
 
 #include "ext/geom/setup.hpp"
 #include "ext/geom/aabb.hpp"
@@ -317,9 +320,8 @@ struct gLuaTrait<glm::Polygon<3, T, Q>, FastPath> : gLuaAbstractTrait<glm::Polyg
   LUA_BIND_QUALIFIER glm::Polygon<3, T, Q> Next(lua_State *L_, int &idx) {
     void *ptr = GLM_NULLPTR;
     if ((ptr = luaL_checkudata(L_, idx, Metatable())) != GLM_NULLPTR) {
-      glm::Polygon<3, T, Q> result = *(static_cast<glm::Polygon<3, T, Q> *>(ptr));
+      glm::Polygon<3, T, Q> result(static_cast<typename glm::Polygon<3, T, Q>::list_type *>(ptr));
       result.stack_idx = idx++;
-      result.p->validate(L_);
       return result;
     }
     else {
@@ -855,6 +857,311 @@ static const luaL_Reg luaglm_linelib[] = {
 
 /* }================================================================== */
 
+/*
+** {==================================================================
+** Ray Packets
+** ===================================================================
+*/
+
+/*
+@@ LUAGLM_RAY_PACKET Number of primitives tested at a time by the batched
+** ray queries. Each packet is stored as a structure-of-arrays and every test
+** keeps its lane loop innermost, so that it autovectorizes (at -O2 with GCC)
+** to the width of the target: 4 lanes per SSE, 8 per AVX, instruction.
+*/
+#if !defined(LUAGLM_RAY_PACKET)
+  #define LUAGLM_RAY_PACKET 8
+#endif
+
+/* Component type of all packed primitives (independent of glm_Float) */
+using gRayFloat = float;
+
+/* Result of a test per lane: nonzero for a hit (as wide as gRayFloat) */
+using gRayMask = int32_t;
+
+/// <summary>
+/// A structure-of-arrays packet of LUAGLM_RAY_PACKET primitives, each made of
+/// 'Points' vec3s (3 for a triangle).
+/// </summary>
+template<int Points>
+struct gRayPacket {
+  gRayFloat c[3 * Points][LUAGLM_RAY_PACKET];  // c[component][lane]
+};
+
+/// <summary>
+/// A sequence of primitives: a string of tightly packed single-precision
+/// components (string.pack("fff...", ...) compatible), or an array of vec3s:
+/// 2 per AABB (minimum, maximum) and 3 per triangle.
+/// </summary>
+template<int Points>
+struct gRayPrimitives {
+  static const size_t size = 3 * Points * sizeof(gRayFloat);
+
+  lua_State *L;
+  int idx;
+  const char *data = GLM_NULLPTR;  // Packed primitives; GLM_NULLPTR for an array
+  size_t count = 0;
+
+  gRayPrimitives(lua_State *L_, int idx_)
+    : L(L_), idx(idx_) {
+    size_t len = 0;
+    if (lua_type(L, idx) == LUA_TSTRING) {
+      data = lua_tolstring(L, idx, &len);
+      count = len / size;
+    }
+    else if (lua_istable(L, idx)) {
+      count = static_cast<size_t>(luaL_len(L, idx)) / Points;
+    }
+    else {
+      luaL_typeerror(L, idx, "string or table");
+    }
+  }
+
+  /// <summary>
+  /// Load the components of the (zero-based) primitive 'n'.
+  /// </summary>
+  void Get(size_t n, gRayFloat (&v)[3 * Points]) const {
+    if (data != GLM_NULLPTR) {
+      std::memcpy(v, data + n * size, size);
+      return;
+    }
+
+    for (int j = 0; j < Points; ++j) {
+      const lua_Integer i = static_cast<lua_Integer>(n * Points + static_cast<size_t>(j)) + 1;
+      glm::length_t length = 0;
+      if (l_unlikely(lua_rawgeti(L, idx, i) == LUA_TNIL || !glm_isvector(L, -1, length) || length < 3))
+        luaL_error(L, "invalid vector at index %I (" GLM_STRING_VECTOR3 " expected)", static_cast<LUAI_UACINT>(i));
+
+      const glm::vec<3, gRayFloat> p(glm_tovec3(L, -1));
+      v[3 * j + 0] = p.x;
+      v[3 * j + 1] = p.y;
+      v[3 * j + 2] = p.z;
+      lua_pop(L, 1);
+    }
+  }
+
+  /// <summary>
+  /// Load 'lanes' primitives starting at 'base' into the packet. Unused lanes
+  /// are zeroed and must be masked by the caller.
+  /// </summary>
+  void Load(gRayPacket<Points> &p, size_t base, int lanes) const {
+    for (int l = 0; l < lanes; ++l) {
+      gRayFloat v[3 * Points];
+      Get(base + static_cast<size_t>(l), v);
+      for (int k = 0; k < 3 * Points; ++k)
+        p.c[k][l] = v[k];
+    }
+
+    for (int k = 0; k < 3 * Points; ++k) {
+      for (int l = lanes; l < LUAGLM_RAY_PACKET; ++l)
+        p.c[k][l] = gRayFloat(0);
+    }
+  }
+};
+
+/// <summary>
+/// Slab test of a ray against an AABB (minimum, maximum): 'tNear' is the entry
+/// distance clamped to zero (origin inside), rejecting boxes beyond 'tMax'.
+/// </summary>
+static bool glm_ray_aabb(const gRayFloat (&b)[6], const gRayFloat (&o)[3], const gRayFloat (&inv)[3],
+  gRayFloat tMax, gRayFloat &tNear) {
+  gRayFloat tFar = tMax;
+  tNear = gRayFloat(0);
+  for (int a = 0; a < 3; ++a) {
+    const gRayFloat t1 = (b[a] - o[a]) * inv[a];
+    const gRayFloat t2 = (b[3 + a] - o[a]) * inv[a];
+    tNear = glm::max(tNear, glm::min(t1, t2));
+    tFar = glm::min(tFar, glm::max(t1, t2));
+  }
+  return tNear <= tFar;
+}
+
+/// <summary>
+/// Möller–Trumbore test of a ray against each triangle of the packet,
+/// rejecting hits beyond 'tMax'. Backfaces are not culled.
+/// </summary>
+static void glm_raypacket_triangle(const gRayPacket<3> &p, const gRayFloat (&o)[3], const gRayFloat (&d)[3],
+  gRayFloat tMax, gRayFloat (&t)[LUAGLM_RAY_PACKET], gRayFloat (&u)[LUAGLM_RAY_PACKET],
+  gRayFloat (&v)[LUAGLM_RAY_PACKET], gRayMask (&hit)[LUAGLM_RAY_PACKET]) {
+  const gRayFloat eps = glm::epsilon<gRayFloat>();
+  for (int l = 0; l < LUAGLM_RAY_PACKET; ++l) {
+    const gRayFloat e1x = p.c[3][l] - p.c[0][l], e1y = p.c[4][l] - p.c[1][l], e1z = p.c[5][l] - p.c[2][l];
+    const gRayFloat e2x = p.c[6][l] - p.c[0][l], e2y = p.c[7][l] - p.c[1][l], e2z = p.c[8][l] - p.c[2][l];
+
+    const gRayFloat px = d[1] * e2z - d[2] * e2y;  // p = cross(d, e2)
+    const gRayFloat py = d[2] * e2x - d[0] * e2z;
+    const gRayFloat pz = d[0] * e2y - d[1] * e2x;
+    const gRayFloat det = e1x * px + e1y * py + e1z * pz;
+    const gRayFloat invDet = gRayFloat(1) / det;  // Parallel: inf/NaN, masked below
+
+    const gRayFloat sx = o[0] - p.c[0][l], sy = o[1] - p.c[1][l], sz = o[2] - p.c[2][l];
+    const gRayFloat qx = sy * e1z - sz * e1y;  // q = cross(s, e1)
+    const gRayFloat qy = sz * e1x - sx * e1z;
+    const gRayFloat qz = sx * e1y - sy * e1x;
+
+    const gRayFloat lu = (sx * px + sy * py + sz * pz) * invDet;
+    const gRayFloat lv = (d[0] * qx + d[1] * qy + d[2] * qz) * invDet;
+    const gRayFloat lt = (e2x * qx + e2y * qy + e2z * qz) * invDet;
+    u[l] = lu;
+    v[l] = lv;
+    t[l] = lt;
+    hit[l] = (glm::abs(det) > eps) & (lu >= gRayFloat(0)) & (lv >= gRayFloat(0))
+             & (lu + lv <= gRayFloat(1)) & (lt >= gRayFloat(0)) & (lt <= tMax);
+  }
+}
+
+/// <summary>
+/// Nearest intersection of a batched ray query.
+/// </summary>
+struct gRayHit {
+  size_t index = 0;  // One-based; zero for no intersection
+  gRayFloat t = gRayFloat(0);
+  gRayFloat u = gRayFloat(0);
+  gRayFloat v = gRayFloat(0);
+
+  /// <summary>
+  /// Keep the nearest of both hits; the lowest index of equidistant hits so
+  /// the result does not depend on how the sequence was split.
+  /// </summary>
+  void Merge(const gRayHit &other) {
+    if (other.index != 0 && (index == 0 || other.t < t || (other.t == t && other.index < index)))
+      *this = other;
+  }
+};
+
+/// <summary>
+/// Apply a packet test, Test(packet, tMax, t, u, v, hit), to all primitives
+/// of the sequence. Packed primitives never touch the Lua state and may be
+/// split across the worker thread pool (threads.hpp): each chunk is tested
+/// independently (its nearest hit bounding the remaining packets) and merged.
+/// </summary>
+template<int Points, typename Test>
+static gRayHit glm_raypacket_nearest(const gRayPrimitives<Points> &prims, gRayFloat tMax, bool any, Test test) {
+  gRayHit result;
+  gLuaThreadMutex mutex;
+  auto kernel = [&](size_t begin, size_t end) {
+    gRayPacket<Points> packet;
+    gRayFloat t[LUAGLM_RAY_PACKET], u[LUAGLM_RAY_PACKET] = { }, v[LUAGLM_RAY_PACKET] = { };
+    gRayMask hit[LUAGLM_RAY_PACKET];
+
+    gRayHit nearest;
+    nearest.t = tMax;
+    for (size_t base = begin; base < end && !(any && nearest.index != 0); base += LUAGLM_RAY_PACKET) {
+      const int lanes = static_cast<int>(glm::min<size_t>(LUAGLM_RAY_PACKET, end - base));
+      prims.Load(packet, base, lanes);
+      test(packet, nearest.t, t, u, v, hit);
+      for (int l = 0; l < lanes; ++l) {
+        if (hit[l] && (nearest.index == 0 || t[l] < nearest.t)) {
+          nearest.index = base + static_cast<size_t>(l) + 1;
+          nearest.t = t[l];
+          nearest.u = u[l];
+          nearest.v = v[l];
+        }
+      }
+    }
+
+    std::lock_guard<gLuaThreadMutex> guard(mutex);
+    result.Merge(nearest);
+  };
+
+  if (prims.data != GLM_NULLPTR)
+    glm_parallel_for(prims.count, LUAGLM_RAY_PACKET, kernel);
+  else
+    kernel(0, prims.count);
+  return result;
+}
+
+/// <summary>
+/// Parse the ray and the trailing [, tMax [, any]] arguments of a batched ray
+/// query; the direction is not normalized so distances are relative to it.
+/// </summary>
+static void glm_raypacket_args(gLuaBase &LB, gRayFloat (&o)[3], gRayFloat (&d)[3], gRayFloat &tMax, bool &any) {
+  const gLuaRay<>::type ray = LB.Next<gLuaRay<>>();
+  for (int a = 0; a < 3; ++a) {
+    o[a] = static_cast<gRayFloat>(ray.pos[a]);
+    d[a] = static_cast<gRayFloat>(ray.dir[a]);
+  }
+
+  tMax = static_cast<gRayFloat>(luaL_optnumber(LB.L, LB.idx + 1, std::numeric_limits<lua_Number>::infinity()));
+  any = lua_toboolean(LB.L, LB.idx + 2) != 0;
+}
+
+/// <summary>
+/// Nearest intersection of a ray with a sequence of AABBs:
+///   ray.nearestAABB(rayPos, rayDir, aabbs [, tMax [, any]])
+/// where 'aabbs' is a string of packed (minimum, maximum) pairs or an array of
+/// vec3s of the same layout. Returns the (one-based) index of the nearest box
+/// and the distance along the ray, or nil when no box is hit. When 'any' is
+/// true the first intersection found is returned (e.g., occlusion queries).
+/// </summary>
+GLM_BINDING_QUALIFIER(ray_nearestAABB) {
+  GLM_BINDING_BEGIN
+  gRayFloat o[3], d[3], inv[3], tMax;
+  bool any;
+  glm_raypacket_args(LB, o, d, tMax, any);
+  for (int a = 0; a < 3; ++a) {  // Avoid NaNs from 0 * inf in the slab test
+    const gRayFloat eps = glm::epsilon<gRayFloat>();
+    inv[a] = gRayFloat(1) / (glm::abs(d[a]) < eps ? (d[a] < gRayFloat(0) ? -eps : eps) : d[a]);
+  }
+
+  // The slab test is a handful of operations per box: packing boxes into
+  // lanes costs more than it saves, so boxes are tested one at a time.
+  const gRayPrimitives<2> aabbs(LB.L, LB.idx);
+  gRayHit hit;
+  hit.t = tMax;
+  for (size_t i = 0; i < aabbs.count && !(any && hit.index != 0); ++i) {
+    gRayFloat box[6], t;
+    aabbs.Get(i, box);
+    if (glm_ray_aabb(box, o, inv, hit.t, t) && (hit.index == 0 || t < hit.t)) {
+      hit.index = i + 1;
+      hit.t = t;
+    }
+  }
+
+  if (hit.index == 0) {
+    luaL_pushfail(LB.L);
+    return 1;
+  }
+  lua_pushinteger(LB.L, static_cast<lua_Integer>(hit.index));
+  lua_pushnumber(LB.L, static_cast<lua_Number>(hit.t));
+  return 2;
+  GLM_BINDING_END
+}
+
+/// <summary>
+/// Nearest intersection of a ray with a sequence of triangles:
+///   ray.nearestTriangle(rayPos, rayDir, triangles [, tMax [, any]])
+/// where 'triangles' is a string of packed vertex triples or an array of vec3s
+/// of the same layout. Returns the (one-based) index of the nearest triangle,
+/// the distance along the ray, and the barycentric coordinates (u, v) of the
+/// intersection; or nil when no triangle is hit.
+/// </summary>
+GLM_BINDING_QUALIFIER(ray_nearestTriangle) {
+  GLM_BINDING_BEGIN
+  gRayFloat o[3], d[3], tMax;
+  bool any;
+  glm_raypacket_args(LB, o, d, tMax, any);
+
+  const gRayPrimitives<3> triangles(LB.L, LB.idx);
+  const gRayHit hit = glm_raypacket_nearest(triangles, tMax, any, [&](const gRayPacket<3> &p, gRayFloat bound,
+    gRayFloat (&t)[LUAGLM_RAY_PACKET], gRayFloat (&u)[LUAGLM_RAY_PACKET], gRayFloat (&v)[LUAGLM_RAY_PACKET], gRayMask (&h)[LUAGLM_RAY_PACKET]) {
+    glm_raypacket_triangle(p, o, d, bound, t, u, v, h);
+  });
+
+  if (hit.index == 0) {
+    luaL_pushfail(LB.L);
+    return 1;
+  }
+  lua_pushinteger(LB.L, static_cast<lua_Integer>(hit.index));
+  lua_pushnumber(LB.L, static_cast<lua_Number>(hit.t));
+  lua_pushnumber(LB.L, static_cast<lua_Number>(hit.u));
+  lua_pushnumber(LB.L, static_cast<lua_Number>(hit.v));
+  return 4;
+  GLM_BINDING_END
+}
+
+/* }================================================================== */
+
 /*
 ** {==================================================================
 ** Ray
@@ -917,6 +1224,8 @@ static const luaL_Reg luaglm_raylib[] = {
   { "intersectsAABB", GLM_NAME(ray_intersectsAABB) },
   { "intersectsTriangle", GLM_NAME(ray_intersectsTriangle) },
   { "intersectPlane", GLM_NAME(ray_intersectsPlane) },
+  { "nearestAABB", GLM_NAME(ray_nearestAABB) },
+  { "nearestTriangle", GLM_NAME(ray_nearestTriangle) },
   { "projectToAxis", GLM_NAME(ray_projectToAxis) },
   // @DEPRECATED: intersectsObject
   { "intersectSphere", GLM_NAME(ray_intersectsSphere) },
@@ -1702,6 +2011,42 @@ GLM_BINDING_QUALIFIER(polygon_extremePoint) {
 
 /* Polygon Metamethods */
 
+/*
+@@ LUAGLM_POLYGON_INLINE Minimum number of points stored inline, i.e., within
+** the polygon userdata, by polygons created by polygon.new.
+*/
+#if !defined(LUAGLM_POLYGON_INLINE)
+  #define LUAGLM_POLYGON_INLINE 8
+#endif
+
+using gLuaPolyList = gLuaPolygon<>::type::list_type;
+
+/// <summary>
+/// Ensure the polygon at the (absolute) stack index 'idx' can store 'n' points.
+/// Points that no longer fit are moved to a larger block referenced by the
+/// first user value of the polygon, releasing the previous block, if any.
+/// </summary>
+static void glm_polygonreserve(lua_State *L, int idx, gLuaPolyList *list, size_t n) {
+  using Point = gLuaPolygon<>::point_trait::type;
+  if (n > list->capacity) {
+    const size_t limit = (~static_cast<size_t>(0)) / sizeof(Point);
+    size_t capacity = list->capacity + (list->capacity >> 1);
+    if (capacity < n)
+      capacity = n;
+    if (l_unlikely(capacity > limit)) {
+      luaL_error(L, "polygon too large");
+      return;
+    }
+
+    Point *data = static_cast<Point *>(lua_newuserdatauv(L, capacity * sizeof(Point), 0));
+    if (list->count > 0)
+      std::memcpy(static_cast<void *>(data), list->data, list->count * sizeof(Point));
+    lua_setiuservalue(L, idx, 1);
+    list->data = data;
+    list->capacity = capacity;
+  }
+}
+
 /// <summary>
 /// Create a new polygon from an array of points.
 /// </summary>
@@ -1712,32 +2057,29 @@ GLM_BINDING_QUALIFIER(polygon_new) {
     return LUAGLM_ARG_ERROR(LB.L, LB.idx, lua_typename(LB.L, LUA_TTABLE));
   }
 
-  // Create a new polygon userdata.
-  void *ptr = lua_newuserdatauv(LB.L, sizeof(gLuaPolygon<>::type), 0);  // [..., poly]
-  gLuaPolygon<>::type *polygon = static_cast<gLuaPolygon<>::type *>(ptr);
-  polygon->stack_idx = -1;
-  polygon->p = GLM_NULLPTR;
+  // Create a new polygon userdata: the header and the inline points.
+  const gLuaArray<gLuaPolygon<>::point_trait> lArray(LB.L, LB.idx);
+  const size_t count = (n >= 1) ? static_cast<size_t>(lArray.size()) : 0;
+  const size_t capacity = (count > LUAGLM_POLYGON_INLINE) ? count : LUAGLM_POLYGON_INLINE;
+  if (l_unlikely(capacity > ((~static_cast<size_t>(0)) - gLuaPolyList::offset()) / sizeof(gLuaPolygon<>::point_trait::type))) {
+    return LUAGLM_ERROR(LB.L, "polygon too large");
+  }
+
+  void *ptr = lua_newuserdatauv(LB.L, gLuaPolyList::bytes(capacity), 1);  // [..., poly]
+  gLuaPolyList *list = static_cast<gLuaPolyList *>(ptr);
+  list->data = list->inlined();
+  list->count = 0;
+  list->capacity = capacity;
 
   // Setup metatable.
   if (luaL_getmetatable(LB.L, gLuaPolygon<>::Metatable()) == LUA_TTABLE) {  // [..., poly, meta]
     lua_setmetatable(LB.L, -2);  // [..., poly]
-    LuaCrtAllocator<gLuaPolygon<>::point_trait::type> allocator(LB.L);
-
-    // Create a vector backed by the Lua allocator.
-    using PolyList = glm::List<gLuaPolygon<>::point_trait::type>;
-    PolyList *list = static_cast<PolyList *>(allocator.realloc(GLM_NULLPTR, 0, sizeof(PolyList)));
-    if (l_unlikely(list == GLM_NULLPTR)) {
-      lua_pop(L, 1);
-      return LUAGLM_ERROR(L, "polygon allocation error");
-    }
 
     // Populate the polygon with an array of coordinates, if one exists.
-    polygon->p = ::new (list) PolyList(LB.L, allocator);
-    if (l_likely(n >= 1 && lua_istable(LB.L, LB.idx))) {
-      gLuaArray<gLuaPolygon<>::point_trait> lArray(LB.L, LB.idx);
+    if (count > 0) {
       const auto e = lArray.end();
-      for (auto b = lArray.begin(); b != e; ++b) {
-        polygon->p->push_back(*b);
+      for (auto b = lArray.begin(); b != e && list->count < count; ++b) {
+        list->data[list->count++] = *b;
       }
     }
 
@@ -1750,29 +2092,9 @@ GLM_BINDING_QUALIFIER(polygon_new) {
 }
 
 GLM_BINDING_QUALIFIER(polygon_to_string) {
-  gLuaPolygon<>::type *ud = static_cast<gLuaPolygon<>::type *>(luaL_checkudata(L, 1, gLuaPolygon<>::Metatable()));
-  if (l_likely(ud->p != GLM_NULLPTR)) {
-    ud->p->validate(L);
-    lua_pushfstring(L, "Polygon<%I>", ud->p->size());
-    return 1;
-  }
-
-  return LUAGLM_ARG_ERROR(L, 1, "Polygon");
-}
-
-/// <summary>
-/// Garbage collect an allocated polygon userdata.
-/// </summary>
-GLM_BINDING_QUALIFIER(polygon_gc) {
-  gLuaPolygon<>::type *ud = static_cast<gLuaPolygon<>::type *>(luaL_checkudata(L, 1, gLuaPolygon<>::Metatable()));
-  if (l_likely(ud->p != GLM_NULLPTR)) {
-    LuaCrtAllocator<void> allocator(L);
-    ud->p->validate(L);
-    ud->p->~LuaVector();  // Invoke destructor.
-    allocator.realloc(ud->p, sizeof(glm::List<gLuaPolygon<>::point_trait::type>), 0);  // Free allocation
-    ud->p = GLM_NULLPTR;
-  }
-  return 0;
+  const gLuaPolyList *ud = static_cast<gLuaPolyList *>(luaL_checkudata(L, 1, gLuaPolygon<>::Metatable()));
+  lua_pushfstring(L, "Polygon<%I>", static_cast<lua_Integer>(ud->count));
+  return 1;
 }
 
 /// <summary>
@@ -1781,7 +2103,8 @@ GLM_BINDING_QUALIFIER(polygon_gc) {
 BIND_DEFN(polygon_len, glm::length, gLuaPolygon<>)
 
 /// <summary>
-/// Create an array of points.
+/// Create an array of points. The batch API accepts polygons as vec3 arrays
+/// without copying their points; see glm_batchpolygon.
 /// </summary>
 GLM_BINDING_QUALIFIER(polygon_call) {
   GLM_BINDING_BEGIN
@@ -1820,18 +2143,16 @@ GLM_BINDING_QUALIFIER(polygon_index) {
 GLM_BINDING_QUALIFIER(polygon_newindex) {
   GLM_BINDING_BEGIN
   gLuaPolygon<>::type poly = LB.Next<gLuaPolygon<>>();
-  if (l_likely(poly.p != GLM_NULLPTR)) {
-    const size_t index = LB.AsNextType<size_t>();
-    const gLuaPolygon<>::point_trait::type value = LB.Next<gLuaPolygon<>::point_trait>();
-
-    poly.p->validate(LB.L);
-    if (index >= 1 && index <= poly.size())
-      poly[index - 1] = value;
-    else if (index == poly.size() + 1)
-      poly.p->push_back(value);
-    else {
-      return LUAGLM_ERROR(LB.L, "Invalid polygon index");
-    }
+  const size_t index = LB.AsNextType<size_t>();
+  const gLuaPolygon<>::point_trait::type value = LB.Next<gLuaPolygon<>::point_trait>();
+  if (index >= 1 && index <= poly.size())
+    poly[index - 1] = value;
+  else if (index == poly.size() + 1) {
+    glm_polygonreserve(LB.L, poly.stack_idx, poly.p, index);
+    poly.p->data[poly.p->count++] = value;
+  }
+  else {
+    return LUAGLM_ERROR(LB.L, "Invalid polygon index");
   }
   return 0;
   GLM_BINDING_END
@@ -1855,7 +2176,7 @@ extern "C" {
         BIND_PUSH(LB, key + 1, poly[key]);
       return gLuaBase::Push(LB);
     }
-    else if (gLuaBase::isnoneornil(LB.L, LB.idx) && poly.size() > 0)  // First index
+    else if (lua_isnoneornil(LB.L, LB.idx) && poly.size() > 0)  // First index: the initial (explicit) nil of __pairs
       BIND_PUSH(LB, size_t(1), poly[0]);
     else
       return gLuaBase::Push(LB);  // Nothing to iterate.
@@ -1871,7 +2192,6 @@ GLM_BINDING_QUALIFIER(polygon_pairs) {
 }
 
 static const luaL_Reg luaglm_polylib[] = {
-  { "__gc", GLM_NAME(polygon_gc) },
   { "__index", GLM_NAME(polygon_index) },  // Array access
   { "__newindex", GLM_NAME(polygon_newindex) },  // Only allow append
   { "__len", GLM_NAME(polygon_len) },  // # of Points
@@ -28,8 +28,13 @@
 #include "lglmlib.hpp"
 
 #include "api.hpp"
+#include "orderedlist.hpp"
 #if defined(LUAGLM_INCLUDE_GEOM)
   #include "geom.hpp"
+  #include "spatial.hpp"
+#endif
+#if defined(LUAGLM_EXT_BLOB)
+  #include "batch.hpp"
 #endif
 
 #include <glm/glm.hpp>
@@ -67,18 +72,6 @@
   lua_setfield((L), -2, "" REG_STR(Name));                \
   LUA_MLM_END
 
-/// <summary>
-/// Pushes onto the stack the value GLM[k], where GLM is the binding library
-/// stored as an upvalue to this metamethod.
-/// </summary>
-static int glm_libraryindex(lua_State *L) {
-  lua_settop(L, 2);
-  if (lua_rawget(L, lua_upvalueindex(1)) != LUA_TFUNCTION) {  // Only functions can be accessed
-    lua_pop(L, 1);
-    lua_pushnil(L);
-  }
-  return 1;
-}
 
 #if defined(LUAGLM_INCLUDE_GEOM)
 /// <summary>
@@ -162,6 +155,8 @@ static const luaL_Reg luaglm_lib[] = {
   { "__index", GLM_NULLPTR },
   /* RNG API */
   { "distribution", GLM_NULLPTR },
+  /* Ordered List API */
+  { "orderedlist", GLM_NULLPTR },
   /* Geometry API */
 #if defined(LUAGLM_INCLUDE_GEOM)
   { "aabb", GLM_NULLPTR },
@@ -175,6 +170,11 @@ static const luaL_Reg luaglm_lib[] = {
   { "aabb2d", GLM_NULLPTR },
   { "segment2d", GLM_NULLPTR },
   { "circle", GLM_NULLPTR },
+  { "spatial", GLM_NULLPTR },
+#endif
+  /* Batch API */
+#if defined(LUAGLM_EXT_BLOB)
+  { "batch", GLM_NULLPTR },
 #endif
   /* Library Details */
   { "_NAME", GLM_NULLPTR },
@@ -210,15 +210,106 @@ static const luaL_Reg luaglm_randfuncs[] = {
   { GLM_NULLPTR, GLM_NULLPTR }
 };
 
-/* Functions with a lib-glm upvalue */
+/*
+** Functions with a lib-glm upvalue. glm_libraryindex (lglm.cpp) is recognized
+** by the OP_SELF inline cache of vector/matrix methods.
+*/
 static const luaL_Reg luaglm_metamethods[] = {
   { "__index", glm_libraryindex },
   { GLM_NULLPTR, GLM_NULLPTR }
 };
 
+#if defined(LUAGLM_EXT_FASTCALL)
+/*
+** Typed variants of common bindings invoked by OP_CALL directly on the
+** registers of the call (see luaV_setfastcall). Each variant must compute
+** the same result as its binding for arguments matching its signature.
+*/
+
+/* Argument 'i' of a fast call */
+#define FAST_ARG(func, i) s2v((func) + 1 + (i))
+#define FAST_NUM(func, i) static_cast<glm_Float>(nvalue(FAST_ARG(func, i)))
+
+template<glm::length_t D> struct gFastVector;
+template<> struct gFastVector<2> { LUA_BIND_QUALIFIER gLuaVec2<>::type Get(const TValue *o) { return glm_v2value(o); } };
+template<> struct gFastVector<3> { LUA_BIND_QUALIFIER gLuaVec3<>::type Get(const TValue *o) { return glm_v3value(o); } };
+template<> struct gFastVector<4> { LUA_BIND_QUALIFIER gLuaVec4<>::type Get(const TValue *o) { return glm_v4value(o); } };
+
+#define FAST_VEC(func, i) gFastVector<D>::Get(FAST_ARG(func, i))
+#define FAST_SETNUM(func, v) setfltvalue(s2v(func), static_cast<lua_Number>(v))
+#define FAST_SETVEC(L, func, v) gLuaTrait<glm::vec<D, glm_Float, LUAGLM_BINDING_QUAL>>::Set((L), s2v(func), (v))
+
+template<glm::length_t D> static void fast_dot(lua_State *L, StkId func) { ((void)L); FAST_SETNUM(func, glm::dot(FAST_VEC(func, 0), FAST_VEC(func, 1))); }
+template<glm::length_t D> static void fast_length(lua_State *L, StkId func) { ((void)L); FAST_SETNUM(func, glm::length(FAST_VEC(func, 0))); }
+template<glm::length_t D> static void fast_distance(lua_State *L, StkId func) { ((void)L); FAST_SETNUM(func, glm::distance(FAST_VEC(func, 0), FAST_VEC(func, 1))); }
+template<glm::length_t D> static void fast_normalize(lua_State *L, StkId func) { FAST_SETVEC(L, func, glm::normalize(FAST_VEC(func, 0))); }
+template<glm::length_t D> static void fast_cross(lua_State *L, StkId func) { FAST_SETVEC(L, func, glm::cross(FAST_VEC(func, 0), FAST_VEC(func, 1))); }
+template<glm::length_t D> static void fast_clamp(lua_State *L, StkId func) { FAST_SETVEC(L, func, glm::clamp(FAST_VEC(func, 0), FAST_VEC(func, 1), FAST_VEC(func, 2))); }
+template<glm::length_t D> static void fast_clampn(lua_State *L, StkId func) { FAST_SETVEC(L, func, glm::clamp(FAST_VEC(func, 0), FAST_NUM(func, 1), FAST_NUM(func, 2))); }
+template<glm::length_t D> static void fast_mix(lua_State *L, StkId func) { FAST_SETVEC(L, func, glm::mix(FAST_VEC(func, 0), FAST_VEC(func, 1), FAST_VEC(func, 2))); }
+template<glm::length_t D> static void fast_mixn(lua_State *L, StkId func) { FAST_SETVEC(L, func, glm::mix(FAST_VEC(func, 0), FAST_VEC(func, 1), FAST_NUM(func, 2))); }
+
+/* Argument signatures (GLM_SIG* packs tags as luaV_sigarg does) */
+#define FAST_SIG_V(V) static_cast<unsigned>(V)
+#define FAST_SIG_VV(V) GLM_SIG2(V, V)
+#define FAST_SIG_VVV(V) GLM_SIG3(V, V, V)
+#define FAST_SIG_VVN(V) GLM_SIG3(V, V, LUA_VNUMFLT)
+#define FAST_SIG_VNN(V) GLM_SIG3(V, LUA_VNUMFLT, LUA_VNUMFLT)
+
+/* Register a fast function for each vector dimension */
+#define FAST_REG(NAME, NARGS, SIG, F)                \
+  { GLM_NAME(NAME), NARGS, SIG(LUA_VVECTOR2), F<2> }, \
+  { GLM_NAME(NAME), NARGS, SIG(LUA_VVECTOR3), F<3> }, \
+  { GLM_NAME(NAME), NARGS, SIG(LUA_VVECTOR4), F<4> }
+
+static const struct {
+  lua_CFunction func;
+  int nargs;
+  unsigned sig;
+  FastFunction fast;
+} luaglm_fastcalls[] = {
+#if defined(GEOMETRIC_HPP) || defined(EXT_QUATERNION_GEOMETRIC_HPP)
+  FAST_REG(dot, 2, FAST_SIG_VV, fast_dot),
+  FAST_REG(length, 1, FAST_SIG_V, fast_length),
+  FAST_REG(normalize, 1, FAST_SIG_V, fast_normalize),
+#endif
+#if defined(GEOMETRIC_HPP)
+  FAST_REG(distance, 2, FAST_SIG_VV, fast_distance),
+#endif
+#if defined(EXPONENTIAL_HPP) || defined(GTX_EXTERIOR_PRODUCT_HPP) || defined(EXT_QUATERNION_GEOMETRIC_HPP)
+  { GLM_NAME(cross), 2, FAST_SIG_VV(LUA_VVECTOR3), fast_cross<3> },
+#endif
+#if defined(COMMON_HPP) || defined(EXT_SCALAR_COMMON_HPP) || defined(EXT_VECTOR_COMMON_HPP)
+  FAST_REG(clamp, 3, FAST_SIG_VVV, fast_clamp),
+  FAST_REG(clamp, 3, FAST_SIG_VNN, fast_clampn),
+#endif
+#if defined(COMMON_HPP) || defined(EXT_MATRIX_COMMON_HPP)
+  FAST_REG(mix, 3, FAST_SIG_VVV, fast_mix),
+  FAST_REG(mix, 3, FAST_SIG_VVN, fast_mixn),
+#endif
+  { GLM_NULLPTR, 0, 0, GLM_NULLPTR }
+};
+#endif
+
 extern "C" {
   LUAMOD_API int luaopen_glm(lua_State *L) {
     luaL_newlib(L, luaglm_lib);  // Initialize GLM library
+#if defined(LUAGLM_EXT_FASTCALL)
+    for (size_t i = 0; luaglm_fastcalls[i].func != GLM_NULLPTR; ++i)
+      luaV_setfastcall(L, luaglm_fastcalls[i].func, luaglm_fastcalls[i].nargs, luaglm_fastcalls[i].sig, luaglm_fastcalls[i].fast);
+#endif
+    // The "orderedlist" API doubles as the ordered list metatable and, as with
+    // orderedlist.lua, is callable.
+    if (luaL_newmetatable(L, LUAGLM_ORDEREDLIST_META)) {
+      luaL_setfuncs(L, luaglm_orderedlistlib, 0);
+      lua_pushvalue(L, -1);
+      lua_setfield(L, -2, "__index");
+      lua_createtable(L, 0, 1);
+      lua_pushcfunction(L, GLM_NAME(orderedlist_call));
+      lua_setfield(L, -2, "__call");
+      lua_setmetatable(L, -2);
+    }
+    lua_setfield(L, -2, "orderedlist");
 #if defined(LUAGLM_INCLUDE_GEOM)
     luaL_newlib(L, luaglm_aabblib); lua_setfield(L, -2, "aabb");
     luaL_newlib(L, luaglm_linelib); lua_setfield(L, -2, "line");
@@ -232,6 +323,16 @@ extern "C" {
     luaL_newlib(L, luaglm_circlelib); lua_setfield(L, -2, "circle");
     // The "polygon" API doubles as the polygon metatable stored in the registry.
     glm_newmetatable(L, gLuaPolygon<>::Metatable(), "polygon", luaglm_polylib);
+    // Similarly, the "spatial" API doubles as the BVH/Octree metatable.
+    glm_newmetatable(L, LUAGLM_SPATIAL_META, "spatial", luaglm_spatiallib);
+    if (luaL_getmetatable(L, LUAGLM_SPATIAL_META) == LUA_TTABLE) {
+      lua_pushvalue(L, -1);
+      lua_setfield(L, -2, "__index");
+    }
+    lua_pop(L, 1);
+#endif
+#if defined(LUAGLM_EXT_BLOB)
+    luaL_newlib(L, luaglm_batchlib); lua_setfield(L, -2, "batch");
 #endif
 #if defined(CONSTANTS_HPP) || defined(EXT_SCALAR_CONSTANTS_HPP)
   #if GLM_VERSION >= 997  // @COMPAT: Added in 0.9.9.7
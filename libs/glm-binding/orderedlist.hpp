@@ -0,0 +1,480 @@
+/*
+** $Id: orderedlist.hpp $
+** Native ordered lists: bounded collections of <item, score> pairs.
+**
+** An ordered list is a plain Lua table whose array part, [1, #list], stores the
+** items of the list. Length and integer indexing are therefore raw table
+** accesses, i.e., without metamethods. The scores of each item, the size bound
+** of the list, and its ordering are stored in a userdata referenced by the
+** table through a private light-userdata key:
+**
+**  Sorted - Items are sorted by ascending score (binary insertion). A bounded
+**    list keeps the 'maxSize' lowest scores; items tied with the worst score
+**    expand the list instead of being arbitrarily discarded. This mirrors, and
+**    can replace, libs/scripts/spatial/orderedlist.lua.
+**
+**  Heap - A binary min- or max-heap: O(log n) insertion and removal of the root.
+**    A bounded heap keeps the 'maxSize' best items: a bounded max-heap retains
+**    the lowest scores (its root is the worst retained score, e.g., a k-nearest
+**    neighbor query) and a bounded min-heap the highest.
+**
+** Items are not deduplicated and lists should only be modified through their
+** methods.
+**
+** See Copyright Notice in lua.h
+*/
+#ifndef BINDING_ORDEREDLIST_HPP
+#define BINDING_ORDEREDLIST_HPP
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <new>
+
+#include "lua.hpp"
+#include "bindings.hpp"
+
+/* Ordered list metatable stored in the registry */
+#define LUAGLM_ORDEREDLIST_META "GLM_ORDEREDLIST"
+
+/*
+@@ LUAGLM_ORDEREDLIST_INLINE Maximum number of scores stored inline, within the
+** state userdata of an ordered list, before being moved to a separate block.
+*/
+#if !defined(LUAGLM_ORDEREDLIST_INLINE)
+  #define LUAGLM_ORDEREDLIST_INLINE 32
+#endif
+
+/* Default size bound of an ordered list (see orderedlist.lua) */
+#define ORDEREDLIST_MAXSIZE (static_cast<lua_Integer>(1) << 31)
+
+/*
+** {==================================================================
+** Ordered List
+** ===================================================================
+*/
+
+/* Key of the state userdata within an ordered list table */
+static const char glm_orderedlistkey = 0;
+
+/// <summary>
+/// State of an ordered list. The state userdata has one user value: the block
+/// of scores once the inline storage (immediately following the struct) has
+/// been exceeded.
+/// </summary>
+struct gLuaOrderedList {
+  enum Kind {
+    Sorted,
+    MinHeap,
+    MaxHeap,
+  };
+
+  lua_Number *scores;
+  lua_Integer count;
+  lua_Integer capacity;
+  lua_Integer maxSize;
+  int kind;
+
+  static size_t bytes(lua_Integer n) {
+    return sizeof(gLuaOrderedList) + static_cast<size_t>(n) * sizeof(lua_Number);
+  }
+
+  lua_Number *inlined() {
+    return reinterpret_cast<lua_Number *>(this + 1);
+  }
+
+  /// <summary>
+  /// Heap ordering: true if a score of 'a' belongs above a score of 'b'.
+  /// </summary>
+  bool before(lua_Number a, lua_Number b) const {
+    return kind == MaxHeap ? b < a : a < b;
+  }
+
+  /// <summary>
+  /// Score of the item evicted next by a bounded insertion.
+  /// </summary>
+  lua_Number worst() const {
+    return kind == Sorted ? scores[count - 1] : scores[0];
+  }
+};
+
+/// <summary>
+/// Return the state of the ordered list at the given stack index; NULL if the
+/// value is not an ordered list.
+/// </summary>
+static gLuaOrderedList *glm_testorderedlist(lua_State *L, int idx) {
+  gLuaOrderedList *list = GLM_NULLPTR;
+  if (lua_istable(L, idx)) {
+    if (lua_rawgetp(L, idx, &glm_orderedlistkey) == LUA_TUSERDATA)
+      list = static_cast<gLuaOrderedList *>(lua_touserdata(L, -1));
+    lua_pop(L, 1);
+  }
+  return list;
+}
+
+static gLuaOrderedList *glm_toorderedlist(lua_State *L, int idx) {
+  gLuaOrderedList *list = glm_testorderedlist(L, idx);
+  if (l_unlikely(list == GLM_NULLPTR))
+    luaL_typeerror(L, idx, "orderedlist");
+  return list;
+}
+
+/// <summary>
+/// Ensure the list can store at least 'n' scores. The previous block, if any,
+/// is released by replacing the user value of the state.
+/// </summary>
+static void glm_orderedlistreserve(lua_State *L, int idx, gLuaOrderedList *list, lua_Integer n) {
+  if (l_likely(n <= list->capacity))
+    return;
+
+  const lua_Integer capacity = std::max(n, list->capacity + (list->capacity >> 1));
+  lua_rawgetp(L, idx, &glm_orderedlistkey);  // [..., state]
+  lua_Number *scores = static_cast<lua_Number *>(lua_newuserdatauv(L, static_cast<size_t>(capacity) * sizeof(lua_Number), 0));
+  std::memcpy(scores, list->scores, static_cast<size_t>(list->count) * sizeof(lua_Number));
+  lua_setiuservalue(L, -2, 1);
+  lua_pop(L, 1);
+  list->scores = scores;
+  list->capacity = capacity;
+}
+
+/// <summary>
+/// Create a new ordered list and push it onto the stack.
+/// </summary>
+static gLuaOrderedList *glm_neworderedlist(lua_State *L, int kind, lua_Integer maxSize) {
+  const lua_Integer capacity = std::min<lua_Integer>(std::max<lua_Integer>(maxSize, 1), LUAGLM_ORDEREDLIST_INLINE);
+  lua_createtable(L, static_cast<int>(capacity), 1);  // [..., list]
+  void *ptr = lua_newuserdatauv(L, gLuaOrderedList::bytes(capacity), 1);  // [..., list, state]
+  gLuaOrderedList *list = ::new (ptr) gLuaOrderedList();
+  list->scores = list->inlined();
+  list->count = 0;
+  list->capacity = capacity;
+  list->maxSize = maxSize;
+  list->kind = kind;
+  lua_rawsetp(L, -2, &glm_orderedlistkey);
+  luaL_setmetatable(L, LUAGLM_ORDEREDLIST_META);
+  return list;
+}
+
+/// <summary>
+/// Move the heap item at position 'i' into the hole at position 'hole'.
+/// </summary>
+static void glm_orderedlistmove(lua_State *L, int idx, gLuaOrderedList *list, lua_Integer hole, lua_Integer i) {
+  list->scores[hole] = list->scores[i];
+  lua_rawgeti(L, idx, i + 1);
+  lua_rawseti(L, idx, hole + 1);
+}
+
+/// <summary>
+/// Place the item on top of the stack, with the given score, into the heap hole
+/// at position 'i' (popping the item); moving parents down.
+/// </summary>
+static void glm_orderedlistsiftup(lua_State *L, int idx, gLuaOrderedList *list, lua_Integer i, lua_Number score) {
+  while (i > 0) {
+    const lua_Integer parent = (i - 1) >> 1;
+    if (!list->before(score, list->scores[parent]))
+      break;
+    glm_orderedlistmove(L, idx, list, i, parent);
+    i = parent;
+  }
+  list->scores[i] = score;
+  lua_rawseti(L, idx, i + 1);
+}
+
+/// <summary>
+/// Place the item on top of the stack, with the given score, into the heap hole
+/// at position 'i' (popping the item); moving children up.
+/// </summary>
+static void glm_orderedlistsiftdown(lua_State *L, int idx, gLuaOrderedList *list, lua_Integer i, lua_Number score) {
+  const lua_Integer n = list->count;
+  for (lua_Integer child = 2 * i + 1; child < n; child = 2 * i + 1) {
+    if (child + 1 < n && list->before(list->scores[child + 1], list->scores[child]))
+      child++;
+    if (!list->before(list->scores[child], score))
+      break;
+    glm_orderedlistmove(L, idx, list, i, child);
+    i = child;
+  }
+  list->scores[i] = score;
+  lua_rawseti(L, idx, i + 1);
+}
+
+/// <summary>
+/// Insert the item on top of the stack into the sorted list at position 'i'
+/// (popping the item).
+/// </summary>
+static void glm_orderedlistplace(lua_State *L, int idx, gLuaOrderedList *list, lua_Integer i, lua_Number score) {
+  glm_orderedlistreserve(L, idx, list, list->count + 1);
+  for (lua_Integer j = list->count; j > i; --j) {
+    lua_rawgeti(L, idx, j);
+    lua_rawseti(L, idx, j + 1);
+  }
+  std::memmove(list->scores + i + 1, list->scores + i, static_cast<size_t>(list->count - i) * sizeof(lua_Number));
+  list->scores[i] = score;
+  list->count++;
+  lua_rawseti(L, idx, i + 1);
+}
+
+/// <summary>
+/// Insert the item on top of the stack, with the given score, into the ordered
+/// list at the given stack index (popping the item). Returns false if the item
+/// falls outside the bounds of the list and was discarded.
+/// </summary>
+static bool glm_orderedlistinsert(lua_State *L, int idx, gLuaOrderedList *list, lua_Number score) {
+  const lua_Integer n = list->count;
+  if (list->kind != gLuaOrderedList::Sorted) {
+    if (n < list->maxSize) {
+      glm_orderedlistreserve(L, idx, list, n + 1);
+      list->count++;
+      glm_orderedlistsiftup(L, idx, list, n, score);
+      return true;
+    }
+    else if (n > 0 && list->before(list->scores[0], score)) {
+      glm_orderedlistsiftdown(L, idx, list, 0, score);  // Replace the root.
+      return true;
+    }
+  }
+  else if (list->maxSize > 0) {
+    const lua_Number worst = n > 0 ? list->scores[n - 1] : HUGE_VAL;
+    if (n < list->maxSize || score < worst) {
+      const lua_Integer i = static_cast<lua_Integer>(std::upper_bound(list->scores, list->scores + n, score) - list->scores);
+      glm_orderedlistplace(L, idx, list, i, score);
+
+      // Trim all items that fall outside of maxSize and are not tied with the
+      // new worst score.
+      if (n >= list->maxSize) {
+        const lua_Number largest = list->scores[list->maxSize - 1];
+        while (list->count > list->maxSize && list->scores[list->count - 1] > largest) {
+          lua_pushnil(L);
+          lua_rawseti(L, idx, list->count--);
+        }
+      }
+      return true;
+    }
+    // Equal to the worst score: instead of arbitrarily breaking ties, simply
+    // expand the list.
+    else if (score == worst) {
+      glm_orderedlistplace(L, idx, list, n, score);
+      return true;
+    }
+  }
+  lua_pop(L, 1);
+  return false;
+}
+
+/* }================================================================== */
+
+/*
+** {==================================================================
+** Ordered List API
+** ===================================================================
+*/
+
+static lua_Integer glm_orderedlistmaxsize(lua_State *L, int idx, lua_Integer def) {
+  const lua_Integer maxSize = luaL_optinteger(L, idx, def);
+  luaL_argcheck(L, maxSize >= 0, idx, "invalid maximum size");
+  return maxSize;
+}
+
+/// <summary>
+/// orderedlist.new([maxSize]): Create a new sorted list; see OrderedList.New.
+/// </summary>
+GLM_BINDING_QUALIFIER(orderedlist_new) {
+  glm_neworderedlist(L, gLuaOrderedList::Sorted, glm_orderedlistmaxsize(L, 1, ORDEREDLIST_MAXSIZE));
+  return 1;
+}
+
+/// <summary>
+/// orderedlist.heap([maxSize [, max]]): Create a new binary min-heap, or a
+/// max-heap when 'max' is true.
+/// </summary>
+GLM_BINDING_QUALIFIER(orderedlist_heap) {
+  const lua_Integer maxSize = glm_orderedlistmaxsize(L, 1, ORDEREDLIST_MAXSIZE);
+  glm_neworderedlist(L, lua_toboolean(L, 2) ? gLuaOrderedList::MaxHeap : gLuaOrderedList::MinHeap, maxSize);
+  return 1;
+}
+
+/// <summary>
+/// orderedlist(...): orderedlist.new(...)
+/// </summary>
+GLM_BINDING_QUALIFIER(orderedlist_call) {
+  lua_remove(L, 1);
+  return GLM_NAME(orderedlist_new)(L);
+}
+
+/// <summary>
+/// orderedlist:Clear([maxSize]): Remove all items from the list, potentially
+/// changing its maximum size.
+/// </summary>
+GLM_BINDING_QUALIFIER(orderedlist_Clear) {
+  gLuaOrderedList *list = glm_toorderedlist(L, 1);
+  list->maxSize = glm_orderedlistmaxsize(L, 2, list->maxSize);
+  lua_settop(L, 1);
+  for (; list->count > 0; list->count--) {
+    lua_pushnil(L);
+    lua_rawseti(L, 1, list->count);
+  }
+  return 1;
+}
+
+/// <summary>
+/// orderedlist:GetMaximumSize(): the maximum size of the list. However, sorted
+/// lists may overflow when multiple items have the same "worst" score.
+/// </summary>
+GLM_BINDING_QUALIFIER(orderedlist_GetMaximumSize) {
+  lua_pushinteger(L, glm_toorderedlist(L, 1)->maxSize);
+  return 1;
+}
+
+GLM_BINDING_QUALIFIER(orderedlist_Size) {
+  lua_pushinteger(L, glm_toorderedlist(L, 1)->count);
+  return 1;
+}
+
+/// <summary>
+/// orderedlist:Get(i): the i^{th} item of the list and its score.
+/// </summary>
+GLM_BINDING_QUALIFIER(orderedlist_Get) {
+  const gLuaOrderedList *list = glm_toorderedlist(L, 1);
+  const lua_Integer i = luaL_checkinteger(L, 2);
+  if (i < 1 || i > list->count)
+    return 0;
+
+  lua_rawgeti(L, 1, i);
+  lua_pushnumber(L, list->scores[i - 1]);
+  return 2;
+}
+
+/// <summary>
+/// orderedlist:Score(item): the score of an item; a linear search.
+/// </summary>
+GLM_BINDING_QUALIFIER(orderedlist_Score) {
+  const gLuaOrderedList *list = glm_toorderedlist(L, 1);
+  luaL_checkany(L, 2);
+  for (lua_Integer i = 1; i <= list->count; ++i) {
+    lua_rawgeti(L, 1, i);
+    if (lua_rawequal(L, 2, -1)) {
+      lua_pushnumber(L, list->scores[i - 1]);
+      return 1;
+    }
+    lua_pop(L, 1);
+  }
+  return 0;
+}
+
+/// <summary>
+/// orderedlist:GetWorstDistance(): the score of the item evicted next by a
+/// bounded insertion, i.e., the last item of a sorted list or the root of a
+/// heap.
+/// </summary>
+GLM_BINDING_QUALIFIER(orderedlist_GetWorstDistance) {
+  const gLuaOrderedList *list = glm_toorderedlist(L, 1);
+  if (list->count == 0)
+    return 0;
+
+  lua_pushnumber(L, list->worst());
+  return 1;
+}
+
+/// <summary>
+/// orderedlist:Insert(item, score): Insert an <item, score> pair into the list.
+/// </summary>
+GLM_BINDING_QUALIFIER(orderedlist_Insert) {
+  gLuaOrderedList *list = glm_toorderedlist(L, 1);
+  luaL_argexpected(L, !lua_isnoneornil(L, 2), 2, "non-nil value");
+  const lua_Number score = luaL_checknumber(L, 3);
+  lua_settop(L, 2);
+  glm_orderedlistinsert(L, 1, list, score);
+  return 1;
+}
+
+/// <summary>
+/// orderedlist:Peek(): the first item of the list (the root of a heap) and its
+/// score.
+/// </summary>
+GLM_BINDING_QUALIFIER(orderedlist_Peek) {
+  const gLuaOrderedList *list = glm_toorderedlist(L, 1);
+  if (list->count == 0)
+    return 0;
+
+  lua_rawgeti(L, 1, 1);
+  lua_pushnumber(L, list->scores[0]);
+  return 2;
+}
+
+/// <summary>
+/// orderedlist:Pop(): Remove and return the first item of the list (the root of
+/// a heap) and its score.
+/// </summary>
+GLM_BINDING_QUALIFIER(orderedlist_Pop) {
+  gLuaOrderedList *list = glm_toorderedlist(L, 1);
+  const lua_Integer n = list->count;
+  if (n == 0)
+    return 0;
+
+  lua_settop(L, 1);
+  lua_rawgeti(L, 1, 1);  // [list, item]
+  lua_pushnumber(L, list->scores[0]);  // [list, item, score]
+  if (list->kind == gLuaOrderedList::Sorted) {
+    for (lua_Integer i = 1; i < n; ++i) {
+      lua_rawgeti(L, 1, i + 1);
+      lua_rawseti(L, 1, i);
+    }
+    std::memmove(list->scores, list->scores + 1, static_cast<size_t>(n - 1) * sizeof(lua_Number));
+    list->count--;
+  }
+  else {
+    lua_rawgeti(L, 1, n);  // [list, item, score, last]
+    list->count--;
+    if (n > 1)
+      glm_orderedlistsiftdown(L, 1, list, 0, list->scores[n - 1]);
+    else
+      lua_pop(L, 1);
+  }
+  lua_pushnil(L);
+  lua_rawseti(L, 1, n);
+  return 2;
+}
+
+/// <summary>
+/// Iterator of __pairs: ipairs over the items of the list.
+/// </summary>
+GLM_BINDING_QUALIFIER(orderedlist_next) {
+  const gLuaOrderedList *list = glm_toorderedlist(L, 1);
+  const lua_Integer i = luaL_checkinteger(L, 2) + 1;
+  if (i > list->count)
+    return 0;
+
+  lua_pushinteger(L, i);
+  lua_rawgeti(L, 1, i);
+  return 2;
+}
+
+GLM_BINDING_QUALIFIER(orderedlist_pairs) {
+  glm_toorderedlist(L, 1);
+  lua_pushcfunction(L, GLM_NAME(orderedlist_next));
+  lua_pushvalue(L, 1);
+  lua_pushinteger(L, 0);
+  return 3;
+}
+
+static const luaL_Reg luaglm_orderedlistlib[] = {
+  { "__pairs", GLM_NAME(orderedlist_pairs) },
+  { "new", GLM_NAME(orderedlist_new) },
+  { "heap", GLM_NAME(orderedlist_heap) },
+  { "New", GLM_NAME(orderedlist_new) },
+  { "Clear", GLM_NAME(orderedlist_Clear) },
+  { "GetMaximumSize", GLM_NAME(orderedlist_GetMaximumSize) },
+  { "Size", GLM_NAME(orderedlist_Size) },
+  { "Get", GLM_NAME(orderedlist_Get) },
+  { "Score", GLM_NAME(orderedlist_Score) },
+  { "GetWorstDistance", GLM_NAME(orderedlist_GetWorstDistance) },
+  { "Insert", GLM_NAME(orderedlist_Insert) },
+  { "Push", GLM_NAME(orderedlist_Insert) },
+  { "Peek", GLM_NAME(orderedlist_Peek) },
+  { "Pop", GLM_NAME(orderedlist_Pop) },
+  { GLM_NULLPTR, GLM_NULLPTR }
+};
+
+/* }================================================================== */
+
+#endif
@@ -0,0 +1,1300 @@
+/*
+** $Id: spatial.hpp $
+** Native spatial indices: a bounding volume hierarchy (BVH) and a loose octree.
+**
+** Both indices implement the interface shared by the scripted KDTree/Octree in
+** libs/scripts/spatial (see notes.txt) and can be used as drop-in replacements.
+** Objects, any non-nil Lua value, are mapped to 'slots' through the uservalues of
+** the index userdata. All per-slot and per-node data is stored in flat arrays
+** allocated by the lua_Alloc of the state:
+**
+**  BVH - A binned surface-area-heuristic (SAH) hierarchy. Nodes are stored in
+**    depth-first order: the left child of an interior node immediately follows
+**    it. Insertions are appended to a 'pending' list that is linearly scanned;
+**    removals are tombstoned. The hierarchy is lazily rebuilt once the number of
+**    pending/removed objects exceeds a fraction of the index.
+**
+**  Octree - A loose octree with eight contiguous children per node and an
+**    intrusive, doubly-linked, object list per node. Objects that do not fit
+**    within the root are kept in the root until the next Rebuild, which
+**    re-centers the root on the bounds of the index.
+**
+** See Copyright Notice in lua.h
+*/
+#ifndef BINDING_SPATIAL_HPP
+#define BINDING_SPATIAL_HPP
+
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+
+#include "lua.hpp"
+#include "lglm.hpp"
+
+#include "allocator.hpp"
+#include "bindings.hpp"
+#include "orderedlist.hpp"
+
+#include "ext/geom/setup.hpp"
+#include "ext/geom/aabb.hpp"
+#include "ext/geom/ray.hpp"
+#include "ext/geom/sphere.hpp"
+
+/* Spatial index metatable stored in the registry */
+#define LUAGLM_SPATIAL_META "GLM_SPATIAL"
+
+/*
+@@ LUAGLM_SPATIAL_BINS Number of bins evaluated per axis when building a BVH.
+*/
+#if !defined(LUAGLM_SPATIAL_BINS)
+  #define LUAGLM_SPATIAL_BINS 16
+#endif
+
+/*
+@@ LUAGLM_SPATIAL_DEPTH Maximum depth of either index; also bounds the size of
+** the (stack allocated) traversal stack.
+*/
+#if !defined(LUAGLM_SPATIAL_DEPTH)
+  #define LUAGLM_SPATIAL_DEPTH 32
+#endif
+
+#define SPATIAL_STACK (8 * LUAGLM_SPATIAL_DEPTH + 8)
+#define SPATIAL_NONE (std::numeric_limits<uint32_t>::max())
+
+/* Component type of all spatial indices (independent of glm_Float) */
+using gSpatialFloat = float;
+using gSpatialPoint = glm::vec<3, gSpatialFloat, glm::defaultp>;
+using gSpatialAABB = glm::AABB<3, gSpatialFloat, glm::defaultp>;
+using gSpatialRay = glm::Ray<3, gSpatialFloat, glm::defaultp>;
+using gSpatialSphere = glm::Sphere<3, gSpatialFloat, glm::defaultp>;
+
+/*
+** {==================================================================
+** Index
+** ===================================================================
+*/
+
+/// <summary>
+/// BVH node: an interior node when count == 0; the left child is the next node
+/// and 'first' is the index of the right child. Otherwise, a leaf referencing
+/// 'count' elements of the object order starting at 'first'.
+/// </summary>
+struct gSpatialNode {
+  gSpatialAABB box;
+  uint32_t first;
+  uint32_t count;
+};
+
+/// <summary>
+/// Octree node: 'children' is the index of the first of eight contiguous
+/// children (zero for leaves, as the root cannot be a child) and 'head' is the
+/// first object of the node's object list.
+/// </summary>
+struct gOctreeNode {
+  gSpatialPoint center;
+  gSpatialFloat half;  // Half axis length of the (tight) node bounds.
+  uint32_t children;
+  uint32_t head;
+  uint32_t count;
+};
+
+/// <summary>
+/// Nearest-neighbor candidate.
+/// </summary>
+struct gSpatialNeighbor {
+  gSpatialFloat dist2;
+  uint32_t slot;
+
+  bool operator<(const gSpatialNeighbor &other) const {
+    return dist2 < other.dist2;
+  }
+};
+
+template<class T>
+static LuaVector<T> glm_spatiallist(lua_State *L) {
+  LuaCrtAllocator<T> allocator(L);
+  return LuaVector<T>(L, allocator);
+}
+
+/// <summary>
+/// Return true if the bounds are 'empty', i.e., the slot is unused.
+/// </summary>
+static LUA_INLINE bool glm_spatialempty(const gSpatialAABB &b) {
+  return b.minPoint.x > b.maxPoint.x;
+}
+
+/// <summary>
+/// Squared distance between a point and AABB; zero if the point is contained.
+/// </summary>
+static LUA_INLINE gSpatialFloat glm_spatialdist2(const gSpatialAABB &b, const gSpatialPoint &p) {
+  return glm::distance2(glm::closestPoint(b, p), p);
+}
+
+/// <summary>
+/// Userdata of a BVH/Octree index.
+/// </summary>
+struct gLuaSpatial {
+  enum Kind {
+    None = 0,
+    BVH,
+    Octree,
+  };
+
+  int kind;
+  bool immutable;
+  uint32_t count;  // Number of indexed objects.
+  uint32_t leafSize;
+
+  LuaVector<gSpatialAABB> bounds;  // Object bounds by slot; empty if unused.
+  LuaVector<uint32_t> available;  // Slots that can be reused.
+
+  /* BVH */
+  LuaVector<gSpatialNode> nodes;
+  LuaVector<uint32_t> order;  // Leaf object ranges.
+  LuaVector<uint32_t> pending;  // Slots inserted since the last build.
+  LuaVector<uint32_t> dead;  // Slots removed since the last build.
+
+  /* Octree */
+  LuaVector<gOctreeNode> octnodes;
+  LuaVector<uint32_t> next;  // Object lists by slot.
+  LuaVector<uint32_t> prev;
+  LuaVector<uint32_t> owner;
+  gSpatialPoint center;  // Initial/current root center.
+  gSpatialFloat length;  // Initial/current root axis length.
+  gSpatialFloat minSize;
+  gSpatialFloat looseness;
+  uint32_t outside;  // Objects in the root that are not contained by it.
+
+  /* Nearest-neighbor scratch */
+  LuaVector<gSpatialNeighbor> neighbors;
+
+  gLuaSpatial(lua_State *L, int kind_, uint32_t leafSize_)
+    : kind(kind_), immutable(false), count(0), leafSize(leafSize_),
+      bounds(glm_spatiallist<gSpatialAABB>(L)),
+      available(glm_spatiallist<uint32_t>(L)),
+      nodes(glm_spatiallist<gSpatialNode>(L)),
+      order(glm_spatiallist<uint32_t>(L)),
+      pending(glm_spatiallist<uint32_t>(L)),
+      dead(glm_spatiallist<uint32_t>(L)),
+      octnodes(glm_spatiallist<gOctreeNode>(L)),
+      next(glm_spatiallist<uint32_t>(L)),
+      prev(glm_spatiallist<uint32_t>(L)),
+      owner(glm_spatiallist<uint32_t>(L)),
+      center(0), length(1), minSize(1), looseness(1), outside(0),
+      neighbors(glm_spatiallist<gSpatialNeighbor>(L)) {
+  }
+
+  /// <summary>
+  /// Update the lua_State (and allocator) of each list; see LuaVector::validate.
+  /// </summary>
+  void validate(lua_State *L) {
+    bounds.validate(L);
+    available.validate(L);
+    nodes.validate(L);
+    order.validate(L);
+    pending.validate(L);
+    dead.validate(L);
+    octnodes.validate(L);
+    next.validate(L);
+    prev.validate(L);
+    owner.validate(L);
+    neighbors.validate(L);
+  }
+
+  void compact() {
+    bounds.shrink_to_fit();
+    available.shrink_to_fit();
+    nodes.shrink_to_fit();
+    order.shrink_to_fit();
+    pending.shrink_to_fit();
+    dead.shrink_to_fit();
+    octnodes.shrink_to_fit();
+    next.shrink_to_fit();
+    prev.shrink_to_fit();
+    owner.shrink_to_fit();
+    neighbors.shrink_to_fit();
+  }
+
+  /// <summary>
+  /// Number of bytes allocated by the index (excluding the slot mapping tables).
+  /// </summary>
+  size_t memory() const {
+    return sizeof(gLuaSpatial)
+           + bounds.capacity() * sizeof(gSpatialAABB)
+           + nodes.capacity() * sizeof(gSpatialNode)
+           + octnodes.capacity() * sizeof(gOctreeNode)
+           + neighbors.capacity() * sizeof(gSpatialNeighbor)
+           + (available.capacity() + order.capacity() + pending.capacity() + dead.capacity()
+              + next.capacity() + prev.capacity() + owner.capacity())
+               * sizeof(uint32_t);
+  }
+
+  /// <summary>
+  /// Remove all objects and structure.
+  /// </summary>
+  void clear() {
+    count = 0;
+    outside = 0;
+    bounds.clear();
+    available.clear();
+    nodes.clear();
+    order.clear();
+    pending.clear();
+    dead.clear();
+    octnodes.clear();
+    next.clear();
+    prev.clear();
+    owner.clear();
+    neighbors.clear();
+    if (kind == Octree) {
+      octreeReset(center, length);
+    }
+  }
+
+  /// <summary>
+  /// Allocate a slot for an object with the given bounds.
+  /// </summary>
+  uint32_t insert(const gSpatialAABB &box) {
+    uint32_t slot;
+    if (!available.empty()) {
+      slot = available.back();
+      available.pop_back();
+      bounds[slot] = box;
+    }
+    else {
+      slot = static_cast<uint32_t>(bounds.size());
+      bounds.push_back(box);
+      if (kind == Octree) {
+        next.push_back(SPATIAL_NONE);
+        prev.push_back(SPATIAL_NONE);
+        owner.push_back(SPATIAL_NONE);
+      }
+    }
+
+    count++;
+    if (kind == BVH)
+      pending.push_back(slot);
+    else
+      octreeInsert(slot);
+    return slot;
+  }
+
+  /// <summary>
+  /// Release a slot.
+  /// </summary>
+  void remove(uint32_t slot) {
+    count--;
+    if (kind == BVH) {
+      dead.push_back(slot);  // Still referenced by the hierarchy until rebuilt.
+    }
+    else {
+      octreeUnlink(slot);
+      available.push_back(slot);
+    }
+    bounds[slot].setNegativeInfinity();
+  }
+
+  /// <summary>
+  /// Rebuild the index from all of its objects.
+  /// </summary>
+  void rebuild() {
+    if (kind == BVH)
+      bvhBuild();
+    else
+      octreeBuild();
+  }
+
+  /// <summary>
+  /// Lazily rebuild the index prior to a query.
+  /// </summary>
+  void prepare() {
+    if (kind == BVH) {
+      const size_t threshold = std::max<size_t>(static_cast<size_t>(leafSize) * 16, count >> 3);
+      if (pending.size() > threshold || dead.size() > (threshold << 1))
+        bvhBuild();
+    }
+    else if (outside > leafSize) {
+      octreeBuild();
+    }
+  }
+
+  /* Queries */
+
+  /// <summary>
+  /// Invoke 'emit(slot)' for each object that satisfies 'test(bounds)'; nodes
+  /// are culled with the same test.
+  /// </summary>
+  template<class Test, class Emit>
+  void query(const Test &test, Emit &emit) const {
+    uint32_t stack[SPATIAL_STACK];
+    size_t sp = 0;
+    if (kind == BVH) {
+      if (!nodes.empty())
+        stack[sp++] = 0;
+
+      while (sp > 0) {
+        const uint32_t index = stack[--sp];
+        const gSpatialNode &node = nodes[index];
+        if (!test(node.box))
+          continue;
+
+        if (node.count > 0) {
+          for (uint32_t i = node.first; i < node.first + node.count; ++i) {
+            const uint32_t slot = order[i];
+            const gSpatialAABB &box = bounds[slot];
+            if (!glm_spatialempty(box) && test(box))
+              emit(slot);
+          }
+        }
+        else {
+          stack[sp++] = node.first;
+          stack[sp++] = index + 1;
+        }
+      }
+
+      for (size_t i = 0; i < pending.size(); ++i) {
+        const uint32_t slot = pending[i];
+        const gSpatialAABB &box = bounds[slot];
+        if (!glm_spatialempty(box) && test(box))
+          emit(slot);
+      }
+    }
+    else if (!octnodes.empty()) {
+      stack[sp++] = 0;
+      while (sp > 0) {
+        const uint32_t index = stack[--sp];
+        const gOctreeNode &node = octnodes[index];
+        if (index != 0 && !test(octreeLoose(node)))  // The root may contain anything.
+          continue;
+
+        for (uint32_t slot = node.head; slot != SPATIAL_NONE; slot = next[slot]) {
+          if (test(bounds[slot]))
+            emit(slot);
+        }
+
+        if (node.children != 0) {
+          for (uint32_t c = 0; c < 8; ++c)
+            stack[sp++] = node.children + c;
+        }
+      }
+    }
+  }
+
+  /// <summary>
+  /// Populate 'neighbors' with the (at most) k-nearest objects to a point,
+  /// sorted by distance.
+  /// </summary>
+  void nearest(const gSpatialPoint &p, size_t k) {
+    neighbors.clear();
+    if (k == 0)
+      return;
+
+    uint32_t stack[SPATIAL_STACK];
+    size_t sp = 0;
+    if (kind == BVH) {
+      if (!nodes.empty())
+        stack[sp++] = 0;
+
+      while (sp > 0) {
+        const uint32_t index = stack[--sp];
+        const gSpatialNode &node = nodes[index];
+        if (neighbors.size() == k && glm_spatialdist2(node.box, p) > neighbors.front().dist2)
+          continue;
+
+        if (node.count > 0) {
+          for (uint32_t i = node.first; i < node.first + node.count; ++i)
+            nearestCandidate(p, order[i], k);
+        }
+        else {  // Visit the nearest child first.
+          const uint32_t left = index + 1;
+          const uint32_t right = node.first;
+          if (glm_spatialdist2(nodes[left].box, p) <= glm_spatialdist2(nodes[right].box, p)) {
+            stack[sp++] = right;
+            stack[sp++] = left;
+          }
+          else {
+            stack[sp++] = left;
+            stack[sp++] = right;
+          }
+        }
+      }
+
+      for (size_t i = 0; i < pending.size(); ++i)
+        nearestCandidate(p, pending[i], k);
+    }
+    else if (!octnodes.empty()) {
+      stack[sp++] = 0;
+      while (sp > 0) {
+        const uint32_t index = stack[--sp];
+        const gOctreeNode &node = octnodes[index];
+        if (index != 0 && neighbors.size() == k && glm_spatialdist2(octreeLoose(node), p) > neighbors.front().dist2)
+          continue;
+
+        for (uint32_t slot = node.head; slot != SPATIAL_NONE; slot = next[slot])
+          nearestCandidate(p, slot, k);
+
+        if (node.children != 0) {
+          const uint32_t c = octreeChild(node, p);  // Visit the containing child last (first).
+          for (uint32_t i = 0; i < 8; ++i) {
+            if (i != c)
+              stack[sp++] = node.children + i;
+          }
+          stack[sp++] = node.children + c;
+        }
+      }
+    }
+
+    std::sort_heap(neighbors.begin(), neighbors.end());
+  }
+
+  /* Statistics */
+
+  struct Statistics {
+    size_t nodes;
+    size_t leaves;
+    size_t depth;
+  };
+
+  Statistics statistics() const {
+    Statistics s = { 0, 0, 0 };
+    uint32_t stack[SPATIAL_STACK];
+    uint32_t depth[SPATIAL_STACK];
+    size_t sp = 0;
+    if (kind == BVH ? !nodes.empty() : !octnodes.empty()) {
+      stack[sp] = 0;
+      depth[sp++] = 1;
+    }
+
+    while (sp > 0) {
+      --sp;
+      const uint32_t index = stack[sp];
+      const uint32_t d = depth[sp];
+      s.nodes++;
+      s.depth = std::max<size_t>(s.depth, d);
+      if (kind == BVH) {
+        const gSpatialNode &node = nodes[index];
+        if (node.count > 0)
+          s.leaves++;
+        else {
+          stack[sp] = index + 1; depth[sp++] = d + 1;
+          stack[sp] = node.first; depth[sp++] = d + 1;
+        }
+      }
+      else {
+        const gOctreeNode &node = octnodes[index];
+        if (node.children == 0)
+          s.leaves++;
+        else {
+          for (uint32_t c = 0; c < 8; ++c) {
+            stack[sp] = node.children + c;
+            depth[sp++] = d + 1;
+          }
+        }
+      }
+    }
+    return s;
+  }
+
+private:
+  void nearestCandidate(const gSpatialPoint &p, uint32_t slot, size_t k) {
+    const gSpatialAABB &box = bounds[slot];
+    if (glm_spatialempty(box))
+      return;
+
+    const gSpatialNeighbor candidate = { glm_spatialdist2(box, p), slot };
+    if (neighbors.size() < k) {
+      neighbors.push_back(candidate);
+      std::push_heap(neighbors.begin(), neighbors.end());
+    }
+    else if (candidate.dist2 < neighbors.front().dist2) {
+      std::pop_heap(neighbors.begin(), neighbors.end());
+      neighbors.back() = candidate;
+      std::push_heap(neighbors.begin(), neighbors.end());
+    }
+  }
+
+  /* BVH */
+
+  struct Bin {
+    gSpatialAABB box;
+    uint32_t count;
+  };
+
+  static LUA_INLINE gSpatialPoint centroid(const gSpatialAABB &box) {
+    return (box.minPoint + box.maxPoint) * gSpatialFloat(0.5);
+  }
+
+  void bvhBuild() {
+    nodes.clear();
+    order.clear();
+    pending.clear();
+    for (size_t i = 0; i < dead.size(); ++i)  // Tombstones are no longer referenced.
+      available.push_back(dead[i]);
+    dead.clear();
+
+    for (size_t i = 0; i < bounds.size(); ++i) {
+      if (!glm_spatialempty(bounds[i]))
+        order.push_back(static_cast<uint32_t>(i));
+    }
+
+    if (!order.empty()) {
+      nodes.reserve(2 * (order.size() / std::max<uint32_t>(leafSize, 1)) + 1);
+      bvhBuildNode(0, static_cast<uint32_t>(order.size()), 1);
+    }
+  }
+
+  /// <summary>
+  /// Create the node for order[first, first + n) returning its index.
+  /// </summary>
+  uint32_t bvhBuildNode(uint32_t first, uint32_t n, uint32_t depth) {
+    gSpatialAABB box, cbox;
+    box.setNegativeInfinity();
+    cbox.setNegativeInfinity();
+    for (uint32_t i = first; i < first + n; ++i) {
+      const gSpatialAABB &b = bounds[order[i]];
+      box.enclose(b.minPoint);
+      box.enclose(b.maxPoint);
+      cbox.enclose(centroid(b));
+    }
+
+    const uint32_t index = static_cast<uint32_t>(nodes.size());
+    const gSpatialNode leaf = { box, first, n };
+    nodes.push_back(leaf);
+    if (n <= leafSize || depth >= LUAGLM_SPATIAL_DEPTH)
+      return index;
+
+    // Binned SAH: evaluate the cost of each bin boundary along each axis.
+    int bestAxis = -1;
+    uint32_t bestSplit = 0;
+    gSpatialFloat bestCost = std::numeric_limits<gSpatialFloat>::max();
+    for (glm::length_t axis = 0; axis < 3; ++axis) {
+      const gSpatialFloat extent = cbox.maxPoint[axis] - cbox.minPoint[axis];
+      if (extent <= gSpatialFloat(0))
+        continue;
+
+      Bin bins[LUAGLM_SPATIAL_BINS];
+      for (int b = 0; b < LUAGLM_SPATIAL_BINS; ++b) {
+        bins[b].box.setNegativeInfinity();
+        bins[b].count = 0;
+      }
+
+      const gSpatialFloat scale = gSpatialFloat(LUAGLM_SPATIAL_BINS) / extent;
+      for (uint32_t i = first; i < first + n; ++i) {
+        const gSpatialAABB &b = bounds[order[i]];
+        Bin &bin = bins[bvhBin(centroid(b)[axis], cbox.minPoint[axis], scale)];
+        bin.box.enclose(b.minPoint);
+        bin.box.enclose(b.maxPoint);
+        bin.count++;
+      }
+
+      gSpatialFloat leftArea[LUAGLM_SPATIAL_BINS - 1];
+      uint32_t leftCount[LUAGLM_SPATIAL_BINS - 1];
+      gSpatialAABB acc;
+      uint32_t total = 0;
+      acc.setNegativeInfinity();
+      for (int b = 0; b < LUAGLM_SPATIAL_BINS - 1; ++b) {
+        total += bins[b].count;
+        if (bins[b].count > 0) {
+          acc.enclose(bins[b].box.minPoint);
+          acc.enclose(bins[b].box.maxPoint);
+        }
+        leftCount[b] = total;
+        leftArea[b] = total > 0 ? glm::surfaceArea(acc) : gSpatialFloat(0);
+      }
+
+      total = 0;
+      acc.setNegativeInfinity();
+      for (int b = LUAGLM_SPATIAL_BINS - 1; b > 0; --b) {
+        total += bins[b].count;
+        if (bins[b].count > 0) {
+          acc.enclose(bins[b].box.minPoint);
+          acc.enclose(bins[b].box.maxPoint);
+        }
+
+        if (total > 0 && leftCount[b - 1] > 0) {
+          const gSpatialFloat cost = leftArea[b - 1] * gSpatialFloat(leftCount[b - 1]) + glm::surfaceArea(acc) * gSpatialFloat(total);
+          if (cost < bestCost) {
+            bestCost = cost;
+            bestAxis = static_cast<int>(axis);
+            bestSplit = static_cast<uint32_t>(b);
+          }
+        }
+      }
+    }
+
+    if (bestAxis < 0)  // All centroids are coincident.
+      return index;
+
+    const glm::length_t axis = static_cast<glm::length_t>(bestAxis);
+    const gSpatialFloat cmin = cbox.minPoint[axis];
+    const gSpatialFloat scale = gSpatialFloat(LUAGLM_SPATIAL_BINS) / (cbox.maxPoint[axis] - cmin);
+    uint32_t *mid = std::partition(order.begin() + first, order.begin() + first + n, [&](uint32_t slot) {
+      return bvhBin(centroid(bounds[slot])[axis], cmin, scale) < bestSplit;
+    });
+
+    const uint32_t leftCount = static_cast<uint32_t>(mid - (order.begin() + first));
+    if (leftCount == 0 || leftCount == n)
+      return index;
+
+    bvhBuildNode(first, leftCount, depth + 1);  // Left child is index + 1
+    const uint32_t right = bvhBuildNode(first + leftCount, n - leftCount, depth + 1);
+    nodes[index].first = right;
+    nodes[index].count = 0;
+    return index;
+  }
+
+  static LUA_INLINE uint32_t bvhBin(gSpatialFloat c, gSpatialFloat cmin, gSpatialFloat scale) {
+    const int b = static_cast<int>((c - cmin) * scale);
+    return static_cast<uint32_t>(glm::clamp(b, 0, LUAGLM_SPATIAL_BINS - 1));
+  }
+
+  /* Octree */
+
+  void octreeReset(const gSpatialPoint &c, gSpatialFloat len) {
+    const gOctreeNode root = { c, len * gSpatialFloat(0.5), 0, SPATIAL_NONE, 0 };
+    octnodes.clear();
+    octnodes.push_back(root);
+    outside = 0;
+  }
+
+  LUA_INLINE gSpatialAABB octreeLoose(const gOctreeNode &node) const {
+    const gSpatialPoint extent(node.half * looseness);
+    return gSpatialAABB(node.center - extent, node.center + extent);
+  }
+
+  static LUA_INLINE uint32_t octreeChild(const gOctreeNode &node, const gSpatialPoint &p) {
+    return (p.x >= node.center.x ? 1u : 0u) | (p.y >= node.center.y ? 2u : 0u) | (p.z >= node.center.z ? 4u : 0u);
+  }
+
+  /// <summary>
+  /// Return true if the node is allowed to subdivide; the minimum axis length
+  /// of a child is bounded by minSize and LUAGLM_SPATIAL_DEPTH.
+  /// </summary>
+  LUA_INLINE bool octreeCanSplit(const gOctreeNode &node) const {
+    const gSpatialFloat limit = octnodes[0].half * gSpatialFloat(2) / gSpatialFloat(1u << (LUAGLM_SPATIAL_DEPTH - 2));
+    return node.half >= minSize && node.half >= limit;
+  }
+
+  void octreeLink(uint32_t index, uint32_t slot) {
+    gOctreeNode &node = octnodes[index];
+    prev[slot] = SPATIAL_NONE;
+    next[slot] = node.head;
+    if (node.head != SPATIAL_NONE)
+      prev[node.head] = slot;
+    node.head = slot;
+    node.count++;
+    owner[slot] = index;
+  }
+
+  void octreeUnlink(uint32_t slot) {
+    gOctreeNode &node = octnodes[owner[slot]];
+    if (prev[slot] != SPATIAL_NONE)
+      next[prev[slot]] = next[slot];
+    else
+      node.head = next[slot];
+    if (next[slot] != SPATIAL_NONE)
+      prev[next[slot]] = prev[slot];
+    node.count--;
+    if (owner[slot] == 0 && !glm::contains(octreeLoose(node), bounds[slot]))
+      outside--;
+    owner[slot] = next[slot] = prev[slot] = SPATIAL_NONE;
+  }
+
+  /// <summary>
+  /// Subdivide a leaf and redistribute its objects to its children.
+  /// </summary>
+  void octreeSplit(uint32_t index) {
+    const uint32_t children = static_cast<uint32_t>(octnodes.size());
+    const gOctreeNode parent = octnodes[index];
+    const gSpatialFloat half = parent.half * gSpatialFloat(0.5);
+    for (uint32_t c = 0; c < 8; ++c) {
+      const gSpatialPoint offset((c & 1) ? half : -half, (c & 2) ? half : -half, (c & 4) ? half : -half);
+      const gOctreeNode child = { parent.center + offset, half, 0, SPATIAL_NONE, 0 };
+      octnodes.push_back(child);
+    }
+    octnodes[index].children = children;
+
+    uint32_t slot = parent.head;
+    while (slot != SPATIAL_NONE) {
+      const uint32_t nextSlot = next[slot];
+      const uint32_t child = children + octreeChild(parent, centroid(bounds[slot]));
+      if (glm::contains(octreeLoose(octnodes[child]), bounds[slot])) {
+        octreeUnlink(slot);
+        octreeLink(child, slot);
+      }
+      slot = nextSlot;
+    }
+  }
+
+  void octreeInsert(uint32_t slot) {
+    const gSpatialAABB &box = bounds[slot];
+    const gSpatialPoint c = centroid(box);
+
+    uint32_t index = 0;
+    for (;;) {
+      const gOctreeNode &node = octnodes[index];
+      if (node.children != 0) {
+        const uint32_t child = node.children + octreeChild(node, c);
+        if (!glm::contains(octreeLoose(octnodes[child]), box))
+          break;
+        index = child;
+      }
+      else if (node.count >= leafSize && octreeCanSplit(node)) {
+        octreeSplit(index);
+      }
+      else {
+        break;
+      }
+    }
+
+    if (index == 0 && !glm::contains(octreeLoose(octnodes[0]), box))
+      outside++;
+    octreeLink(index, slot);
+  }
+
+  /// <summary>
+  /// Re-center the root on the bounds of all objects and reinsert them.
+  /// </summary>
+  void octreeBuild() {
+    gSpatialAABB box;
+    box.setNegativeInfinity();
+    for (size_t i = 0; i < bounds.size(); ++i) {
+      const gSpatialAABB &b = bounds[i];
+      if (!glm_spatialempty(b)) {
+        box.enclose(b.minPoint);
+        box.enclose(b.maxPoint);
+      }
+    }
+
+    if (count > 0) {
+      const gSpatialPoint size = box.maxPoint - box.minPoint;
+      center = centroid(box);
+      length = std::max(std::max(size.x, size.y), std::max(size.z, minSize));
+    }
+
+    octreeReset(center, length);
+    for (size_t i = 0; i < bounds.size(); ++i) {
+      next[i] = prev[i] = owner[i] = SPATIAL_NONE;
+      if (!glm_spatialempty(bounds[i]))
+        octreeInsert(static_cast<uint32_t>(i));
+    }
+  }
+};
+
+/* }================================================================== */
+
+/*
+** {==================================================================
+** Queries
+** ===================================================================
+*/
+
+struct gSpatialContains {
+  gSpatialPoint p;
+  LUA_INLINE bool operator()(const gSpatialAABB &b) const { return glm::contains(b, p); }
+};
+
+struct gSpatialIntersectsRay {
+  gSpatialRay ray;
+  LUA_INLINE bool operator()(const gSpatialAABB &b) const { return glm::intersects(b, ray); }
+};
+
+struct gSpatialIntersectsAABB {
+  gSpatialAABB box;
+  LUA_INLINE bool operator()(const gSpatialAABB &b) const { return glm::intersects(b, box); }
+};
+
+struct gSpatialIntersectsSphere {
+  gSpatialSphere sphere;
+  LUA_INLINE bool operator()(const gSpatialAABB &b) const { return glm::intersects(b, sphere); }
+};
+
+struct gSpatialEverything {
+  LUA_INLINE bool operator()(const gSpatialAABB &) const { return true; }
+};
+
+/// <summary>
+/// Append the object of each emitted slot to the table at 'result'.
+/// </summary>
+struct gSpatialEmit {
+  lua_State *L;
+  int objects;  // Stack index of the slot-to-object table.
+  int result;
+  lua_Integer n;
+
+  void operator()(uint32_t slot) {
+    lua_rawgeti(L, objects, static_cast<lua_Integer>(slot) + 1);
+    lua_rawseti(L, result, ++n);
+  }
+};
+
+/// <summary>
+/// Return the index userdata at the given stack index.
+/// </summary>
+static gLuaSpatial *glm_tospatial(lua_State *L, int idx) {
+  gLuaSpatial *index = static_cast<gLuaSpatial *>(luaL_checkudata(L, idx, LUAGLM_SPATIAL_META));
+  if (l_unlikely(index->kind == gLuaSpatial::None))
+    luaL_argerror(L, idx, "spatial index has been collected");
+  index->validate(L);
+  return index;
+}
+
+static gSpatialPoint glm_tospatialpoint(lua_State *L, int idx) {
+  glm::length_t size = 0;
+  if (l_unlikely(!glm_isvector(L, idx, size) || size < 3))
+    luaL_typeerror(L, idx, GLM_STRING_VECTOR3);
+  return gSpatialPoint(glm_tovec3(L, idx));
+}
+
+/// <summary>
+/// Continuation of glm_spatialyield: invoke the yield function with each result.
+/// The stack is expected to end with: [yield, results, i].
+/// </summary>
+static int glm_spatialyieldk(lua_State *L, int status, lua_KContext ctx) {
+  const lua_Integer n = static_cast<lua_Integer>(ctx);
+  lua_Integer i = lua_tointeger(L, -1);
+  ((void)status);
+  while (i < n) {
+    lua_pushinteger(L, ++i);
+    lua_replace(L, -2);
+    lua_pushvalue(L, -3);  // [yield, results, i, yield]
+    lua_rawgeti(L, -3, i);  // [yield, results, i, yield, object]
+    lua_callk(L, 1, 0, ctx, glm_spatialyieldk);
+  }
+  return 0;
+}
+
+/// <summary>
+/// Generalized query: spatial:F(cache, ..., yield).
+///
+/// Matching objects are collected into 'cache' (a table; see CreateQueryCache)
+/// before 'yield' is invoked for each. This allows yield to modify the index
+/// and/or be a coroutine yield. If yield is nil a table of objects is returned.
+/// </summary>
+template<class Test>
+static int glm_spatialquery(lua_State *L, gLuaSpatial *index, const Test &test, int cache, int yield) {
+  const bool callback = !lua_isnoneornil(L, yield);
+  if (callback)
+    luaL_checktype(L, yield, LUA_TFUNCTION);
+
+  lua_settop(L, yield);
+  lua_getiuservalue(L, 1, 1);  // [..., yield, objects]
+  if (callback && cache != 0 && lua_istable(L, cache))
+    lua_pushvalue(L, cache);
+  else
+    lua_newtable(L);  // [..., yield, objects, results]
+
+  gSpatialEmit emit = { L, yield + 1, yield + 2, 0 };
+  index->prepare();
+  index->query(test, emit);
+  if (!callback)
+    return 1;
+
+  lua_remove(L, yield + 1);  // [..., yield, results]
+  lua_pushinteger(L, 0);  // [..., yield, results, i]
+  return glm_spatialyieldk(L, LUA_OK, static_cast<lua_KContext>(emit.n));
+}
+
+/* }================================================================== */
+
+/*
+** {==================================================================
+** Spatial API
+** ===================================================================
+*/
+
+/// <summary>
+/// Create a new index userdata; uservalues: [1] = slot-to-object, [2] =
+/// object-to-slot.
+/// </summary>
+static gLuaSpatial *glm_newspatial(lua_State *L, int kind, uint32_t leafSize) {
+  void *ptr = lua_newuserdatauv(L, sizeof(gLuaSpatial), 2);  // [..., index]
+  gLuaSpatial *index = ::new (ptr) gLuaSpatial(L, kind, leafSize);
+  luaL_setmetatable(L, LUAGLM_SPATIAL_META);
+  lua_newtable(L);
+  lua_setiuservalue(L, -2, 1);
+  lua_newtable(L);
+  lua_setiuservalue(L, -2, 2);
+  return index;
+}
+
+static uint32_t glm_spatialleafsize(lua_State *L, int idx, lua_Integer def) {
+  const lua_Integer leafSize = luaL_optinteger(L, idx, def);
+  luaL_argcheck(L, leafSize >= 1 && leafSize <= 0xFFFF, idx, "invalid leaf size");
+  return static_cast<uint32_t>(leafSize);
+}
+
+/// <summary>
+/// spatial.bvh([leafSize]): Create a new bounding volume hierarchy.
+/// </summary>
+GLM_BINDING_QUALIFIER(spatial_bvh) {
+  glm_newspatial(L, gLuaSpatial::BVH, glm_spatialleafsize(L, 1, 4));
+  return 1;
+}
+
+/// <summary>
+/// spatial.octree([position [, leafSize [, initialLength [, minSize [, looseness]]]]]):
+/// Create a new loose octree; see Octree.New.
+/// </summary>
+GLM_BINDING_QUALIFIER(spatial_octree) {
+  const gSpatialPoint position = lua_isnoneornil(L, 1) ? gSpatialPoint(0) : glm_tospatialpoint(L, 1);
+  const uint32_t leafSize = glm_spatialleafsize(L, 2, 16);
+  const gSpatialFloat length = static_cast<gSpatialFloat>(luaL_optnumber(L, 3, 1024.0));
+  const gSpatialFloat minSize = static_cast<gSpatialFloat>(luaL_optnumber(L, 4, 1.0));
+  const gSpatialFloat looseness = static_cast<gSpatialFloat>(luaL_optnumber(L, 5, 1.0));
+  luaL_argcheck(L, length > gSpatialFloat(0), 3, "invalid axis length");
+  luaL_argcheck(L, minSize > gSpatialFloat(0), 4, "invalid minimum size");
+
+  gLuaSpatial *index = glm_newspatial(L, gLuaSpatial::Octree, leafSize);
+  index->center = position;
+  index->length = length;
+  index->minSize = std::min(minSize, length);
+  index->looseness = glm::clamp(looseness, gSpatialFloat(1), gSpatialFloat(2));
+  index->clear();
+  return 1;
+}
+
+/// <summary>
+/// Garbage collect an allocated index userdata.
+/// </summary>
+GLM_BINDING_QUALIFIER(spatial_gc) {
+  gLuaSpatial *index = static_cast<gLuaSpatial *>(luaL_checkudata(L, 1, LUAGLM_SPATIAL_META));
+  if (l_likely(index->kind != gLuaSpatial::None)) {
+    index->validate(L);
+    index->~gLuaSpatial();  // Invoke destructor.
+    index->kind = gLuaSpatial::None;
+  }
+  return 0;
+}
+
+GLM_BINDING_QUALIFIER(spatial_len) {
+  lua_pushinteger(L, static_cast<lua_Integer>(glm_tospatial(L, 1)->count));
+  return 1;
+}
+
+GLM_BINDING_QUALIFIER(spatial_tostring) {
+  const gLuaSpatial *index = glm_tospatial(L, 1);
+  lua_pushfstring(L, "%s<%I>", index->kind == gLuaSpatial::BVH ? "BVH" : "Octree", static_cast<lua_Integer>(index->count));
+  return 1;
+}
+
+/// <summary>
+/// spatial:Bounds(object): minimum and maximum bounds of an indexed object.
+/// </summary>
+GLM_BINDING_QUALIFIER(spatial_Bounds) {
+  const gLuaSpatial *index = glm_tospatial(L, 1);
+  lua_settop(L, 2);
+  lua_getiuservalue(L, 1, 2);
+  lua_pushvalue(L, 2);
+  if (lua_rawget(L, -2) == LUA_TNIL)
+    return 0;
+
+  const gSpatialAABB &box = index->bounds[static_cast<size_t>(lua_tointeger(L, -1) - 1)];
+  glm_pushvec3(L, glm::vec<3, glm_Float, LUAGLM_Q>(box.minPoint));
+  glm_pushvec3(L, glm::vec<3, glm_Float, LUAGLM_Q>(box.maxPoint));
+  return 2;
+}
+
+GLM_BINDING_QUALIFIER(spatial_Clear) {
+  gLuaSpatial *index = glm_tospatial(L, 1);
+  index->clear();
+  lua_settop(L, 1);
+  lua_newtable(L);
+  lua_setiuservalue(L, 1, 1);
+  lua_newtable(L);
+  lua_setiuservalue(L, 1, 2);
+  return 1;
+}
+
+GLM_BINDING_QUALIFIER(spatial_Compact) {
+  gLuaSpatial *index = glm_tospatial(L, 1);
+  if (index->kind == gLuaSpatial::BVH && !(index->pending.empty() && index->dead.empty()))
+    index->rebuild();
+  index->compact();
+  lua_settop(L, 1);
+  return 1;
+}
+
+GLM_BINDING_QUALIFIER(spatial_Rebuild) {
+  glm_tospatial(L, 1)->rebuild();
+  lua_settop(L, 1);
+  return 1;
+}
+
+GLM_BINDING_QUALIFIER(spatial_Immutable) {
+  gLuaSpatial *index = glm_tospatial(L, 1);
+  index->rebuild();
+  index->immutable = true;
+  index->available.clear();
+  index->compact();
+  lua_settop(L, 1);
+  return 1;
+}
+
+/// <summary>
+/// Insert 'object' with the given bounds, replacing any previous entry.
+/// </summary>
+static int glm_spatialinsert(lua_State *L, gLuaSpatial *index, const gSpatialAABB &box) {
+  if (l_unlikely(index->immutable))
+    return luaL_error(L, "index is immutable");
+
+  lua_settop(L, 2);
+  lua_getiuservalue(L, 1, 1);  // [index, object, objects]
+  lua_getiuservalue(L, 1, 2);  // [index, object, objects, slots]
+  lua_pushvalue(L, 2);
+  if (lua_rawget(L, 4) != LUA_TNIL) {  // Update
+    const lua_Integer slot = lua_tointeger(L, -1);
+    index->remove(static_cast<uint32_t>(slot - 1));
+    lua_pushnil(L);
+    lua_rawseti(L, 3, slot);
+  }
+  lua_pop(L, 1);
+
+  // Validate the key prior to modifying the index, e.g., nil or NaN.
+  lua_pushvalue(L, 2);
+  lua_pushboolean(L, 1);
+  lua_rawset(L, 4);
+
+  const lua_Integer slot = static_cast<lua_Integer>(index->insert(box)) + 1;
+  lua_pushvalue(L, 2);
+  lua_rawseti(L, 3, slot);
+  lua_pushvalue(L, 2);
+  lua_pushinteger(L, slot);
+  lua_rawset(L, 4);
+  lua_settop(L, 1);
+  return 1;
+}
+
+/// <summary>
+/// spatial:Insert(object, aabbMin, aabbMax)
+/// </summary>
+GLM_BINDING_QUALIFIER(spatial_Insert) {
+  gLuaSpatial *index = glm_tospatial(L, 1);
+  luaL_checkany(L, 2);
+  const gSpatialPoint a = glm_tospatialpoint(L, 3);
+  const gSpatialPoint b = lua_isnoneornil(L, 4) ? a : glm_tospatialpoint(L, 4);
+  return glm_spatialinsert(L, index, gSpatialAABB(glm::min(a, b), glm::max(a, b)));
+}
+
+/// <summary>
+/// spatial:InsertPoint(object, point)
+/// </summary>
+GLM_BINDING_QUALIFIER(spatial_InsertPoint) {
+  gLuaSpatial *index = glm_tospatial(L, 1);
+  luaL_checkany(L, 2);
+  const gSpatialPoint p = glm_tospatialpoint(L, 3);
+  return glm_spatialinsert(L, index, gSpatialAABB(p, p));
+}
+
+/// <summary>
+/// spatial:Remove(object)
+/// </summary>
+GLM_BINDING_QUALIFIER(spatial_Remove) {
+  gLuaSpatial *index = glm_tospatial(L, 1);
+  if (l_unlikely(index->immutable))
+    return luaL_error(L, "index is immutable");
+
+  lua_settop(L, 2);
+  lua_getiuservalue(L, 1, 1);  // [index, object, objects]
+  lua_getiuservalue(L, 1, 2);  // [index, object, objects, slots]
+  lua_pushvalue(L, 2);
+  if (lua_rawget(L, 4) != LUA_TNIL) {
+    const lua_Integer slot = lua_tointeger(L, -1);
+    index->remove(static_cast<uint32_t>(slot - 1));
+    lua_pushnil(L);
+    lua_rawseti(L, 3, slot);
+    lua_pushvalue(L, 2);
+    lua_pushnil(L);
+    lua_rawset(L, 4);
+  }
+  lua_settop(L, 1);
+  return 1;
+}
+
+GLM_BINDING_QUALIFIER(spatial_CreateQueryCache) {
+  glm_tospatial(L, 1);
+  lua_newtable(L);
+  return 1;
+}
+
+/// <summary>
+/// spatial:Each(yield)
+/// </summary>
+GLM_BINDING_QUALIFIER(spatial_Each) {
+  gLuaSpatial *index = glm_tospatial(L, 1);
+  return glm_spatialquery(L, index, gSpatialEverything(), 0, 2);
+}
+
+/// <summary>
+/// spatial:Query(cache, point, yield)
+/// </summary>
+GLM_BINDING_QUALIFIER(spatial_Query) {
+  gLuaSpatial *index = glm_tospatial(L, 1);
+  const gSpatialContains test = { glm_tospatialpoint(L, 3) };
+  return glm_spatialquery(L, index, test, 2, 4);
+}
+
+/// <summary>
+/// spatial:Raycast(cache, origin, direction, yield)
+/// </summary>
+GLM_BINDING_QUALIFIER(spatial_Raycast) {
+  gLuaSpatial *index = glm_tospatial(L, 1);
+  const gSpatialIntersectsRay test = { gSpatialRay(glm_tospatialpoint(L, 3), glm_tospatialpoint(L, 4)) };
+  return glm_spatialquery(L, index, test, 2, 5);
+}
+
+/// <summary>
+/// spatial:Colliding(cache, colMin, colMax, yield)
+/// </summary>
+GLM_BINDING_QUALIFIER(spatial_Colliding) {
+  gLuaSpatial *index = glm_tospatial(L, 1);
+  const gSpatialIntersectsAABB test = { gSpatialAABB(glm_tospatialpoint(L, 3), glm_tospatialpoint(L, 4)) };
+  return glm_spatialquery(L, index, test, 2, 5);
+}
+
+/// <summary>
+/// spatial:SphereIntersection(cache, origin, radius, yield)
+/// </summary>
+GLM_BINDING_QUALIFIER(spatial_SphereIntersection) {
+  gLuaSpatial *index = glm_tospatial(L, 1);
+  const gSpatialPoint origin = glm_tospatialpoint(L, 3);
+  const gSpatialIntersectsSphere test = { gSpatialSphere(origin, static_cast<gSpatialFloat>(luaL_checknumber(L, 4))) };
+  return glm_spatialquery(L, index, test, 2, 5);
+}
+
+/// <summary>
+/// spatial:NearestNeighbors(_, point, neighborList)
+///
+/// neighborList is either an OrderedList, populated with :Insert(object,
+/// distance) and returned, or the number of neighbors to search for; returning
+/// arrays of objects and distances, sorted by distance. Native ordered lists
+/// (glm.orderedlist) are populated directly.
+/// </summary>
+GLM_BINDING_QUALIFIER(spatial_NearestNeighbors) {
+  gLuaSpatial *index = glm_tospatial(L, 1);
+  const gSpatialPoint p = glm_tospatialpoint(L, 3);
+  gLuaOrderedList *native = glm_testorderedlist(L, 4);
+  const bool list = lua_istable(L, 4);
+
+  lua_Integer k = 0;
+  if (native != GLM_NULLPTR) {
+    k = native->maxSize;
+  }
+  else if (list) {
+    lua_getfield(L, 4, "maxSize");
+    k = lua_tointeger(L, -1);
+  }
+  else {
+    k = luaL_checkinteger(L, 4);
+  }
+
+  lua_settop(L, 4);
+  lua_getiuservalue(L, 1, 1);  // [..., objects]
+  index->prepare();
+  index->nearest(p, static_cast<size_t>(std::max<lua_Integer>(k, 0)));
+
+  const int n = static_cast<int>(index->neighbors.size());
+  if (native != GLM_NULLPTR) {
+    for (int i = 0; i < n; ++i) {
+      const gSpatialNeighbor &neighbor = index->neighbors[static_cast<size_t>(i)];
+      lua_rawgeti(L, 5, static_cast<lua_Integer>(neighbor.slot) + 1);
+      glm_orderedlistinsert(L, 4, native, static_cast<lua_Number>(glm::sqrt(neighbor.dist2)));
+    }
+    lua_settop(L, 4);
+    return 1;
+  }
+
+  // Collect the results before invoking any metamethods.
+  lua_createtable(L, n, 0);  // [..., objects, results]
+  lua_createtable(L, n, 0);  // [..., objects, results, distances]
+  for (int i = 0; i < n; ++i) {
+    const gSpatialNeighbor &neighbor = index->neighbors[static_cast<size_t>(i)];
+    lua_rawgeti(L, 5, static_cast<lua_Integer>(neighbor.slot) + 1);
+    lua_rawseti(L, 6, i + 1);
+    lua_pushnumber(L, static_cast<lua_Number>(glm::sqrt(neighbor.dist2)));
+    lua_rawseti(L, 7, i + 1);
+  }
+
+  if (!list)
+    return 2;
+
+  for (int i = 1; i <= n; ++i) {
+    lua_getfield(L, 4, "Insert");
+    lua_pushvalue(L, 4);
+    lua_rawgeti(L, 6, i);
+    lua_rawgeti(L, 7, i);
+    lua_call(L, 3, 0);
+  }
+  lua_settop(L, 4);
+  return 1;
+}
+
+/// <summary>
+/// spatial:Statistics(): table of index statistics.
+/// </summary>
+GLM_BINDING_QUALIFIER(spatial_Statistics) {
+  const gLuaSpatial *index = glm_tospatial(L, 1);
+  const gLuaSpatial::Statistics s = index->statistics();
+  lua_createtable(L, 0, 6);
+  lua_pushinteger(L, static_cast<lua_Integer>(index->count));
+  lua_setfield(L, -2, "objectCount");
+  lua_pushinteger(L, static_cast<lua_Integer>(s.nodes));
+  lua_setfield(L, -2, "nodeCount");
+  lua_pushinteger(L, static_cast<lua_Integer>(s.leaves));
+  lua_setfield(L, -2, "leafCount");
+  lua_pushinteger(L, static_cast<lua_Integer>(s.depth));
+  lua_setfield(L, -2, "maxDepth");
+  lua_pushinteger(L, static_cast<lua_Integer>(index->leafSize));
+  lua_setfield(L, -2, "leafSize");
+  lua_pushinteger(L, static_cast<lua_Integer>(index->memory()));
+  lua_setfield(L, -2, "memory");
+  return 1;
+}
+
+/// <summary>
+/// spatial:Output(print): write a string-representation of the index.
+/// </summary>
+GLM_BINDING_QUALIFIER(spatial_Output) {
+  const gLuaSpatial *index = glm_tospatial(L, 1);
+  const gLuaSpatial::Statistics s = index->statistics();
+  luaL_checkany(L, 2);
+  lua_settop(L, 2);
+  lua_pushvalue(L, 2);
+  lua_pushfstring(L, "%s<%I>: Leaf Size = %d, Node Count = %I, Leaf Count = %I, Depth = %I, Memory = %I bytes",
+    index->kind == gLuaSpatial::BVH ? "BVH" : "Octree", static_cast<lua_Integer>(index->count),
+    static_cast<int>(index->leafSize), static_cast<lua_Integer>(s.nodes), static_cast<lua_Integer>(s.leaves),
+    static_cast<lua_Integer>(s.depth), static_cast<lua_Integer>(index->memory()));
+  lua_call(L, 1, 0);
+  lua_settop(L, 1);
+  return 1;
+}
+
+static const luaL_Reg luaglm_spatiallib[] = {
+  { "__gc", GLM_NAME(spatial_gc) },
+  { "__len", GLM_NAME(spatial_len) },
+  { "__tostring", GLM_NAME(spatial_tostring) },
+  { "bvh", GLM_NAME(spatial_bvh) },
+  { "octree", GLM_NAME(spatial_octree) },
+  { "Bounds", GLM_NAME(spatial_Bounds) },
+  { "Clear", GLM_NAME(spatial_Clear) },
+  { "Compact", GLM_NAME(spatial_Compact) },
+  { "Rebuild", GLM_NAME(spatial_Rebuild) },
+  { "Immutable", GLM_NAME(spatial_Immutable) },
+  { "Insert", GLM_NAME(spatial_Insert) },
+  { "InsertPoint", GLM_NAME(spatial_InsertPoint) },
+  { "Remove", GLM_NAME(spatial_Remove) },
+  { "CreateQueryCache", GLM_NAME(spatial_CreateQueryCache) },
+  { "Each", GLM_NAME(spatial_Each) },
+  { "Query", GLM_NAME(spatial_Query) },
+  { "Raycast", GLM_NAME(spatial_Raycast) },
+  { "Colliding", GLM_NAME(spatial_Colliding) },
+  { "SphereIntersection", GLM_NAME(spatial_SphereIntersection) },
+  { "NearestNeighbors", GLM_NAME(spatial_NearestNeighbors) },
+  { "Statistics", GLM_NAME(spatial_Statistics) },
+  { "Output", GLM_NAME(spatial_Output) },
+  { GLM_NULLPTR, GLM_NULLPTR }
+};
+
+/* }================================================================== */
+
+#endif
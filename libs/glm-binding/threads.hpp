@@ -0,0 +1,264 @@
+/*
+** $Id: threads.hpp $
+** A process-wide pool of worker threads for data-parallel kernels, i.e., loops
+** over memory that is not owned by, and never touches, a lua_State (glm.batch
+** over string blobs and the batched ray queries over packed triangles).
+**
+** The pool is experimental and opt-in: it has no workers until configured
+** (glm.batch.threads) and ranges smaller than the configured threshold are
+** processed on the calling thread. Dispatch is synchronous; the calling thread processes its
+** share of the range and waits on all workers before returning.
+**
+** See Copyright Notice in lua.h
+*/
+#ifndef BINDING_THREADS_HPP
+#define BINDING_THREADS_HPP
+
+#include <cstddef>
+#include <mutex>
+#if defined(LUAGLM_THREADS)
+  #include <atomic>
+  #include <condition_variable>
+  #include <thread>
+  #include <vector>
+#endif
+
+/*
+@@ LUAGLM_THREADS_MAX Maximum number of workers in the pool.
+*/
+#if !defined(LUAGLM_THREADS_MAX)
+  #define LUAGLM_THREADS_MAX 64
+#endif
+
+/*
+@@ LUAGLM_THREADS_THRESHOLD Default number of elements below which a range is
+** processed on the calling thread.
+*/
+#if !defined(LUAGLM_THREADS_THRESHOLD)
+  #define LUAGLM_THREADS_THRESHOLD 65536
+#endif
+
+/*
+@@ LUAGLM_THREADS_SPLIT Number of chunks a range is divided into per thread
+** (workers and the calling thread). Values greater than one allow threads to
+** rebalance uneven workloads, e.g., early-outs in intersection tests.
+*/
+#if !defined(LUAGLM_THREADS_SPLIT)
+  #define LUAGLM_THREADS_SPLIT 4
+#endif
+
+#if defined(LUAGLM_THREADS)
+using gLuaThreadMutex = std::mutex;
+#else
+/// <summary>
+/// Placeholder mutex for kernels that merge results from multiple chunks: all
+/// chunks are processed on the calling thread.
+/// </summary>
+struct gLuaThreadMutex {
+  void lock() { }
+  void unlock() { }
+};
+#endif
+
+/// <summary>
+/// Worker thread pool.
+/// </summary>
+class gLuaThreadPool {
+public:
+  /* Process elements [begin, end) of a range; must not throw or touch Lua. */
+  using Task = void (*)(void *ud, size_t begin, size_t end);
+
+private:
+  size_t threshold = LUAGLM_THREADS_THRESHOLD;
+
+#if defined(LUAGLM_THREADS)
+  std::mutex dispatch;  // Held while a range is being processed by the pool
+  std::mutex lock;  // Guards all fields below
+  std::condition_variable wake;  // Signals workers of a new range (or to stop)
+  std::condition_variable done;  // Signals the dispatcher that workers are idle
+  std::vector<std::thread> workers;
+  size_t generation = 0;  // Incremented on each dispatched range
+  size_t running = 0;  // Number of workers processing the current range
+  bool stop = false;
+
+  /* Current range */
+  Task task = nullptr;
+  void *ud = nullptr;
+  size_t count = 0;  // Number of elements
+  size_t chunk = 0;  // Number of elements per chunk
+  size_t chunks = 0;  // Number of chunks
+  std::atomic<size_t> next { 0 };  // Next unprocessed chunk
+
+  /// <summary>
+  /// Process chunks of the range until exhausted.
+  /// </summary>
+  static void Drain(std::atomic<size_t> &next_, Task task_, void *ud_, size_t count_, size_t chunk_, size_t chunks_) {
+    for (size_t i = next_.fetch_add(1); i < chunks_; i = next_.fetch_add(1)) {
+      const size_t begin = i * chunk_;
+      const size_t end = (count_ - begin) < chunk_ ? count_ : begin + chunk_;
+      task_(ud_, begin, end);
+    }
+  }
+
+  void Worker() {
+    std::unique_lock<std::mutex> guard(lock);
+    size_t seen = generation;
+    for (;;) {
+      wake.wait(guard, [&]() { return stop || generation != seen; });
+      if (stop)
+        break;
+
+      seen = generation;
+      running++;
+      const Task task_ = task;
+      void *ud_ = ud;
+      const size_t count_ = count, chunk_ = chunk, chunks_ = chunks;
+      guard.unlock();
+
+      Drain(next, task_, ud_, count_, chunk_, chunks_);
+
+      guard.lock();
+      if (--running == 0)
+        done.notify_one();
+    }
+  }
+
+  void Join() {
+    {
+      std::lock_guard<std::mutex> guard(lock);
+      stop = true;
+    }
+    wake.notify_all();
+    for (std::thread &t : workers)
+      t.join();
+    workers.clear();
+    stop = false;
+  }
+#endif
+
+  gLuaThreadPool() = default;
+  gLuaThreadPool(const gLuaThreadPool &) = delete;
+  gLuaThreadPool &operator=(const gLuaThreadPool &) = delete;
+
+public:
+#if defined(LUAGLM_THREADS)
+  ~gLuaThreadPool() {
+    Join();
+  }
+#endif
+
+  static gLuaThreadPool &Instance() {
+    static gLuaThreadPool pool;
+    return pool;
+  }
+
+  /// <summary>
+  /// Number of workers, excluding the calling thread.
+  /// </summary>
+  size_t Workers() {
+#if defined(LUAGLM_THREADS)
+    std::lock_guard<std::mutex> guard(dispatch);
+    return workers.size();
+#else
+    return 0;
+#endif
+  }
+
+  size_t Threshold() const {
+    return threshold;
+  }
+
+  /// <summary>
+  /// Number of concurrent threads supported by the implementation (at least 1).
+  /// </summary>
+  static size_t Concurrency() {
+#if defined(LUAGLM_THREADS)
+    const unsigned n = std::thread::hardware_concurrency();
+    return n == 0 ? 1 : static_cast<size_t>(n);
+#else
+    return 1;
+#endif
+  }
+
+  /// <summary>
+  /// Resize the pool; waits for any range being processed. Returns the number
+  /// of workers, which is zero when compiled without LUAGLM_THREADS.
+  /// </summary>
+  size_t Configure(size_t workers_, size_t threshold_) {
+#if defined(LUAGLM_THREADS)
+    std::lock_guard<std::mutex> guard(dispatch);
+    threshold = threshold_;
+    if (workers_ > LUAGLM_THREADS_MAX)
+      workers_ = LUAGLM_THREADS_MAX;
+
+    if (workers_ != workers.size()) {
+      Join();
+      workers.reserve(workers_);
+      for (size_t i = 0; i < workers_; ++i)
+        workers.emplace_back(&gLuaThreadPool::Worker, this);
+    }
+    return workers.size();
+#else
+    ((void)workers_);
+    threshold = threshold_;
+    return 0;
+#endif
+  }
+
+  /// <summary>
+  /// Invoke 'task' over [0, n) split into chunks that are a multiple of 'grain'
+  /// elements. The range is processed on the calling thread when the pool has
+  /// no workers, 'n' is below the threshold, or the pool is in use by another
+  /// thread (i.e., another lua_State).
+  /// </summary>
+  void For(size_t n, size_t grain, Task task_, void *ud_) {
+#if defined(LUAGLM_THREADS)
+    if (n > grain) {
+      std::unique_lock<std::mutex> active(dispatch, std::try_to_lock);
+      if (active.owns_lock() && !workers.empty() && n >= threshold) {
+        const size_t threads = workers.size() + 1;
+        size_t chunk_ = n / (threads * LUAGLM_THREADS_SPLIT);
+        chunk_ = (chunk_ < grain) ? grain : (chunk_ - (chunk_ % grain));
+
+        // Workers that woke late for the previous range may still hold it.
+        std::unique_lock<std::mutex> guard(lock);
+        done.wait(guard, [&]() { return running == 0; });
+        task = task_;
+        ud = ud_;
+        count = n;
+        chunk = chunk_;
+        chunks = (n + chunk_ - 1) / chunk_;
+        next.store(0);
+        generation++;
+        guard.unlock();
+        wake.notify_all();
+
+        Drain(next, task_, ud_, n, chunk_, (n + chunk_ - 1) / chunk_);
+
+        // Workers that have yet to wake will find no remaining chunks.
+        guard.lock();
+        done.wait(guard, [&]() { return running == 0; });
+        task = nullptr;
+        ud = nullptr;
+        return;
+      }
+    }
+#else
+    ((void)grain);
+#endif
+    if (n > 0)
+      task_(ud_, 0, n);
+  }
+};
+
+/// <summary>
+/// Invoke f(begin, end) over [0, n), possibly in parallel; see gLuaThreadPool::For.
+/// </summary>
+template<typename F>
+static void glm_parallel_for(size_t n, size_t grain, F &f) {
+  gLuaThreadPool::Instance().For(n, grain, [](void *ud, size_t begin, size_t end) {
+    (*static_cast<F *>(ud))(begin, end);
+  }, static_cast<void *>(&f));
+}
+
+#endif
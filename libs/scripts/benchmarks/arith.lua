@@ -0,0 +1,47 @@
+--[[
+    Vector/quaternion arithmetic microbenchmark.
+
+    Measures the throughput (millions of operations per second) of the
+    component-wise operators that are inlined by luaV_execute, i.e., those
+    that do not dispatch through OP_MMBIN/luaT_trybinTM.
+
+@USAGE
+    lua arith.lua [iterations]
+
+@LICENSE
+    It's yours, I don't want it.
+--]]
+local N = math.tointeger(tonumber(arg and arg[1] or nil)) or 10000000
+
+local os_clock = os.clock
+local string_format = string.format
+
+local vec3 = vec3
+local vec4 = vec4
+local quat = quat
+
+local cases = {
+    { "vec3 + vec3", function(n, a, b) for _ = 1, n do a = a + b end return a end, vec3(0), vec3(1, 2, 3) },
+    { "vec3 - vec3", function(n, a, b) for _ = 1, n do a = a - b end return a end, vec3(0), vec3(1, 2, 3) },
+    { "vec3 * vec3", function(n, a, b) for _ = 1, n do a = a * b end return a end, vec3(1), vec3(1, 1, 1) },
+    { "vec3 / vec3", function(n, a, b) for _ = 1, n do a = a / b end return a end, vec3(1), vec3(1, 1, 1) },
+    { "vec4 + vec4", function(n, a, b) for _ = 1, n do a = a + b end return a end, vec4(0), vec4(1, 2, 3, 4) },
+    { "vec3 * number", function(n, a, b) for _ = 1, n do a = a * b end return a end, vec3(1), 1.0 },
+    { "number * vec3", function(n, a, b) for _ = 1, n do a = b * a end return a end, vec3(1), 1.0 },
+    { "vec3 * 2.0 (K)", function(n, a) for _ = 1, n do a = a * 2.0 end return a end, vec3(1) },
+    { "vec3 + 1 (I)", function(n, a) for _ = 1, n do a = a + 1 end return a end, vec3(0) },
+    { "-vec3", function(n, a) for _ = 1, n do a = -a end return a end, vec3(1, 2, 3) },
+    { "quat + quat", function(n, a, b) for _ = 1, n do a = a + b end return a end, quat(1, 0, 0, 0), quat(0, 0, 0, 0) },
+    { "quat * number", function(n, a, b) for _ = 1, n do a = a * b end return a end, quat(1, 0, 0, 0), 1.0 },
+}
+
+print(string_format("%-16s %12s %10s", "Operation", "iterations", "Mops/s"))
+for i = 1, #cases do
+    local name, f, a, b = cases[i][1], cases[i][2], cases[i][3], cases[i][4]
+    f(N // 100, a, b) -- warmup
+
+    local start = os_clock()
+    f(N, a, b)
+    local elapsed = os_clock() - start
+    print(string_format("%-16s %12d %10.3f", name, N, (N / elapsed) / 1e6))
+end
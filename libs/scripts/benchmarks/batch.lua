@@ -0,0 +1,92 @@
+--[[
+    Batch transform microbenchmark.
+
+    Transforms an array of points by a model matrix: once with a per-element
+    Lua loop over a table of vec3s and once with glm.batch.transform over a
+    packed blob (requires LUAGLM_EXT_BLOB). When given a number of workers the
+    batched transform is repeated with the worker thread pool enabled (requires
+    LUAGLM_THREADS).
+
+@USAGE
+    lua batch.lua [points] [iterations] [workers]
+
+@LICENSE
+    It's yours, I don't want it.
+--]]
+local POINTS = math.tointeger(tonumber(arg and arg[1] or nil)) or 1000000
+local ITERATIONS = math.tointeger(tonumber(arg and arg[2] or nil)) or 10
+local WORKERS = math.tointeger(tonumber(arg and arg[3] or nil)) or 0
+
+-- Wall-clock time: os.clock is the processor time of all threads.
+local os_clock = os.microtime and function() return os.microtime() * 1E-6 end or os.clock
+local string_format = string.format
+local string_pack = string.pack
+
+local vec3 = vec3
+local batch = glm.batch
+if not batch or not string.blob then
+    error("glm.batch requires a runtime compiled with LUAGLM_EXT_BLOB")
+end
+
+local model = glm.rotate(glm.translate(mat4(), vec3(1, 2, 3)), 0.5, vec3(0, 0, 1))
+
+-- Source data
+local points = { }
+local parts = { }
+for i = 1, POINTS do
+    local p = vec3(i, i * 0.5, -i)
+    points[i] = p
+    parts[i] = string_pack("fff", p.x, p.y, p.z)
+end
+local blob = string.blob(table.concat(parts))
+local out = string.blob(batch.size("vec3", POINTS))
+
+local function loop()
+    local result = { }
+    for _ = 1, ITERATIONS do
+        for i = 1, POINTS do
+            result[i] = model * points[i]
+        end
+    end
+    return result
+end
+
+local function batched()
+    for _ = 1, ITERATIONS do
+        batch.transform("vec3", out, model, blob)
+    end
+    return out
+end
+
+collectgarbage()
+local start = os_clock()
+loop()
+local elapsedLoop = os_clock() - start
+
+collectgarbage()
+start = os_clock()
+batched()
+local elapsedBatch = os_clock() - start
+
+print(string_format("%-12s %10d", "points", POINTS))
+print(string_format("%-12s %10d", "iterations", ITERATIONS))
+print(string_format("%-12s %10.3f s", "loop", elapsedLoop))
+print(string_format("%-12s %10.3f s", "batch", elapsedBatch))
+print(string_format("%-12s %10.2fx", "speedup", elapsedLoop / elapsedBatch))
+
+if WORKERS ~= 0 then
+    local workers = batch.threads(WORKERS, 0)
+    if workers == 0 then
+        error("glm.batch.threads requires a runtime compiled with LUAGLM_THREADS")
+    end
+
+    collectgarbage()
+    start = os_clock()
+    batched()
+    local elapsedThreads = os_clock() - start
+    batch.threads(0)
+
+    print(string_format("%-12s %10.3f s", "threads", elapsedThreads))
+    print(string_format("%-12s %10d", "workers", workers))
+    print(string_format("%-12s %10.2fx", "scaling", elapsedBatch / elapsedThreads))
+end
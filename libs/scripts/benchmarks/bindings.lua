@@ -0,0 +1,67 @@
+--[[
+    Binding dispatch microbenchmark.
+
+    Measures the call throughput of common glm bindings over scalar, vector,
+    and quaternion arguments. Overloads of the binary and ternary argument
+    layouts (distance, dot, mix, clamp, smoothstep, ...) are selected by
+    comparing a packed signature of the argument type tags against the one
+    computed from the traits of each overload. Cases that mix integer and
+    float arguments, or pass strings, exercise the coercing fallback.
+
+@USAGE
+    lua bindings.lua [iterations]
+
+@LICENSE
+    It's yours, I don't want it.
+--]]
+local ITERATIONS = math.tointeger(tonumber(arg and arg[1] or nil)) or 5000000
+
+local os_clock = os.clock
+local string_format = string.format
+
+local glm = assert(glm, "glm library not loaded")
+local vec3 = vec3
+local quat = quat
+
+local a, b = vec3(1, 2, 3), vec3(4, 5, 6)
+local q, r = quat(1, 0, 0, 0), quat(0, 1, 0, 0)
+
+local cases = {
+    { "length(v)", glm.length, a },
+    { "distance(v, v)", glm.distance, a, b },
+    { "distance(x, y)", glm.distance, 1.5, 2.5 },
+    { "dot(v, v)", glm.dot, a, b },
+    { "dot(q, q)", glm.dot, q, r },
+    { "step(v, v)", glm.step, a, b },
+    { "mix(v, v, t)", glm.mix, a, b, 0.5 },
+    { "mix(v, v, v)", glm.mix, a, b, a },
+    { "mix(v, v, bool)", glm.mix, a, b, true },
+    { "mix(x, y, t)", glm.mix, 1.0, 2.0, 0.5 },
+    { "mix(q, q, t)", glm.mix, q, r, 0.5 },
+    { "clamp(v)", glm.clamp, a },
+    { "clamp(v, x, y)", glm.clamp, a, 0.0, 1.0 },
+    { "clamp(v, 0, 1)", glm.clamp, a, 0, 1 },
+    { "clamp(v, v, v)", glm.clamp, a, a, b },
+    { "clamp(x, y, z)", glm.clamp, 0.5, 0.0, 1.0 },
+    { "smoothstep(v,v,v)", glm.smoothstep, a, b, a },
+    { "smoothstep(x,y,z)", glm.smoothstep, 0.0, 1.0, 0.5 },
+    { "refract(v, v, t)", glm.refract, a, b, 0.5 },
+    { "atan2(x, \"y\")", glm.atan2, 1.0, "2.0" },
+}
+
+-- Bindings are arity sensitive, e.g., clamp(v) ~= clamp(v, nil, nil)
+local runners = {
+    function(n, F, x) local r = nil for _ = 1, n do r = F(x) end return r end,
+    function(n, F, x, y) local r = nil for _ = 1, n do r = F(x, y) end return r end,
+    function(n, F, x, y, z) local r = nil for _ = 1, n do r = F(x, y, z) end return r end,
+}
+
+print(string_format("%-20s %12s %10s %12s", "case", "n", "time", "Mi/s"))
+for i = 1, #cases do
+    local c = cases[i]
+    collectgarbage()
+    local start = os_clock()
+    runners[#c - 2](ITERATIONS, c[2], c[3], c[4], c[5])
+    local elapsed = os_clock() - start
+    print(string_format("%-20s %12d %8.3f s %12.2f", c[1], ITERATIONS, elapsed, ITERATIONS / elapsed / 1e6))
+end
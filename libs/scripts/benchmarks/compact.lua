@@ -0,0 +1,113 @@
+--[[
+    TValue layout benchmark.
+
+    Compares the memory footprint and throughput of table-heavy workloads
+    (array/hash construction and traversal, in the style of testes/nextvar.lua)
+    and vector-heavy workloads (ray-sphere intersection and shading arithmetic,
+    in the style of examples/smallpt.lua). Intended to be run against runtimes
+    compiled with and without LUAGLM_COMPACT_VALUE: the former stores vec2 in
+    the Value payload and boxes vec3/vec4/quat as collectable objects.
+
+    Memory is reported in bytes per iteration: "retained" is the size of the
+    result after a full collection (for the table cases, the effective
+    TValue/Node size of the runtime) and "peak" is the growth with the
+    collector stopped, i.e., including the garbage of boxed temporaries.
+
+@USAGE
+    lua compact.lua [table size] [vector iterations]
+
+@LICENSE
+    It's yours, I don't want it.
+--]]
+local SIZE = math.tointeger(tonumber(arg and arg[1] or nil)) or 1000000
+local ITERATIONS = math.tointeger(tonumber(arg and arg[2] or nil)) or 2000000
+
+local os_clock = os.clock
+local string_format = string.format
+
+local vec2 = vec2
+local vec3 = vec3
+local quat = quat
+local dot = glm.dot
+local normalize = glm.normalize
+
+local function measure(F, n)
+    collectgarbage()
+    collectgarbage()
+    local memory = collectgarbage("count")
+    local peak = memory
+    collectgarbage("stop")
+    local start = os_clock()
+    local result = F(n)
+    local elapsed = os_clock() - start
+    peak = collectgarbage("count") - peak
+    collectgarbage("restart")
+    collectgarbage()
+    return result, elapsed, (collectgarbage("count") - memory) * 1024.0 / n, peak * 1024.0 / n
+end
+
+local cases = {
+    { "array (integers)", function(n)
+        local t = { }
+        for i = 1, n do t[i] = i end
+        local s = 0
+        for i = 1, #t do s = s + t[i] end
+        return t
+    end },
+    { "hash (strings)", function(n)
+        local t = { }
+        for i = 1, n do t["k" .. (i % 4096)] = i; t[i + 0.5] = true end
+        local c = 0
+        for _ in pairs(t) do c = c + 1 end
+        return t
+    end },
+    { "nested records", function(n)
+        local t = { }
+        for i = 1, n // 8 do t[i] = { x = i, y = i, z = i, name = "record" } end
+        return t
+    end },
+    { "array (vec2)", function(n)
+        local t = { }
+        for i = 1, n do t[i] = vec2(i, -i) end
+        return t
+    end },
+    { "array (vec3)", function(n)
+        local t = { }
+        for i = 1, n do t[i] = vec3(i, -i, 0) end
+        return t
+    end },
+    { "ray-sphere (vec3)", function(n)
+        local center, radius2 = vec3(0, 0, -5), 1.0
+        local origin, hits = vec3(0), 0
+        local color = vec3(0)
+        for i = 1, n do
+            local dir = normalize(vec3((i % 97) / 97.0 - 0.5, (i % 89) / 89.0 - 0.5, -1.0))
+            local oc = origin - center
+            local b = dot(oc, dir)
+            local det = b * b - dot(oc, oc) + radius2
+            if det >= 0 then
+                local p = origin + dir * (-b - det ^ 0.5)
+                color = color + normalize(p - center) * 0.5 + vec3(0.5)
+                hits = hits + 1
+            end
+        end
+        return hits
+    end },
+    { "rotations (quat)", function(n)
+        local q, r = quat(1, 0, 0, 0), quat(0.9998477, 0.0174524, 0, 0)
+        local v = vec3(0, 1, 0)
+        for _ = 1, n do
+            q = q * r
+            v = q * v
+        end
+        return v
+    end },
+}
+
+print(string_format("%-20s %10s %10s %12s %12s", "case", "n", "time", "retained", "peak"))
+for i = 1, #cases do
+    local name, F = cases[i][1], cases[i][2]
+    local n = (i <= 5) and SIZE or ITERATIONS
+    local _, elapsed, retained, peak = measure(F, n)
+    print(string_format("%-20s %10d %8.3f s %10.1f B %10.1f B", name, n, elapsed, retained, peak))
+end
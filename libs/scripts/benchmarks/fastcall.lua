@@ -0,0 +1,72 @@
+--[[
+    Fast call microbenchmark.
+
+    Measures the throughput of glm bindings that register typed variants for
+    OP_CALL (LUAGLM_EXT_FASTCALL): dot, cross, length, distance, normalize,
+    clamp, and mix over vec3 arguments. Each case is run twice: called
+    directly, which takes the fast path, and with an additional trailing
+    argument, which takes the regular path (luaD_precall + argument parsing)
+    without changing the result of the binding.
+
+@USAGE
+    lua fastcall.lua [iterations]
+
+@LICENSE
+    It's yours, I don't want it.
+--]]
+local ITERATIONS = math.tointeger(tonumber(arg and arg[1] or nil)) or 5000000
+
+local os_clock = os.clock
+local string_format = string.format
+
+local glm = assert(glm, "glm library not loaded")
+local vec3 = vec3
+
+local dot = glm.dot
+local cross = glm.cross
+local length = glm.length
+local distance = glm.distance
+local normalize = glm.normalize
+local clamp = glm.clamp
+local mix = glm.mix
+
+local a, b = vec3(1, 2, 3), vec3(4, 5, 6)
+
+-- { name, fast, regular }
+local cases = {
+    { "dot(v, v)",
+        function(n) local r for _ = 1, n do r = dot(a, b) end return r end,
+        function(n) local r for _ = 1, n do r = dot(a, b, nil) end return r end },
+    { "cross(v, v)",
+        function(n) local r for _ = 1, n do r = cross(a, b) end return r end,
+        function(n) local r for _ = 1, n do r = cross(a, b, nil) end return r end },
+    { "length(v)",
+        function(n) local r for _ = 1, n do r = length(a) end return r end,
+        function(n) local r for _ = 1, n do r = length(a, nil) end return r end },
+    { "distance(v, v)",
+        function(n) local r for _ = 1, n do r = distance(a, b) end return r end,
+        function(n) local r for _ = 1, n do r = distance(a, b, nil) end return r end },
+    { "normalize(v)",
+        function(n) local r for _ = 1, n do r = normalize(a) end return r end,
+        function(n) local r for _ = 1, n do r = normalize(a, nil) end return r end },
+    { "clamp(v, 0, 1)",
+        function(n) local r for _ = 1, n do r = clamp(a, 0, 1) end return r end,
+        function(n) local r for _ = 1, n do r = clamp(a, 0, 1, nil) end return r end },
+    { "mix(v, v, t)",
+        function(n) local r for _ = 1, n do r = mix(a, b, 0.5) end return r end,
+        function(n) local r for _ = 1, n do r = mix(a, b, 0.5, nil) end return r end },
+}
+
+local function measure(F)
+    collectgarbage()
+    local start = os_clock()
+    F(ITERATIONS)
+    return ITERATIONS / (os_clock() - start) / 1e6
+end
+
+print(string_format("%-16s %12s %12s %10s", "case", "fast Mi/s", "regular Mi/s", "speedup"))
+for i = 1, #cases do
+    local c = cases[i]
+    local fast, regular = measure(c[2]), measure(c[3])
+    print(string_format("%-16s %12.2f %12.2f %9.2fx", c[1], fast, regular, fast / regular))
+end
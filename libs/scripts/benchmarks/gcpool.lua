@@ -0,0 +1,72 @@
+--[[
+    Matrix allocation microbenchmark.
+
+    Emulates a camera/skinning workload that creates many short-lived
+    matrices per frame and reports the elapsed time, the longest full
+    collection ("pause"), and, when the runtime is compiled with
+    LUAGLM_EXT_GCPOOL, the number of matrix/upvalue allocations served by the
+    collector pools (hits) vs. the allocator (misses).
+
+@USAGE
+    lua gcpool.lua [frames] [matrices per frame] [pool size]
+
+@LICENSE
+    It's yours, I don't want it.
+--]]
+local FRAMES = math.tointeger(tonumber(arg and arg[1] or nil)) or 200
+local PER_FRAME = math.tointeger(tonumber(arg and arg[2] or nil)) or 20000
+local POOL_SIZE = math.tointeger(tonumber(arg and arg[3] or nil))
+
+local os_clock = os.clock
+local string_format = string.format
+
+local mat4 = mat4
+local vec3 = vec3
+local translate = glm.translate
+local rotate = glm.rotate
+
+local hasPool = pcall(collectgarbage, "pool")
+if hasPool and POOL_SIZE then
+    collectgarbage("setpool", POOL_SIZE)
+end
+
+local function frame(n, view)
+    local axis = vec3(0, 0, 1)
+    local acc = mat4()
+    for i = 1, n do
+        local model = rotate(translate(mat4(), vec3(i, 0, 0)), i * 1e-3, axis)
+        acc = view * model
+    end
+    return acc
+end
+
+collectgarbage()
+if hasPool then
+    collectgarbage("setpool") -- reset statistics
+end
+
+local view = mat4()
+local maxPause = 0.0
+local start = os_clock()
+for _ = 1, FRAMES do
+    frame(PER_FRAME, view)
+
+    local pauseStart = os_clock()
+    collectgarbage("step", 0)
+    local pause = os_clock() - pauseStart
+    if pause > maxPause then
+        maxPause = pause
+    end
+end
+local elapsed = os_clock() - start
+
+print(string_format("%-12s %10d", "frames", FRAMES))
+print(string_format("%-12s %10d", "matrices", FRAMES * PER_FRAME * 4))
+print(string_format("%-12s %10.3f s", "elapsed", elapsed))
+print(string_format("%-12s %10.3f ms", "max step", maxPause * 1e3))
+if hasPool then
+    local pooled, hits, misses = collectgarbage("pool")
+    print(string_format("%-12s %10d", "pooled", pooled))
+    print(string_format("%-12s %10d", "pool hits", hits))
+    print(string_format("%-12s %10d", "pool misses", misses))
+end
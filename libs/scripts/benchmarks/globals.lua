@@ -0,0 +1,57 @@
+--[[
+    Global variable microbenchmark.
+
+    Measures the throughput of global reads and writes, i.e., OP_GETTABUP and
+    OP_SETTABUP on '_ENV', against the 'local vec3 = vec3' caching idiom. Each
+    case references globals commonly found in scripts: constructors (vec3,
+    quat) and library tables (glm, math).
+
+@USAGE
+    lua globals.lua [iterations]
+
+@LICENSE
+    It's yours, I don't want it.
+--]]
+local ITERATIONS = math.tointeger(tonumber(arg and arg[1] or nil)) or 20000000
+
+local os_clock = os.clock
+local string_format = string.format
+
+counter = 0
+
+-- { name, function }
+local cases = {
+    { "global vec3",
+        function(n) local r for _ = 1, n do r = vec3 end return r end },
+    { "local vec3",
+        function(n) local vec3 = vec3 local r for _ = 1, n do r = vec3 end return r end },
+    { "global 4x",
+        function(n) local r for _ = 1, n do r = vec3 r = quat r = glm r = math end return r end },
+    { "local 4x",
+        function(n)
+            local vec3, quat, glm, math = vec3, quat, glm, math
+            local r for _ = 1, n do r = vec3 r = quat r = glm r = math end return r
+        end },
+    { "global write",
+        function(n) for i = 1, n do counter = i end end },
+}
+
+-- Best throughput of SLICES runs: global accesses are short enough for the
+-- results to be dominated by scheduling noise otherwise.
+local SLICES = 10
+local function measure(F)
+    local n, best = ITERATIONS // SLICES, 0
+    collectgarbage()
+    for _ = 1, SLICES do
+        local start = os_clock()
+        F(n)
+        best = math.max(best, n / (os_clock() - start) / 1e6)
+    end
+    return best
+end
+
+print(string_format("%-16s %12s", "case", "Mi/s"))
+for i = 1, #cases do
+    local c = cases[i]
+    print(string_format("%-16s %12.2f", c[1], measure(c[2])))
+end
@@ -0,0 +1,93 @@
+--[[
+    Baseline JIT microbenchmark.
+
+    Scalar kernels dominated by the instructions compiled into native code
+    (numeric for loops, integer/float arithmetic, comparisons, and array
+    reads/writes) along with a recursive call. Compare a build with
+    LUAGLM_EXT_JIT against one without it; the GLM library is not needed.
+
+@USAGE
+    lua jit.lua [scale]
+
+@LICENSE
+    It's yours, I don't want it.
+--]]
+local SCALE = tonumber(arg and arg[1] or nil) or 1
+
+local os_clock = os.clock
+local string_format = string.format
+
+-- Insertion sort of a pseudo-random integer array
+local function isort(n)
+    local a, x = {}, 42
+    for i = 1, n do
+        x = (x * 1103515245 + 12345) % 2147483648
+        a[i] = x
+    end
+    for i = 2, n do
+        local v, j = a[i], i - 1
+        while j >= 1 and a[j] > v do
+            a[j + 1] = a[j]
+            j = j - 1
+        end
+        a[j + 1] = v
+    end
+    for i = 2, n do assert(a[i - 1] <= a[i]) end
+end
+
+-- Sieve of Eratosthenes
+local function sieve(n)
+    local count = 0
+    for _ = 1, 10 do
+        local p = {}
+        for i = 1, n do p[i] = true end
+        count = 0
+        for i = 2, n do
+            if p[i] then
+                count = count + 1
+                for j = i + i, n, i do p[j] = false end
+            end
+        end
+    end
+    return count
+end
+
+-- Mandelbrot set membership (float arithmetic)
+local function mandel(n)
+    local inside = 0
+    for y = 0, n - 1 do
+        local ci = 2.0 * y / n - 1.0
+        for x = 0, n - 1 do
+            local cr = 2.5 * x / n - 2.0
+            local zr, zi, k = 0.0, 0.0, 0
+            while k < 50 and zr * zr + zi * zi <= 4.0 do
+                zr, zi = zr * zr - zi * zi + cr, 2.0 * zr * zi + ci
+                k = k + 1
+            end
+            if k == 50 then inside = inside + 1 end
+        end
+    end
+    return inside
+end
+
+local function fib(n)
+    if n < 2 then return n end
+    return fib(n - 1) + fib(n - 2)
+end
+
+-- { name, function, argument }
+local cases = {
+    { "insertion sort", isort, math.floor(3000 * SCALE) },
+    { "sieve", sieve, math.floor(200000 * SCALE) },
+    { "mandelbrot", mandel, math.floor(250 * SCALE) },
+    { "fib", fib, 27 },
+}
+
+print(string_format("%-16s %10s", "case", "seconds"))
+for i = 1, #cases do
+    local c = cases[i]
+    collectgarbage()
+    local start = os_clock()
+    c[2](c[3])
+    print(string_format("%-16s %10.3f", c[1], os_clock() - start))
+end
@@ -0,0 +1,78 @@
+--[[
+    Matrix footprint benchmark.
+
+    Holds a palette of mixed matrices (by default 100,000 in the proportions
+    of a skinning/scene workload: mat3x4 bone palettes, mat3x3 normal
+    matrices, mat4x3 affine transforms, and mat4x4 world matrices) and
+    reports the retained memory per matrix for each type and for the mix,
+    i.e., the size of the collectable object plus the array slot referencing
+    it. Collectable matrices are sized to their dimensions; compare against a
+    runtime where every matrix object stores a full lua_Mat4.
+
+    The second column of the report is the time required to read every
+    column of the palette once.
+
+@USAGE
+    lua matrices.lua [count]
+
+@LICENSE
+    It's yours, I don't want it.
+--]]
+local COUNT = math.tointeger(tonumber(arg and arg[1] or nil)) or 100000
+
+local os_clock = os.clock
+local string_format = string.format
+
+local mat3x3 = mat3x3
+local mat3x4 = mat3x4
+local mat4x3 = mat4x3
+local mat4x4 = mat4x4
+
+local types = {
+    { "mat3x4", 4, function(i) return mat3x4(i) end },
+    { "mat3x3", 2, function(i) return mat3x3(i) end },
+    { "mat4x3", 1, function(i) return mat4x3(i) end },
+    { "mat4x4", 1, function(i) return mat4x4(i) end },
+}
+
+local function measure(F, n)
+    collectgarbage()
+    collectgarbage()
+    local memory = collectgarbage("count")
+    local palette = F(n)
+    collectgarbage()
+    local retained = (collectgarbage("count") - memory) * 1024.0 / n
+
+    local start = os_clock()
+    for i = 1, #palette do
+        local m = palette[i]
+        for c = 1, #m do local _ = m[c] end
+    end
+    return retained, os_clock() - start
+end
+
+print(string_format("%-8s %10s %12s %10s", "type", "n", "retained", "read"))
+
+for i = 1, #types do
+    local t = types[i]
+    local retained, elapsed = measure(function(n)
+        local palette = { }
+        for j = 1, n do palette[j] = t[3](j) end
+        return palette
+    end, COUNT)
+    print(string_format("%-8s %10d %10.1f B %8.3f s", t[1], COUNT, retained, elapsed))
+end
+
+local retained, elapsed = measure(function(n)
+    local palette, j = { }, 1
+    while j <= n do
+        for i = 1, #types do
+            for _ = 1, types[i][2] do
+                if j <= n then palette[j] = types[i][3](j) end
+                j = j + 1
+            end
+        end
+    end
+    return palette
+end, COUNT)
+print(string_format("%-8s %10d %10.1f B %8.3f s", "mixed", COUNT, retained, elapsed))
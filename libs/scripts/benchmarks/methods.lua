@@ -0,0 +1,59 @@
+--[[
+    Vector/matrix method-call microbenchmark.
+
+    Compares method calls on vector and matrix receivers, e.g., "v:length()",
+    whose functions are resolved through the shared vector/matrix metatable
+    (the glm library when compiled with LUAGLM_INSTALL_METATABLES), against
+    calling the same function through a local. OP_SELF caches the resolved
+    method per instruction, so both columns should be comparable.
+
+@USAGE
+    lua methods.lua [iterations]
+
+@LICENSE
+    It's yours, I don't want it.
+--]]
+local ITERATIONS = math.tointeger(tonumber(arg and arg[1] or nil)) or 10000000
+
+local os_clock = os.clock
+local string_format = string.format
+
+local v = vec3(1, 2, 3)
+local m = mat(vec3(1, 0, 0), vec3(0, 2, 0), vec3(0, 0, 4))
+assert(debug.getmetatable(v) and debug.getmetatable(m), "vector/matrix metatables are not installed")
+
+local length = v.length
+local transpose = m.transpose
+
+local cases = {
+    { "length(v)", function(n)
+        local r = 0
+        for _ = 1, n do r = length(v) end
+        return r
+    end },
+    { "v:length()", function(n)
+        local r = 0
+        for _ = 1, n do r = v:length() end
+        return r
+    end },
+    { "transpose(m)", function(n)
+        local r = nil
+        for _ = 1, n do r = transpose(m) end
+        return r
+    end },
+    { "m:transpose()", function(n)
+        local r = nil
+        for _ = 1, n do r = m:transpose() end
+        return r
+    end },
+}
+
+print(string_format("%-16s %12s %10s %12s", "case", "n", "time", "Mi/s"))
+for i = 1, #cases do
+    local name, F = cases[i][1], cases[i][2]
+    collectgarbage()
+    local start = os_clock()
+    F(ITERATIONS)
+    local elapsed = os_clock() - start
+    print(string_format("%-16s %12d %8.3f s %12.2f", name, ITERATIONS, elapsed, ITERATIONS / elapsed / 1e6))
+end
@@ -0,0 +1,66 @@
+--[[
+    Global variable benchmark on a real script.
+
+    Renders a small image with examples/smallpt.lua twice: as written, with the
+    'local vec3 = vec3' alias, and with that line removed so that every vector
+    constructed by the path tracer reads 'vec3' as a global (OP_GETTABUP). The
+    difference between both runs is the cost of global reads in a workload
+    dominated by vector arithmetic.
+
+@USAGE
+    lua smallpt.lua [samples] [scene]
+
+@LICENSE
+    It's yours, I don't want it.
+--]]
+local SAMPLES = math.tointeger(tonumber(arg and arg[1] or nil)) or 4
+local SCENE = arg and arg[2] or "cornellbox"
+
+local os_clock = os.clock
+local string_format = string.format
+
+local dir = (arg and arg[0] or ""):match("^(.*)[/\\]") or "."
+local file = assert(io.open(dir .. "/../examples/smallpt.lua", "rb"))
+local source = file:read("a")
+file:close()
+
+-- Shrink the image: the relative cost of global reads does not depend on it.
+source = source:gsub("width = 1024/2", "width = 128")
+               :gsub("height = 768/2", "height = 96")
+               :gsub("samples = 32", "samples = " .. SAMPLES)
+
+local global, n = source:gsub("\nlocal vec3 = vec3\r?\n", "\n")
+assert(n == 1, "smallpt.lua no longer aliases vec3")
+
+-- { name, source }
+local cases = {
+    { "local vec3", source },
+    { "global vec3", global },
+}
+
+-- Best time of RUNS renders of each case, interleaved. Progress and
+-- statistics of the renderer are discarded.
+local RUNS = 3
+local output = os.tmpname()
+local quiet = { write = function() end, flush = function() end }
+local best = { }
+for _ = 1, RUNS do
+    for i = 1, #cases do
+        local c = cases[i]
+        local chunk = assert(load(c[2], "=smallpt.lua"))
+        local args, prints, stdout = arg, print, io.stdout
+        arg, print, io.stdout = { [0] = "smallpt.lua", SCENE, output }, quiet.write, quiet
+        collectgarbage()
+        local start = os_clock()
+        chunk()
+        local elapsed = os_clock() - start
+        arg, print, io.stdout = args, prints, stdout
+        best[i] = math.min(best[i] or math.huge, elapsed)
+    end
+end
+os.remove(output)
+
+print(string_format("%-16s %12s", "case", "seconds"))
+for i = 1, #cases do
+    print(string_format("%-16s %12.3f", cases[i][1], best[i]))
+end
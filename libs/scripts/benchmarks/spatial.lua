@@ -0,0 +1,134 @@
+--[[
+    Spatial index benchmark.
+
+    Indexes a grid of AABBs (the default 385x385 grid is 148,225 objects) with
+    the scripted KDTree/Octree (libs/scripts/spatial) and the native glm.spatial
+    BVH/Octree (requires LUAGLM_INCLUDE_GEOM). Reports the build time, memory,
+    and the time spent for an identical set of point, ray, collision, sphere,
+    and nearest-neighbor queries.
+
+@USAGE
+    lua spatial.lua [grid size] [queries]
+
+@LICENSE
+    It's yours, I don't want it.
+--]]
+local SIZE = math.tointeger(tonumber(arg and arg[1] or nil)) or 385
+local QUERIES = math.tointeger(tonumber(arg and arg[2] or nil)) or 10000
+
+local os_clock = os.clock
+local string_format = string.format
+
+local vec3 = vec3
+local spatial = glm.spatial
+if not spatial then
+    error("glm.spatial requires a runtime compiled with LUAGLM_INCLUDE_GEOM")
+end
+
+-- Scripted implementations are relative to this script
+local root = (arg and arg[0] or ""):match("^(.-)[^/\\]*$") or ""
+package.path = root .. "../spatial/?.lua;" .. package.path
+
+local Interval = require('sat')
+local KDTree = require('kdtree')
+local Octree = require('octree')
+local OrderedList = require('orderedlist')
+
+-- Dataset: a heightfield of unit tiles.
+math.randomseed(0x5EED)
+local minBounds, maxBounds = { }, { }
+for x = 1, SIZE do
+    for z = 1, SIZE do
+        local i = #minBounds + 1
+        local h = math.random() * 4.0
+        minBounds[i] = vec3(x - 1, -h, z - 1)
+        maxBounds[i] = vec3(x, h, z)
+    end
+end
+
+-- Queries: identical for each index.
+local points, origins, directions, radii = { }, { }, { }, { }
+for i = 1, QUERIES do
+    points[i] = vec3(math.random() * SIZE, math.random() * 2.0 - 1.0, math.random() * SIZE)
+    origins[i] = vec3(math.random() * SIZE, 8.0, math.random() * SIZE)
+    directions[i] = glm.normalize(vec3(math.random() - 0.5, -1.0, math.random() - 0.5))
+    radii[i] = 0.5 + math.random() * 2.0
+end
+
+local function measure(F)
+    collectgarbage()
+    collectgarbage()
+    local memory = collectgarbage("count")
+    local start = os_clock()
+    local result = F()
+    return result, os_clock() - start, collectgarbage("count") - memory
+end
+
+local builders = {
+    { "KDTree", function()
+        local intervals = Interval(Interval.SurfaceAreaHeuristic())
+        for i = 1, #minBounds do
+            intervals:AppendBounds(i, minBounds[i], maxBounds[i])
+        end
+        return KDTree():Build(intervals):Immutable()
+    end },
+    { "Octree", function()
+        local center, length, minSize = Octree.EstimateParameters(minBounds, maxBounds)
+        local tree = Octree(center, 16, length, minSize, 1.25)
+        for i = 1, #minBounds do
+            tree:Insert(i, minBounds[i], maxBounds[i])
+        end
+        return tree
+    end },
+    { "glm.spatial.bvh", function()
+        local tree = spatial.bvh()
+        for i = 1, #minBounds do
+            tree:Insert(i, minBounds[i], maxBounds[i])
+        end
+        return tree:Rebuild()
+    end },
+    { "glm.spatial.octree", function()
+        local tree = spatial.octree(vec3(SIZE * 0.5, 0, SIZE * 0.5), 16, SIZE, 1.0, 1.25)
+        for i = 1, #minBounds do
+            tree:Insert(i, minBounds[i], maxBounds[i])
+        end
+        return tree
+    end },
+}
+
+print(string_format("%-20s %8s %10s %10s %10s %10s %10s %10s %10s",
+    "index", "objects", "build", "memory", "query", "raycast", "colliding", "sphere", "nearest"))
+
+for _, builder in ipairs(builders) do
+    local name, build = builder[1], builder[2]
+    local tree, buildTime, memory = measure(build)
+    if tree.Statistics then
+        memory = memory + tree:Statistics().memory / 1024.0
+    end
+
+    local hits = 0
+    local function yield() hits = hits + 1 end
+    local cache = tree:CreateQueryCache()
+    local _, query = measure(function()
+        for i = 1, QUERIES do tree:Query(cache, points[i], yield) end
+    end)
+    local _, raycast = measure(function()
+        for i = 1, QUERIES do tree:Raycast(cache, origins[i], directions[i], yield) end
+    end)
+    local _, colliding = measure(function()
+        for i = 1, QUERIES do
+            local p = points[i]
+            tree:Colliding(cache, p - vec3(1.0), p + vec3(1.0), yield)
+        end
+    end)
+    local _, sphere = measure(function()
+        for i = 1, QUERIES do tree:SphereIntersection(cache, points[i], radii[i], yield) end
+    end)
+    local _, nearest = measure(function()
+        local list = OrderedList(8)
+        for i = 1, QUERIES do tree:NearestNeighbors(cache, points[i], list:Clear()) end
+    end)
+
+    print(string_format("%-20s %8d %8.3f s %7.1f MB %8.3f s %8.3f s %8.3f s %8.3f s %8.3f s",
+        name, #minBounds, buildTime, memory / 1024.0, query, raycast, colliding, sphere, nearest))
+end
@@ -0,0 +1,73 @@
+--[[
+    Vector swizzle microbenchmark.
+
+    Measures the throughput of field access on vectors with single-component
+    keys ("v.x") and 2-, 3-, and 4-component swizzles ("v.yx", "v.zyx",
+    "v.wzyx") in the style of camera/physics scripts. Multi-component swizzles
+    are decoded once per interned string and resolved by the OP_GETFIELD fast
+    path; the "dynamic" case indexes with a non-constant key (OP_GETTABLE) and
+    goes through glmVec_get.
+
+@USAGE
+    lua swizzle.lua [iterations]
+
+@LICENSE
+    It's yours, I don't want it.
+--]]
+local ITERATIONS = math.tointeger(tonumber(arg and arg[1] or nil)) or 10000000
+
+local os_clock = os.clock
+local string_format = string.format
+
+local vec2 = vec2
+local vec3 = vec3
+local vec4 = vec4
+
+local cases = {
+    { "v.x (vec3)", function(n)
+        local v, s = vec3(1, 2, 3), 0
+        for _ = 1, n do s = s + v.x end
+        return s
+    end },
+    { "v.yx (vec2)", function(n)
+        local v, r = vec2(1, 2), nil
+        for _ = 1, n do r = v.yx end
+        return r
+    end },
+    { "v.xy (vec3)", function(n)
+        local v, r = vec3(1, 2, 3), nil
+        for _ = 1, n do r = v.xy end
+        return r
+    end },
+    { "v.zyx (vec3)", function(n)
+        local v, r = vec3(1, 2, 3), nil
+        for _ = 1, n do r = v.zyx end
+        return r
+    end },
+    { "v.xyz (vec4)", function(n)
+        local v, r = vec4(1, 2, 3, 4), nil
+        for _ = 1, n do r = v.xyz end
+        return r
+    end },
+    { "v.wzyx (vec4)", function(n)
+        local v, r = vec4(1, 2, 3, 4), nil
+        for _ = 1, n do r = v.wzyx end
+        return r
+    end },
+    { "v[k] (dynamic)", function(n)
+        local v, r = vec3(1, 2, 3), nil
+        local keys = { "xy", "zyx", "xz" }
+        for i = 1, n do r = v[keys[i % 3 + 1]] end
+        return r
+    end },
+}
+
+print(string_format("%-16s %12s %10s %12s", "case", "n", "time", "Mi/s"))
+for i = 1, #cases do
+    local name, F = cases[i][1], cases[i][2]
+    collectgarbage()
+    local start = os_clock()
+    F(ITERATIONS)
+    local elapsed = os_clock() - start
+    print(string_format("%-16s %12d %8.3f s %12.2f", name, ITERATIONS, elapsed, ITERATIONS / elapsed / 1e6))
+end
@@ -789,7 +789,7 @@ end
 --[[ @OVERRIDE --]]
 local RecursiveNeighborSearch = nil
 function KDTree:NearestNeighbors(_, point, neighborList)
-    if neighborList.maxSize < 1 then
+    if neighborList:GetMaximumSize() < 1 then
         return neighborList
     end
 
@@ -823,12 +823,12 @@ RecursiveNeighborSearch = function(self, node, point, neighborList)
         --  (1) not enough nearest-neighbors;
         --  (2) distance to test point on the axis is less than the worst
         --      distance of neighborList (axes could be equal).
-        if #neighborList.data < neighborList.maxSize then
+        if #neighborList < neighborList:GetMaximumSize() then
             if low then RecursiveNeighborSearch(self, low, point, neighborList) end
             if high then RecursiveNeighborSearch(self, high, point, neighborList) end
-        elseif low and glm_abs(cardinal[2] - point[axis]) <= (neighborList.worstDist + glm_feps) then
+        elseif low and glm_abs(cardinal[2] - point[axis]) <= (neighborList:GetWorstDistance() + glm_feps) then
             RecursiveNeighborSearch(self, low, point, neighborList)
-        elseif high and glm_abs(cardinal[3] - point[axis]) <= (neighborList.worstDist + glm_feps) then
+        elseif high and glm_abs(cardinal[3] - point[axis]) <= (neighborList:GetWorstDistance() + glm_feps) then
             RecursiveNeighborSearch(self, high, point, neighborList)
         end
         return neighborList
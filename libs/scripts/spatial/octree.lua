@@ -785,7 +785,7 @@ end
 --[[ @OVERRIDE --]]
 local RecursiveNeighborSearch = nil
 function Octree:NearestNeighbors(_, point, neighborList)
-    if neighborList.maxSize < 1 then
+    if neighborList:GetMaximumSize() < 1 then
         return neighborList
     end
 
@@ -831,8 +831,8 @@ RecursiveNeighborSearch = function(self, node, point, neighborList)
             end
 
             if nextBest > 0 and (
-                #neighborList.data < neighborList.maxSize
-                or (nextDist <= (neighborList.worstDist + glm.feps))
+                #neighborList < neighborList:GetMaximumSize()
+                or (nextDist <= (neighborList:GetWorstDistance() + glm.feps))
             ) then
                 RecursiveNeighborSearch(self, children[nextBest], point, neighborList)
                 visited = visited | (1 << nextBest) -- mark as visited
@@ -2,12 +2,18 @@
     A bounded collection of values ordered by some numeric score, i.e.,
     <item, distance> pairs.
 
+    The native implementation, glm.orderedlist, is returned when available. It
+    shares this interface but does not deduplicate items.
+
 @LICENSE
     It's yours, I don't want it.
 --]]
 local OrderedList
 
 local glm = glm
+if glm and glm.orderedlist then
+    return glm.orderedlist
+end
 
 local table = table
 local table_insert = table.insert
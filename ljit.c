@@ -0,0 +1,1156 @@
+/*
+** $Id: ljit.c $
+** Baseline compiler of Lua functions into x86-64 machine code
+** See Copyright Notice in lua.h
+*/
+
+#define ljit_c
+#define LUA_CORE
+
+#if !defined(_DEFAULT_SOURCE)
+#define _DEFAULT_SOURCE  /* for MAP_ANONYMOUS */
+#endif
+
+#include "lprefix.h"
+
+
+#include <stddef.h>
+#include <string.h>
+
+#include "lua.h"
+
+#include "ljit.h"
+
+
+#if defined(LUAGLM_EXT_JIT)
+
+#include <sys/mman.h>
+
+#include "lgc.h"
+#include "lobject.h"
+#include "lopcodes.h"
+#include "lstate.h"
+
+
+/*
+** The code of a function is the concatenation of one stencil per
+** instruction. A stencil is a fixed sequence of machine instructions whose
+** holes (register offsets, constants, and jump targets) are patched with
+** the operands of the Lua instruction it implements. Stencils only cover
+** fast paths that cannot raise errors, allocate memory, or call anything;
+** every other case leaves native code, returning the instruction that
+** 'luaV_execute' must interpret. The interpreter comes back to native code
+** right after an instruction without a stencil, and at the next back jump
+** or return after a failed fast path.
+**
+** Native code runs with
+**   rbx: 'base' of the frame;  r12: the closure;
+**   r13: the CallInfo;         r14: the lua_State;
+** and returns (in rax) the next instruction to interpret, or NULL when
+** the function already returned.
+*/
+
+
+/* enters native code at address 'code' */
+typedef const Instruction *(*JitFunction) (lua_State *L, StkId base,
+                                           LClosure *cl, CallInfo *ci,
+                                           const lu_byte *code);
+
+
+/*
+** Native code of a function: a private mapping with this header, the entry
+** point of each instruction (offsets from the start of the mapping), and
+** the code itself.
+*/
+typedef struct JitCode {
+  size_t size;  /* size of the mapping */
+  JitFunction run;  /* prologue */
+  unsigned int entry[1];
+} JitCode;
+
+
+/* entry flags: instruction has no stencil; its stencil checks types */
+#define JITEXIT		0x80000000u
+#define JITTYPED	0x40000000u
+
+#define entryaddr(jc,e)	(cast(lu_byte *, jc) + ((e) & ~(JITEXIT | JITTYPED)))
+
+
+#define entryoffset(p)  \
+  ((offsetof(JitCode, entry) + sizeof(unsigned int) * (p)->sizecode + 15) \
+    & ~cast_sizet(15))
+
+
+/* maximum number of failure checks in one stencil */
+#define MAXFAILS	8
+
+
+typedef struct JitState {
+  Proto *p;
+  global_State *g;
+  JitCode *jc;  /* code being generated; NULL when only measuring it */
+  lu_byte *code;  /* 'jc' as an array of bytes */
+  size_t n;  /* current position */
+  size_t epilogue;  /* position of the epilogue */
+  int pc;  /* instruction being compiled */
+  int typed;  /* failures of current stencil mean unexpected types */
+  int nfails;  /* number of pending failure checks */
+  size_t fails[MAXFAILS];  /* failure checks of current stencil */
+} JitState;
+
+
+/*
+** {==================================================================
+** Encoder
+** ===================================================================
+*/
+
+enum { RAX, RCX, RDX, RBX, RSP, RBP, RSI, RDI,
+       R8, R9, R10, R11, R12, R13, R14, R15 };
+
+#define RBASE	RBX
+#define RCL	R12
+#define RCI	R13
+#define RL	R14
+
+/* condition codes */
+#define CC_B	0x2
+#define CC_AE	0x3
+#define CC_E	0x4
+#define CC_NE	0x5
+#define CC_BE	0x6
+#define CC_A	0x7
+#define CC_S	0x8
+#define CC_NS	0x9
+#define CC_NP	0xB
+#define CC_L	0xC
+#define CC_LE	0xE
+#define CC_G	0xF
+#define CC_ALWAYS	(-1)
+
+
+/* displacement of register 'r' from 'base' */
+#define RD(r)	(cast_int(sizeof(StackValue)) * (r))
+
+/* displacement of the tag of a value */
+#define TT	cast_int(offsetof(TValue, tt_))
+
+
+static void emit (JitState *J, int b) {
+  if (J->code != NULL)
+    J->code[J->n] = cast_byte(b);
+  J->n++;
+}
+
+
+static void emit32 (JitState *J, unsigned int v) {
+  int i;
+  for (i = 0; i < 4; i++, v >>= 8)
+    emit(J, cast_int(v & 0xFF));
+}
+
+
+static void emit64 (JitState *J, lua_Unsigned v) {
+  int i;
+  for (i = 0; i < 8; i++, v >>= 8)
+    emit(J, cast_int(v & 0xFF));
+}
+
+
+/*
+** Emit the prefixes and opcode 'op' (one or two bytes) of an instruction
+** with operands 'reg' and 'rm'; 'w' selects 64-bit operands.
+*/
+static void opcode (JitState *J, int pfx, int w, int op, int reg, int rm) {
+  int rex = 0x40 | (w << 3) | ((reg & 8) >> 1) | ((rm & 8) >> 3);
+  if (pfx)
+    emit(J, pfx);
+  if (rex != 0x40)
+    emit(J, rex);
+  if (op > 0xFF)
+    emit(J, op >> 8);
+  emit(J, op & 0xFF);
+}
+
+
+/* instruction with a register-direct operand: op reg, rm */
+static void opr (JitState *J, int pfx, int w, int op, int reg, int rm) {
+  opcode(J, pfx, w, op, reg, rm);
+  emit(J, 0xC0 | ((reg & 7) << 3) | (rm & 7));
+}
+
+
+/* instruction with a memory operand: op reg, [base + disp] */
+static void opm (JitState *J, int pfx, int w, int op, int reg, int base,
+                 int disp) {
+  opcode(J, pfx, w, op, reg, base);
+  emit(J, 0x80 | ((reg & 7) << 3) | (base & 7));
+  if ((base & 7) == RSP)
+    emit(J, 0x24);  /* SIB byte for 'rsp'/'r12' */
+  emit32(J, cast_uint(disp));
+}
+
+
+#define ldq(J,r,b,d)	opm(J, 0, 1, 0x8B, r, b, d)  /* mov r64, [m] */
+#define stq(J,r,b,d)	opm(J, 0, 1, 0x89, r, b, d)  /* mov [m], r64 */
+#define ldb(J,r,b,d)	opm(J, 0, 0, 0x0FB6, r, b, d)  /* movzx r32, b[m] */
+#define stb(J,r,b,d)	opm(J, 0, 0, 0x88, r, b, d)  /* mov b[m], r8 */
+#define ldsd(J,x,b,d)	opm(J, 0xF2, 0, 0x0F10, x, b, d)  /* movsd x, [m] */
+#define stsd(J,x,b,d)	opm(J, 0xF2, 0, 0x0F11, x, b, d)  /* movsd [m], x */
+#define cvtsd(J,x,b,d)	opm(J, 0xF2, 1, 0x0F2A, x, b, d)  /* cvtsi2sd */
+
+
+/* mov byte [base + disp], imm */
+static void movb (JitState *J, int base, int disp, int imm) {
+  opm(J, 0, 0, 0xC6, 0, base, disp);
+  emit(J, imm);
+}
+
+
+/* cmp byte [base + disp], imm */
+static void cmpb (JitState *J, int base, int disp, int imm) {
+  opm(J, 0, 0, 0x80, 7, base, disp);
+  emit(J, imm);
+}
+
+
+/* test byte [base + disp], imm */
+static void testb (JitState *J, int base, int disp, int imm) {
+  opm(J, 0, 0, 0xF6, 0, base, disp);
+  emit(J, imm);
+}
+
+
+/* mov r64, imm64 */
+static void movimm (JitState *J, int r, lua_Unsigned imm) {
+  opcode(J, 0, 1, 0xB8 + (r & 7), 0, r);
+  emit64(J, imm);
+}
+
+
+/* mov xmm, imm (a float) */
+static void movfimm (JitState *J, int x, lua_Number n) {
+  lua_Unsigned bits;
+  memcpy(&bits, &n, sizeof(bits));
+  movimm(J, RAX, bits);
+  opr(J, 0x66, 1, 0x0F6E, x, RAX);  /* movq x, rax */
+}
+
+
+/* store a value with tag 'tt' and 64-bit payload 'imm' into 'R[r]' */
+static void storeimm (JitState *J, int r, lua_Unsigned imm, int tt) {
+  movimm(J, RAX, imm);
+  stq(J, RAX, RBASE, RD(r));
+  movb(J, RBASE, RD(r) + TT, tt);
+}
+
+
+/*
+** Copy the value at 'sb + sd' to 'db + dd'. Only the value and the tag are
+** copied, as the rest of a stack slot may hold other data.
+*/
+static void copyvalue (JitState *J, int db, int dd, int sb, int sd) {
+  int off;
+  for (off = 0; off < cast_int(sizeof(Value)); off += 8) {
+    ldq(J, RCX, sb, sd + off);
+    stq(J, RCX, db, dd + off);
+  }
+  ldb(J, RCX, sb, sd + TT);
+  stb(J, RCX, db, dd + TT);
+}
+
+
+/* position where native code of instruction 'pc' starts */
+static size_t entrypoint (JitState *J, int pc) {
+  if (J->jc == NULL)  /* only measuring? */
+    return 0;
+  else
+    return cast_sizet(entryaddr(J->jc, J->jc->entry[pc]) - J->code);
+}
+
+
+/*
+** Jumps use 32-bit displacements, so their sizes do not depend on their
+** targets, which are only known after code was generated once.
+*/
+static void jmpto (JitState *J, int cc, size_t target) {
+  if (cc == CC_ALWAYS)
+    emit(J, 0xE9);
+  else {
+    emit(J, 0x0F);
+    emit(J, 0x80 | cc);
+  }
+  emit32(J, cast_uint(target - (J->n + 4)));
+}
+
+
+/* forward jump to a yet unknown position; see 'here' */
+static size_t jmpfwd (JitState *J, int cc) {
+  jmpto(J, cc, J->n + 4);
+  return J->n;
+}
+
+
+/* make the forward jump ending at 'j' go to the current position */
+static void here (JitState *J, size_t j) {
+  if (J->code != NULL) {
+    unsigned int rel = cast_uint(J->n - j);
+    int i;
+    for (i = 0; i < 4; i++, rel >>= 8)
+      J->code[j - 4 + i] = cast_byte(rel & 0xFF);
+  }
+}
+
+
+/* leave native code to interpret instruction 'pc' */
+static void exitto (JitState *J, int pc) {
+  movimm(J, RAX, cast(lua_Unsigned, cast_sizet(J->p->code + pc)));
+  jmpto(J, CC_ALWAYS, J->epilogue);
+}
+
+
+/* leave native code when condition 'cc' holds (fast path failed) */
+static void fail (JitState *J, int cc) {
+  lua_assert(J->nfails < MAXFAILS);
+  J->fails[J->nfails++] = jmpfwd(J, cc);
+}
+
+
+/*
+** Go to instruction 'pc'. Backward jumps check 'trap', so that hooks and
+** signals can stop loops running in native code.
+*/
+static void jumpto (JitState *J, int pc) {
+  if (pc <= J->pc) {
+    opm(J, 0, 0, 0x83, 7, RCI, cast_int(offsetof(CallInfo, u.l.trap)));
+    emit(J, 0);  /* cmp dword [ci->u.l.trap], 0 */
+    jmpto(J, CC_E, entrypoint(J, pc));
+    exitto(J, pc);
+  }
+  else
+    jmpto(J, CC_ALWAYS, entrypoint(J, pc));
+}
+
+/* }================================================================== */
+
+
+
+/*
+** {==================================================================
+** Stencils
+** ===================================================================
+*/
+
+/* comparison operators */
+#define CMP_LT	0
+#define CMP_LE	1
+#define CMP_EQ	2
+
+
+/* dl = (rax op rcx), as integers */
+static void icmp (JitState *J, int op) {
+  static const int cc[] = {CC_L, CC_LE, CC_E};
+  opr(J, 0, 1, 0x3B, RAX, RCX);  /* cmp rax, rcx */
+  opr(J, 0, 0, 0x0F90 | cc[op], 0, RDX);  /* setcc dl */
+}
+
+
+/* dl = (xmm0 op xmm1), as floats; comparisons with NaN are false */
+static void fcmp (JitState *J, int op) {
+  if (op == CMP_EQ) {
+    opr(J, 0x66, 0, 0x0F2E, 0, 1);  /* ucomisd xmm0, xmm1 */
+    opr(J, 0, 0, 0x0F90 | CC_E, 0, RDX);  /* sete dl */
+    opr(J, 0, 0, 0x0F90 | CC_NP, 0, RAX);  /* setnp al */
+    opr(J, 0, 0, 0x20, RAX, RDX);  /* and dl, al */
+  }
+  else {
+    opr(J, 0x66, 0, 0x0F2E, 1, 0);  /* ucomisd xmm1, xmm0 */
+    opr(J, 0, 0, 0x0F90 | (op == CMP_LT ? CC_A : CC_AE), 0, RDX);
+  }
+}
+
+
+/* dl = (R[x] op R[y]); numbers of different kinds leave native code */
+static void cmpregs (JitState *J, int op, int x, int y) {
+  size_t notint, done;
+  J->typed = 1;
+  cmpb(J, RBASE, RD(x) + TT, LUA_VNUMINT);
+  notint = jmpfwd(J, CC_NE);
+  cmpb(J, RBASE, RD(y) + TT, LUA_VNUMINT);
+  fail(J, CC_NE);
+  ldq(J, RAX, RBASE, RD(x));
+  ldq(J, RCX, RBASE, RD(y));
+  icmp(J, op);
+  done = jmpfwd(J, CC_ALWAYS);
+  here(J, notint);
+  cmpb(J, RBASE, RD(x) + TT, LUA_VNUMFLT);
+  fail(J, CC_NE);
+  cmpb(J, RBASE, RD(y) + TT, LUA_VNUMFLT);
+  fail(J, CC_NE);
+  ldsd(J, 0, RBASE, RD(x));
+  ldsd(J, 1, RBASE, RD(y));
+  fcmp(J, op);
+  here(J, done);
+}
+
+
+/* integer 'i' converts to a float without rounding */
+#define exactfloat(i)  \
+  (l_castS2U(i) + (l_castS2U(1) << 53) <= (l_castS2U(1) << 54))
+
+
+/*
+** dl = (R[x] op v), or (v op R[x]) if 'flip', for a number 'v'. A float
+** register is only compared with an integer 'v' that is exact as a float;
+** an integer register is never compared with a float 'v'. Values other
+** than numbers leave native code if 'other' is CC_ALWAYS, or are different
+** from 'v'.
+*/
+static void cmpnum (JitState *J, int op, int x, const TValue *v, int flip,
+                    int other) {
+  size_t notint, notflt, done1, done2;
+  J->typed = 1;
+  cmpb(J, RBASE, RD(x) + TT, LUA_VNUMINT);
+  notint = jmpfwd(J, CC_NE);
+  if (ttisinteger(v)) {
+    ldq(J, flip ? RCX : RAX, RBASE, RD(x));
+    movimm(J, flip ? RAX : RCX, l_castS2U(ivalue(v)));
+    icmp(J, op);
+  }
+  else
+    fail(J, CC_ALWAYS);
+  done1 = jmpfwd(J, CC_ALWAYS);
+  here(J, notint);
+  cmpb(J, RBASE, RD(x) + TT, LUA_VNUMFLT);
+  notflt = jmpfwd(J, CC_NE);
+  if (ttisfloat(v) || exactfloat(ivalue(v))) {
+    movfimm(J, flip ? 0 : 1, nvalue(v));
+    ldsd(J, flip ? 1 : 0, RBASE, RD(x));
+    fcmp(J, op);
+  }
+  else
+    fail(J, CC_ALWAYS);
+  done2 = jmpfwd(J, CC_ALWAYS);
+  here(J, notflt);
+  if (other == CC_ALWAYS)
+    fail(J, CC_ALWAYS);
+  else
+    opr(J, 0, 0, 0x31, RDX, RDX);  /* xor edx, edx */
+  here(J, done1);
+  here(J, done2);
+}
+
+
+/* dl = l_isfalse(R[x]) */
+static void isfalse (JitState *J, int x) {
+  ldb(J, RAX, RBASE, RD(x) + TT);
+  emit(J, 0x3C); emit(J, LUA_VFALSE);  /* cmp al, LUA_VFALSE */
+  opr(J, 0, 0, 0x0F90 | CC_E, 0, RDX);  /* sete dl */
+  emit(J, 0xA8); emit(J, 0x0F);  /* test al, 0x0F (variant bits of nil) */
+  opr(J, 0, 0, 0x0F90 | CC_E, 0, RCX);  /* sete cl */
+  opr(J, 0, 0, 0x08, RCX, RDX);  /* or dl, cl */
+}
+
+
+/*
+** Conditional jump: the instruction at 'pc + 1' is a jump, taken when the
+** condition in dl equals 'k'.
+*/
+static void condbranch (JitState *J, int k) {
+  Instruction ni = J->p->code[J->pc + 1];
+  lua_assert(GET_OPCODE(ni) == OP_JMP);
+  opr(J, 0, 0, 0x80, 7, RDX);  /* cmp dl, k */
+  emit(J, k);
+  jmpto(J, CC_NE, entrypoint(J, J->pc + 2));
+  jumpto(J, J->pc + 2 + GETARG_sJ(ni));
+}
+
+
+/*
+** Load a number operand into xmm 'x' as a float: either register 'r' or,
+** if 'v' is not NULL, constant 'v'. Other values leave native code.
+*/
+static void loadfloat (JitState *J, int x, int r, const TValue *v) {
+  if (v != NULL)
+    movfimm(J, x, nvalue(v));
+  else {
+    size_t notflt, done;
+    cmpb(J, RBASE, RD(r) + TT, LUA_VNUMFLT);
+    notflt = jmpfwd(J, CC_NE);
+    ldsd(J, x, RBASE, RD(r));
+    done = jmpfwd(J, CC_ALWAYS);
+    here(J, notflt);
+    cmpb(J, RBASE, RD(r) + TT, LUA_VNUMINT);
+    fail(J, CC_NE);
+    cvtsd(J, x, RBASE, RD(r));
+    here(J, done);
+  }
+}
+
+
+/*
+** R[a] = R[b] op (R[c] or constant 'v'), for op in OP_ADD, OP_SUB, OP_MUL,
+** OP_DIV. Integers wrap around; an integer and a float give a float; other
+** values leave native code. When the operation succeeds, the following
+** OP_MMBIN* is skipped.
+*/
+static void arithop (JitState *J, OpCode op, int a, int b, int c,
+                   const TValue *v) {
+  size_t tofloat[2];
+  size_t done = 0;
+  int nf = 0;
+  J->typed = 1;
+  if (op != OP_DIV && (v == NULL || ttisinteger(v))) {  /* integer path */
+    static const int iop[] = {0x03, 0x2B, 0x0FAF};  /* add, sub, imul */
+    cmpb(J, RBASE, RD(b) + TT, LUA_VNUMINT);
+    tofloat[nf++] = jmpfwd(J, CC_NE);
+    ldq(J, RAX, RBASE, RD(b));
+    if (v != NULL)
+      movimm(J, RCX, l_castS2U(ivalue(v)));
+    else {
+      cmpb(J, RBASE, RD(c) + TT, LUA_VNUMINT);
+      tofloat[nf++] = jmpfwd(J, CC_NE);
+      ldq(J, RCX, RBASE, RD(c));
+    }
+    opr(J, 0, 1, iop[op - OP_ADD], RAX, RCX);
+    stq(J, RAX, RBASE, RD(a));
+    movb(J, RBASE, RD(a) + TT, LUA_VNUMINT);
+    done = jmpfwd(J, CC_ALWAYS);
+    while (nf > 0)
+      here(J, tofloat[--nf]);
+  }
+  loadfloat(J, 0, b, NULL);
+  loadfloat(J, 1, c, v);
+  opr(J, 0xF2, 0, 0x0F58 + (op == OP_SUB ? 4 : op == OP_MUL ? 1 :
+                            op == OP_DIV ? 6 : 0), 0, 1);  /* addsd ... */
+  stsd(J, 0, RBASE, RD(a));
+  movb(J, RBASE, RD(a) + TT, LUA_VNUMFLT);
+  if (done != 0)
+    here(J, done);
+  jumpto(J, J->pc + 2);  /* skip OP_MMBIN* */
+}
+
+
+/*
+** Load into 'reg' the integer in register 'r' or, if 'v' is not NULL,
+** constant 'v'. Other values (including floats with integral values)
+** leave native code.
+*/
+static void intoperand (JitState *J, int reg, int r, const TValue *v) {
+  if (v != NULL)
+    movimm(J, reg, l_castS2U(ivalue(v)));
+  else {
+    cmpb(J, RBASE, RD(r) + TT, LUA_VNUMINT);
+    fail(J, CC_NE);
+    ldq(J, reg, RBASE, RD(r));
+  }
+}
+
+
+/* store the integer in rax into 'R[a]' and skip the following OP_MMBIN* */
+static void intresult (JitState *J, int a) {
+  stq(J, RAX, RBASE, RD(a));
+  movb(J, RBASE, RD(a) + TT, LUA_VNUMINT);
+  jumpto(J, J->pc + 2);
+}
+
+
+/*
+** R[a] = R[b] op (R[c] or constant 'v'), for op in OP_MOD, OP_IDIV, on
+** integers (see 'luaV_mod' and 'luaV_idiv'). A zero divisor leaves native
+** code, so that the interpreter raises the error.
+*/
+static void intdiv (JitState *J, OpCode op, int a, int b, int c,
+                    const TValue *v) {
+  size_t special, done[3];
+  intoperand(J, RAX, b, NULL);
+  intoperand(J, RCX, c, v);
+  opm(J, 0, 1, 0x8D, RDX, RCX, 1);  /* lea rdx, [rcx + 1] */
+  opr(J, 0, 1, 0x83, 7, RDX);  /* cmp rdx, 1 */
+  emit(J, 1);
+  special = jmpfwd(J, CC_BE);  /* divisor is 0 or -1? */
+  emit(J, 0x48); emit(J, 0x99);  /* cqo */
+  opr(J, 0, 1, 0xF7, 7, RCX);  /* idiv rcx */
+  if (op == OP_MOD) {  /* correct remainder with sign of divisor */
+    opr(J, 0, 1, 0x8B, RAX, RDX);  /* mov rax, rdx */
+    opr(J, 0, 1, 0x85, RAX, RAX);  /* test rax, rax */
+    done[0] = jmpfwd(J, CC_E);
+    opr(J, 0, 1, 0x33, RDX, RCX);  /* xor rdx, rcx */
+    done[1] = jmpfwd(J, CC_NS);
+    opr(J, 0, 1, 0x03, RAX, RCX);  /* add rax, rcx */
+  }
+  else {  /* round quotient towards minus infinity */
+    opr(J, 0, 1, 0x85, RDX, RDX);  /* test rdx, rdx */
+    done[0] = jmpfwd(J, CC_E);
+    opr(J, 0, 1, 0x33, RDX, RCX);  /* xor rdx, rcx */
+    done[1] = jmpfwd(J, CC_NS);
+    opr(J, 0, 1, 0x83, 5, RAX);  /* sub rax, 1 */
+    emit(J, 1);
+  }
+  done[2] = jmpfwd(J, CC_ALWAYS);
+  here(J, special);
+  opr(J, 0, 1, 0x85, RCX, RCX);  /* test rcx, rcx */
+  fail(J, CC_E);
+  if (op == OP_MOD)
+    opr(J, 0, 0, 0x31, RAX, RAX);  /* xor eax, eax */
+  else
+    opr(J, 0, 1, 0xF7, 3, RAX);  /* neg rax */
+  here(J, done[0]); here(J, done[1]); here(J, done[2]);
+  intresult(J, a);
+}
+
+
+/* rax = luaV_shiftl(rax, rcx) */
+static void shiftl (JitState *J) {
+  size_t zero, right, done[2];
+  opm(J, 0, 1, 0x8D, RDX, RCX, 63);  /* lea rdx, [rcx + 63] */
+  opr(J, 0, 1, 0x81, 7, RDX);  /* cmp rdx, 126 */
+  emit32(J, 126);
+  zero = jmpfwd(J, CC_A);  /* shift of 64 or more bits? */
+  opr(J, 0, 1, 0x85, RCX, RCX);  /* test rcx, rcx */
+  right = jmpfwd(J, CC_S);
+  opr(J, 0, 1, 0xD3, 4, RAX);  /* shl rax, cl */
+  done[0] = jmpfwd(J, CC_ALWAYS);
+  here(J, right);
+  opr(J, 0, 1, 0xF7, 3, RCX);  /* neg rcx */
+  opr(J, 0, 1, 0xD3, 5, RAX);  /* shr rax, cl */
+  done[1] = jmpfwd(J, CC_ALWAYS);
+  here(J, zero);
+  opr(J, 0, 0, 0x31, RAX, RAX);  /* xor eax, eax */
+  here(J, done[0]); here(J, done[1]);
+}
+
+
+/*
+** rax = address of the array slot of table 'R[t]' for key 'R[key]' or, if
+** 'key' is negative, for constant integer key 'ck'; rsi = the table. Keys
+** outside the array part and empty slots leave native code.
+*/
+static void arrayslot (JitState *J, int t, int key, int ck) {
+  cmpb(J, RBASE, RD(t) + TT, ctb(LUA_VTABLE));
+  fail(J, CC_NE);
+  ldq(J, RSI, RBASE, RD(t));
+  if (key >= 0) {
+    cmpb(J, RBASE, RD(key) + TT, LUA_VNUMINT);
+    fail(J, CC_NE);
+    ldq(J, RCX, RBASE, RD(key));
+    opr(J, 0, 1, 0x83, 5, RCX);  /* sub rcx, 1 */
+    emit(J, 1);
+    opm(J, 0, 0, 0x8B, RDX, RSI, cast_int(offsetof(Table, alimit)));
+    opr(J, 0, 1, 0x3B, RCX, RDX);  /* cmp rcx, rdx (unsigned) */
+    fail(J, CC_AE);
+    opr(J, 0, 1, 0x69, RCX, RCX);  /* imul rcx, rcx, sizeof(TValue) */
+    emit32(J, cast_uint(sizeof(TValue)));
+    ldq(J, RAX, RSI, cast_int(offsetof(Table, array)));
+    opr(J, 0, 1, 0x03, RAX, RCX);  /* add rax, rcx */
+  }
+  else {
+    opm(J, 0, 0, 0x81, 7, RSI, cast_int(offsetof(Table, alimit)));
+    emit32(J, cast_uint(ck));  /* cmp dword [alimit], ck */
+    fail(J, CC_B);
+    ldq(J, RAX, RSI, cast_int(offsetof(Table, array)));
+    opm(J, 0, 1, 0x8D, RAX, RAX, cast_int(sizeof(TValue)) * (ck - 1));
+  }
+  testb(J, RAX, TT, 0x0F);  /* empty slot? */
+  fail(J, CC_E);
+}
+
+
+/*
+** Store register 'c' or, if 'v' is not NULL, constant 'v' into the array
+** slot in rax of table rsi (see 'arrayslot'). Read-only tables and stores
+** that would need a barrier leave native code.
+*/
+static void arraystore (JitState *J, int c, const TValue *v) {
+#if defined(LUAGLM_EXT_READONLY)
+  cmpb(J, RSI, cast_int(offsetof(Table, readonly)), 0);
+  fail(J, CC_NE);
+#endif
+  if (v != NULL) {
+    if (iscollectable(v)) {
+      testb(J, RSI, cast_int(offsetof(Table, marked)), bitmask(BLACKBIT));
+      fail(J, CC_NE);
+    }
+    movimm(J, RDX, cast(lua_Unsigned, cast_sizet(v)));
+    copyvalue(J, RAX, 0, RDX, 0);
+  }
+  else {
+    size_t j;
+    testb(J, RBASE, RD(c) + TT, BIT_ISCOLLECTABLE);
+    j = jmpfwd(J, CC_E);
+    testb(J, RSI, cast_int(offsetof(Table, marked)), bitmask(BLACKBIT));
+    fail(J, CC_NE);
+    here(J, j);
+    copyvalue(J, RAX, 0, RBASE, RD(c));
+  }
+}
+
+
+/* FORLOOP: jump back to instruction 'loop' while iterations remain */
+static void forloop (JitState *J, int a, int loop) {
+  size_t notint, done[5];
+  cmpb(J, RBASE, RD(a + 2) + TT, LUA_VNUMINT);
+  notint = jmpfwd(J, CC_NE);
+  ldq(J, RAX, RBASE, RD(a + 1));  /* iteration count */
+  opr(J, 0, 1, 0x85, RAX, RAX);  /* test rax, rax */
+  done[0] = jmpfwd(J, CC_E);
+  opr(J, 0, 1, 0x83, 5, RAX);  /* sub rax, 1 */
+  emit(J, 1);
+  stq(J, RAX, RBASE, RD(a + 1));
+  ldq(J, RAX, RBASE, RD(a));
+  opm(J, 0, 1, 0x03, RAX, RBASE, RD(a + 2));  /* add rax, step */
+  stq(J, RAX, RBASE, RD(a));
+  stq(J, RAX, RBASE, RD(a + 3));
+  movb(J, RBASE, RD(a + 3) + TT, LUA_VNUMINT);
+  jumpto(J, loop);
+  here(J, notint);  /* float loop (see 'floatforloop') */
+  ldsd(J, 0, RBASE, RD(a));
+  opm(J, 0xF2, 0, 0x0F58, 0, RBASE, RD(a + 2));  /* addsd xmm0, step */
+  ldsd(J, 1, RBASE, RD(a + 1));  /* limit */
+  ldsd(J, 2, RBASE, RD(a + 2));  /* step */
+  opr(J, 0x66, 0, 0x0F57, 3, 3);  /* xorpd xmm3, xmm3 */
+  opr(J, 0x66, 0, 0x0F2E, 2, 3);  /* ucomisd step, 0 */
+  done[1] = jmpfwd(J, CC_A);
+  opr(J, 0x66, 0, 0x0F2E, 0, 1);  /* ucomisd idx, limit */
+  done[2] = jmpfwd(J, CC_AE);
+  done[3] = jmpfwd(J, CC_ALWAYS);
+  here(J, done[1]);
+  opr(J, 0x66, 0, 0x0F2E, 1, 0);  /* ucomisd limit, idx */
+  done[4] = jmpfwd(J, CC_B);  /* also when unordered */
+  here(J, done[2]);
+  stsd(J, 0, RBASE, RD(a));
+  stsd(J, 0, RBASE, RD(a + 3));
+  movb(J, RBASE, RD(a + 3) + TT, LUA_VNUMFLT);
+  jumpto(J, loop);
+  here(J, done[0]); here(J, done[3]); here(J, done[4]);
+}
+
+
+/* RETURN0/RETURN1: return 'n' values in the common case */
+static void ret (JitState *J, int a, int n) {
+  size_t none = 0, done = 0;
+  opm(J, 0, 0, 0x83, 7, RL, cast_int(offsetof(lua_State, hookmask)));
+  emit(J, 0);  /* cmp dword [L->hookmask], 0 */
+  fail(J, CC_NE);
+  opm(J, 0, 0, 0x0FBF, RAX, RCI, cast_int(offsetof(CallInfo, nresults)));
+  opr(J, 0, 0, 0x83, 7, RAX);  /* cmp eax, n */
+  emit(J, n);
+  fail(J, CC_G);
+  ldq(J, RCX, RCI, cast_int(offsetof(CallInfo, previous)));
+  stq(J, RCX, RL, cast_int(offsetof(lua_State, ci)));
+  if (n > 0) {
+    opr(J, 0, 0, 0x85, RAX, RAX);  /* test eax, eax */
+    none = jmpfwd(J, CC_E);
+    copyvalue(J, RBASE, RD(-1), RBASE, RD(a));
+    stq(J, RBASE, RL, cast_int(offsetof(lua_State, top)));
+    done = jmpfwd(J, CC_ALWAYS);
+    here(J, none);
+  }
+  opm(J, 0, 1, 0x8D, RCX, RBASE, RD(-1));  /* lea rcx, [base - 1] */
+  stq(J, RCX, RL, cast_int(offsetof(lua_State, top)));
+  if (n > 0)
+    here(J, done);
+  opr(J, 0, 0, 0x31, RAX, RAX);  /* xor eax, eax */
+  jmpto(J, CC_ALWAYS, J->epilogue);
+}
+
+
+/*
+** Emit the stencil of instruction 'i'. Return 0 (and emit nothing) if it
+** has none.
+*/
+static int stencil (JitState *J, Instruction i) {
+  const TValue *k = J->p->k;
+  int pc = J->pc;
+  int a = GETARG_A(i);
+  switch (GET_OPCODE(i)) {
+    case OP_MOVE: {
+      copyvalue(J, RBASE, RD(a), RBASE, RD(GETARG_B(i)));
+      break;
+    }
+    case OP_LOADI: {
+      storeimm(J, a, l_castS2U(GETARG_sBx(i)), LUA_VNUMINT);
+      break;
+    }
+    case OP_LOADF: {
+      lua_Number n = cast_num(GETARG_sBx(i));
+      lua_Unsigned bits;
+      memcpy(&bits, &n, sizeof(bits));
+      storeimm(J, a, bits, LUA_VNUMFLT);
+      break;
+    }
+    case OP_LOADK: {
+      const TValue *v = &k[GETARG_Bx(i)];
+      if (ttisinteger(v))
+        storeimm(J, a, l_castS2U(ivalue(v)), LUA_VNUMINT);
+      else {
+        movimm(J, RDX, cast(lua_Unsigned, cast_sizet(v)));
+        copyvalue(J, RBASE, RD(a), RDX, 0);
+      }
+      break;
+    }
+    case OP_LOADFALSE: {
+      movb(J, RBASE, RD(a) + TT, LUA_VFALSE);
+      break;
+    }
+    case OP_LFALSESKIP: {
+      movb(J, RBASE, RD(a) + TT, LUA_VFALSE);
+      jumpto(J, pc + 2);
+      break;
+    }
+    case OP_LOADTRUE: {
+      movb(J, RBASE, RD(a) + TT, LUA_VTRUE);
+      break;
+    }
+    case OP_LOADNIL: {
+      int b = GETARG_B(i);
+      do {
+        movb(J, RBASE, RD(a++) + TT, LUA_VNIL);
+      } while (b--);
+      break;
+    }
+    case OP_GETUPVAL: {
+      ldq(J, RAX, RCL, cast_int(offsetof(LClosure, upvals) +
+                                sizeof(UpVal *) * GETARG_B(i)));
+      ldq(J, RAX, RAX, cast_int(offsetof(UpVal, v)));
+      copyvalue(J, RBASE, RD(a), RAX, 0);
+      break;
+    }
+    case OP_SETUPVAL: {  /* only values that need no barrier */
+      testb(J, RBASE, RD(a) + TT, BIT_ISCOLLECTABLE);
+      fail(J, CC_NE);
+      ldq(J, RAX, RCL, cast_int(offsetof(LClosure, upvals) +
+                                sizeof(UpVal *) * GETARG_B(i)));
+      ldq(J, RAX, RAX, cast_int(offsetof(UpVal, v)));
+      copyvalue(J, RAX, 0, RBASE, RD(a));
+      break;
+    }
+    case OP_GETTABLE: {
+      arrayslot(J, GETARG_B(i), GETARG_C(i), 0);
+      copyvalue(J, RBASE, RD(a), RAX, 0);
+      break;
+    }
+    case OP_GETI: {
+      if (GETARG_C(i) == 0)  /* never in the array part */
+        return 0;
+      arrayslot(J, GETARG_B(i), -1, GETARG_C(i));
+      copyvalue(J, RBASE, RD(a), RAX, 0);
+      break;
+    }
+    case OP_SETTABLE: {
+      arrayslot(J, a, GETARG_B(i), 0);
+      arraystore(J, GETARG_C(i), TESTARG_k(i) ? &k[GETARG_C(i)] : NULL);
+      break;
+    }
+    case OP_SETI: {
+      if (GETARG_B(i) == 0)  /* never in the array part */
+        return 0;
+      arrayslot(J, a, -1, GETARG_B(i));
+      arraystore(J, GETARG_C(i), TESTARG_k(i) ? &k[GETARG_C(i)] : NULL);
+      break;
+    }
+    case OP_ADDI: {
+      TValue v;
+      setivalue(&v, GETARG_sC(i));
+      arithop(J, OP_ADD, a, GETARG_B(i), 0, &v);
+      break;
+    }
+    case OP_ADDK: case OP_SUBK: case OP_MULK: case OP_DIVK: {
+      const TValue *v = &k[GETARG_C(i)];
+      if (!ttisnumber(v))
+        return 0;
+      arithop(J, cast(OpCode, GET_OPCODE(i) - OP_ADDK + OP_ADD), a,
+               GETARG_B(i), 0, v);
+      break;
+    }
+    case OP_ADD: case OP_SUB: case OP_MUL: case OP_DIV: {
+      arithop(J, GET_OPCODE(i), a, GETARG_B(i), GETARG_C(i), NULL);
+      break;
+    }
+    case OP_MODK: case OP_IDIVK: {
+      const TValue *v = &k[GETARG_C(i)];
+      if (!ttisinteger(v) || ivalue(v) == 0)
+        return 0;
+      intdiv(J, GET_OPCODE(i) == OP_MODK ? OP_MOD : OP_IDIV, a,
+                GETARG_B(i), 0, v);
+      break;
+    }
+    case OP_MOD: case OP_IDIV: {
+      intdiv(J, GET_OPCODE(i), a, GETARG_B(i), GETARG_C(i), NULL);
+      break;
+    }
+    case OP_BANDK: case OP_BORK: case OP_BXORK:
+    case OP_BAND: case OP_BOR: case OP_BXOR: {
+      static const int bop[] = {0x23, 0x0B, 0x33};  /* and, or, xor */
+      int isk = (GET_OPCODE(i) <= OP_BXORK);
+      int op = GET_OPCODE(i) - (isk ? OP_BANDK : OP_BAND);
+      intoperand(J, RAX, GETARG_B(i), NULL);
+      intoperand(J, RCX, GETARG_C(i), isk ? &k[GETARG_C(i)] : NULL);
+      opr(J, 0, 1, bop[op], RAX, RCX);
+      intresult(J, a);
+      break;
+    }
+    case OP_SHL: case OP_SHR: {
+      intoperand(J, RAX, GETARG_B(i), NULL);
+      intoperand(J, RCX, GETARG_C(i), NULL);
+      if (GET_OPCODE(i) == OP_SHR)
+        opr(J, 0, 1, 0xF7, 3, RCX);  /* neg rcx */
+      shiftl(J);
+      intresult(J, a);
+      break;
+    }
+    case OP_SHRI: {
+      intoperand(J, RAX, GETARG_B(i), NULL);
+      movimm(J, RCX, l_castS2U(-GETARG_sC(i)));
+      shiftl(J);
+      intresult(J, a);
+      break;
+    }
+    case OP_SHLI: {
+      movimm(J, RAX, l_castS2U(GETARG_sC(i)));
+      intoperand(J, RCX, GETARG_B(i), NULL);
+      shiftl(J);
+      intresult(J, a);
+      break;
+    }
+    case OP_UNM: {
+      int b = GETARG_B(i);
+      size_t notint, done;
+      J->typed = 1;
+      cmpb(J, RBASE, RD(b) + TT, LUA_VNUMINT);
+      notint = jmpfwd(J, CC_NE);
+      ldq(J, RAX, RBASE, RD(b));
+      opr(J, 0, 1, 0xF7, 3, RAX);  /* neg rax */
+      stq(J, RAX, RBASE, RD(a));
+      movb(J, RBASE, RD(a) + TT, LUA_VNUMINT);
+      done = jmpfwd(J, CC_ALWAYS);
+      here(J, notint);
+      cmpb(J, RBASE, RD(b) + TT, LUA_VNUMFLT);
+      fail(J, CC_NE);
+      ldq(J, RAX, RBASE, RD(b));
+      opr(J, 0, 1, 0x0FBA, 7, RAX);  /* btc rax, 63 (flip sign) */
+      emit(J, 63);
+      stq(J, RAX, RBASE, RD(a));
+      movb(J, RBASE, RD(a) + TT, LUA_VNUMFLT);
+      here(J, done);
+      break;
+    }
+    case OP_NOT: {
+      size_t j;
+      isfalse(J, GETARG_B(i));
+      movb(J, RBASE, RD(a) + TT, LUA_VFALSE);
+      opr(J, 0, 0, 0x84, RDX, RDX);  /* test dl, dl */
+      j = jmpfwd(J, CC_E);
+      movb(J, RBASE, RD(a) + TT, LUA_VTRUE);
+      here(J, j);
+      break;
+    }
+    case OP_JMP: {
+      jumpto(J, pc + 1 + GETARG_sJ(i));
+      break;
+    }
+    case OP_EQ: case OP_LT: case OP_LE: {
+      static const int cmp[] = {CMP_EQ, CMP_LT, CMP_LE};
+      cmpregs(J, cmp[GET_OPCODE(i) - OP_EQ], a, GETARG_B(i));
+      condbranch(J, GETARG_k(i));
+      break;
+    }
+    case OP_EQK: {
+      const TValue *v = &k[GETARG_B(i)];
+      if (ttisnumber(v))
+        cmpnum(J, CMP_EQ, a, v, 0, 0);
+      else if (ttisnil(v) || ttisboolean(v)) {
+        cmpb(J, RBASE, RD(a) + TT, ttypetag(v));
+        opr(J, 0, 0, 0x0F90 | CC_E, 0, RDX);  /* sete dl */
+      }
+      else if (ttisshrstring(v)) {  /* equal iff the same string */
+        size_t j;
+        opr(J, 0, 0, 0x31, RDX, RDX);  /* xor edx, edx */
+        cmpb(J, RBASE, RD(a) + TT, ctb(LUA_VSHRSTR));
+        j = jmpfwd(J, CC_NE);
+        ldq(J, RAX, RBASE, RD(a));
+        movimm(J, RCX, cast(lua_Unsigned, cast_sizet(tsvalue(v))));
+        opr(J, 0, 1, 0x3B, RAX, RCX);  /* cmp rax, rcx */
+        opr(J, 0, 0, 0x0F90 | CC_E, 0, RDX);  /* sete dl */
+        here(J, j);
+      }
+      else
+        return 0;
+      condbranch(J, GETARG_k(i));
+      break;
+    }
+    case OP_EQI: case OP_LTI: case OP_LEI: case OP_GTI: case OP_GEI: {
+      static const int cmp[] = {CMP_EQ, CMP_LT, CMP_LE, CMP_LT, CMP_LE};
+      OpCode op = GET_OPCODE(i);
+      TValue v;
+      setivalue(&v, GETARG_sB(i));
+      cmpnum(J, cmp[op - OP_EQI], a, &v, op >= OP_GTI,
+             op == OP_EQI ? 0 : CC_ALWAYS);
+      condbranch(J, GETARG_k(i));
+      break;
+    }
+    case OP_TEST: {
+      isfalse(J, a);
+      opr(J, 0, 0, 0x80, 6, RDX);  /* xor dl, 1 */
+      emit(J, 1);
+      condbranch(J, GETARG_k(i));
+      break;
+    }
+    case OP_TESTSET: {
+      int b = GETARG_B(i);
+      Instruction ni = J->p->code[pc + 1];
+      isfalse(J, b);
+      opr(J, 0, 0, 0x80, 7, RDX);  /* cmp dl, k */
+      emit(J, GETARG_k(i));
+      jmpto(J, CC_E, entrypoint(J, pc + 2));
+      copyvalue(J, RBASE, RD(a), RBASE, RD(b));
+      jumpto(J, pc + 2 + GETARG_sJ(ni));
+      break;
+    }
+    case OP_FORLOOP: {
+      forloop(J, a, pc + 1 - GETARG_Bx(i));
+      break;
+    }
+    case OP_RETURN0: {
+      ret(J, 0, 0);
+      break;
+    }
+    case OP_RETURN1: {
+      ret(J, a, 1);
+      break;
+    }
+    default:
+      return 0;
+  }
+  return 1;
+}
+
+
+/*
+** Generate the code of the whole function. Return the number of
+** instructions with a stencil.
+*/
+static int emitcode (JitState *J) {
+  Proto *p = J->p;
+  int nnative = 0;
+  size_t prologue;
+  J->n = entryoffset(p);
+  /* shared epilogue */
+  J->epilogue = J->n;
+  emit(J, 0x41); emit(J, 0x5E);  /* pop r14 */
+  emit(J, 0x41); emit(J, 0x5D);  /* pop r13 */
+  emit(J, 0x41); emit(J, 0x5C);  /* pop r12 */
+  emit(J, 0x5B);  /* pop rbx */
+  emit(J, 0xC3);  /* ret */
+  /* prologue: save callee-saved registers and jump to 'code' */
+  prologue = J->n;
+  emit(J, 0x53);  /* push rbx */
+  emit(J, 0x41); emit(J, 0x54);  /* push r12 */
+  emit(J, 0x41); emit(J, 0x55);  /* push r13 */
+  emit(J, 0x41); emit(J, 0x56);  /* push r14 */
+  opr(J, 0, 1, 0x89, RSI, RBASE);
+  opr(J, 0, 1, 0x89, RDX, RCL);
+  opr(J, 0, 1, 0x89, RCX, RCI);
+  opr(J, 0, 1, 0x89, RDI, RL);
+  opr(J, 0, 0, 0xFF, 4, R8);  /* jmp r8 */
+  if (J->jc != NULL)
+    J->jc->run = cast(JitFunction, cast_sizet(J->code + prologue));
+  for (J->pc = 0; J->pc < p->sizecode; J->pc++) {
+    size_t start = J->n;
+    int native;
+    J->nfails = 0;
+    J->typed = 0;
+    native = stencil(J, p->code[J->pc]);
+    if (native) {
+      nnative++;
+      if (J->nfails > 0) {  /* exit for failed fast paths */
+        size_t skip = jmpfwd(J, CC_ALWAYS);
+        while (J->nfails > 0)
+          here(J, J->fails[--J->nfails]);
+        exitto(J, J->pc);
+        here(J, skip);
+      }
+    }
+    else
+      exitto(J, J->pc);
+    if (J->jc != NULL)
+      J->jc->entry[J->pc] = cast_uint(start) |
+                            (!native ? JITEXIT : J->typed ? JITTYPED : 0);
+  }
+  return nnative;
+}
+
+
+/*
+** Compile function 'p'. Errors (like lack of memory) only mean that 'p'
+** keeps being interpreted, so no error is ever raised. Native code lives
+** outside the Lua heap, in its own executable mapping.
+*/
+int luaJ_compile (lua_State *L, Proto *p) {
+  JitState J;
+  JitCode *jc;
+  void *m;
+  p->jithot = 0;  /* never try again */
+  memset(&J, 0, sizeof(J));
+  J.p = p;
+  J.g = G(L);
+  if (emitcode(&J) == 0)  /* nothing to gain? */
+    return 0;
+  m = mmap(NULL, J.n, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS,
+           -1, 0);
+  if (m == MAP_FAILED)
+    return 0;
+  jc = cast(JitCode *, m);
+  jc->size = J.n;
+  J.jc = jc;
+  J.code = cast(lu_byte *, m);
+  emitcode(&J);  /* generate code and find entry points */
+  emitcode(&J);  /* again, with all jump targets known */
+  if (mprotect(m, jc->size, PROT_READ | PROT_EXEC) != 0) {
+    munmap(m, jc->size);
+    return 0;
+  }
+  p->jit = jc;
+  p->jithot = JIT_FAILS;
+  return 1;
+}
+
+
+void luaJ_freecode (lua_State *L, Proto *p) {
+  UNUSED(L);
+  if (p->jit != NULL) {
+    munmap(p->jit, p->jit->size);
+    p->jit = NULL;
+  }
+}
+
+
+/*
+** Run native code of the running function from instruction 'pc'. Return
+** the next instruction to interpret or NULL if the function returned.
+** Native code whose fast paths keep failing because of the types of their
+** operands (e.g., arithmetic on vectors) is discarded.
+*/
+const Instruction *luaJ_execute (lua_State *L, CallInfo *ci,
+                                 const Instruction *pc) {
+  LClosure *cl = clLvalue(s2v(ci->func));
+  Proto *p = cl->p;
+  JitCode *jc = p->jit;
+  unsigned int e = jc->entry[pc - p->code];
+  if ((e & JITEXIT) || L->hookmask)
+    return pc;
+  pc = jc->run(L, ci->func + 1, cl, ci, entryaddr(jc, e));
+  if (pc != NULL && (jc->entry[pc - p->code] & JITTYPED) &&
+      --p->jithot == 0)  /* operands of unexpected types too often? */
+    luaJ_freecode(L, p);
+  return pc;
+}
+
+
+int luaJ_isnative (const Proto *p, int pc) {
+  return (p->jit != NULL && !(p->jit->entry[pc] & JITEXIT));
+}
+
+/* }================================================================== */
+
+#endif
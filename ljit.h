@@ -0,0 +1,33 @@
+/*
+** $Id: ljit.h $
+** Baseline compiler of Lua functions into x86-64 machine code
+** See Copyright Notice in lua.h
+*/
+
+#ifndef ljit_h
+#define ljit_h
+
+#include "lobject.h"
+#include "lstate.h"
+
+
+#if defined(LUAGLM_EXT_JIT)
+
+/*
+** Check whether prototype 'p' has native code, compiling it when it became
+** hot: every call, return into, or interpreted back jump of a function
+** counts towards 'JIT_HOT'.
+*/
+#define luaJ_ishot(L,p)  \
+  ((p)->jit != NULL || \
+   ((p)->jithot > 0 && --(p)->jithot == 0 && luaJ_compile(L, p)))
+
+LUAI_FUNC int luaJ_compile (lua_State *L, Proto *p);
+LUAI_FUNC void luaJ_freecode (lua_State *L, Proto *p);
+LUAI_FUNC const Instruction *luaJ_execute (lua_State *L, CallInfo *ci,
+                                           const Instruction *pc);
+LUAI_FUNC int luaJ_isnative (const Proto *p, int pc);
+
+#endif
+
+#endif
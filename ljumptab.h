@@ -108,6 +108,9 @@ static const void *const disptab[NUM_OPCODES] = {
 #if defined(LUAGLM_EXT_DEFER)
 &&L_OP_DEFER,
 #endif
+#if defined(LUAGLM_EXT_CONSTVEC)
+&&L_OP_CHECKCTOR,
+#endif
 &&L_OP_VARARG,
 &&L_OP_VARARGPREP,
 &&L_OP_EXTRAARG
@@ -226,6 +226,62 @@ typedef l_uint32 Instruction;
 #endif
 
 
+/*
+** Size of the cache of decoded vector swizzles (must be a power of 2)
+*/
+#if !defined(SWIZZLECACHE_N)
+#define SWIZZLECACHE_N		64
+#endif
+
+
+/*
+** Size of the inline cache of OP_SELF instructions with vector or matrix
+** receivers (must be a power of 2)
+*/
+#if !defined(METHODCACHE_N)
+#define METHODCACHE_N		128
+#endif
+
+
+/*
+** Size of the registry of fast functions (must be a power of 2) and maximum
+** number of arguments of a fast function (see 'luaV_setfastcall')
+*/
+#if !defined(FASTCALL_N)
+#define FASTCALL_N		64
+#endif
+
+#define FASTCALL_MAXARGS	4
+
+
+/*
+** Native code is only generated for x86-64 System V targets with 64-bit
+** numbers (see ljit.c)
+*/
+#if defined(LUAGLM_EXT_JIT)
+#if !defined(__x86_64__) || !defined(__linux__) || \
+    LUA_FLOAT_TYPE != LUA_FLOAT_DOUBLE || LUA_INT_TYPE != LUA_INT_LONGLONG
+#undef LUAGLM_EXT_JIT
+#endif
+#endif
+
+/*
+** Number of calls, returns into, and back jumps after which a function is
+** compiled into native code; 1 compiles every function on its first call
+*/
+#if !defined(JIT_HOT)
+#define JIT_HOT		64
+#endif
+
+/*
+** Number of times the fast paths of native code may fail (e.g., arithmetic
+** on vectors) before the function goes back to being interpreted
+*/
+#if !defined(JIT_FAILS)
+#define JIT_FAILS	4096
+#endif
+
+
 /* minimum size for string buffer */
 #if !defined(LUA_MINBUFFER)
 #define LUA_MINBUFFER	32
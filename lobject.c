@@ -22,6 +22,7 @@
 #include "lctype.h"
 #include "ldebug.h"
 #include "ldo.h"
+#include "lgc.h"
 #include "lmem.h"
 #include "lobject.h"
 #include "lstate.h"
@@ -598,3 +599,25 @@ void luaO_chunkid (char *out, const char *source, size_t srclen) {
   }
 }
 
+
+#if defined(LUAGLM_COMPACT_VALUE)
+/*
+** Set 'obj' to the vector 'v' of the given variant. Two-component vectors
+** are stored inline; otherwise a new vector object is created (see GCVector).
+** The caller is responsible for luaC_checkGC.
+*/
+void luaO_setvector (lua_State *L, TValue *obj, const lua_Float4 *v,
+                                                int variant) {
+  if (variant == LUA_VVECTOR2) {
+    val_(obj).f2[0] = v->raw[0];
+    val_(obj).f2[1] = v->raw[1];
+    settt_(obj, LUA_VVECTOR2);
+  }
+  else {
+    GCObject *o = luaC_newobj(L, variant, sizeof(GCVector));
+    gco2vec(o)->f4 = *v;
+    val_(obj).gc = o;
+    settt_(obj, ctb(variant));
+  }
+}
+#endif
@@ -45,7 +45,21 @@
 
 /*
 ** Union of all Lua values
+**
+** LUAGLM_COMPACT_VALUE: only two-component vectors are stored in the payload,
+** keeping the size of a Value to that of a lua_Number. All other vectors and
+** quaternions are collectable (see GCVector).
 */
+#if defined(LUAGLM_COMPACT_VALUE)
+typedef union Value {
+  struct GCObject *gc;    /* collectable objects */
+  void *p;         /* light userdata */
+  lua_CFloat2 f2;  /* vector2 stub */
+  lua_CFunction f; /* light C functions */
+  lua_Integer i;   /* integer numbers */
+  lua_Number n;    /* float numbers */
+} Value;
+#else
 LUAGLM_ALIGNED_TYPEDEF(union, Value) {
   struct GCObject *gc;    /* collectable objects */
   void *p;         /* light userdata */
@@ -54,6 +68,7 @@ LUAGLM_ALIGNED_TYPEDEF(union, Value) {
   lua_Integer i;   /* integer numbers */
   lua_Number n;    /* float numbers */
 } Value;
+#endif
 
 
 /*
@@ -570,6 +585,10 @@ typedef struct Proto {
   LocVar *locvars;  /* information about local variables (debug information) */
   TString  *source;  /* used for debug information */
   GCObject *gclist;
+#if defined(LUAGLM_EXT_JIT)
+  struct JitCode *jit;  /* native code (see ljit.c) */
+  int jithot;  /* countdown to compilation or, with 'jit', to discarding it */
+#endif
 } Proto;
 
 /* }================================================================== */
@@ -810,25 +829,73 @@ typedef struct Table {
 #endif
 
 #define ttisvector(o) checktype((o), LUA_TVECTOR)
+
+#if defined(LUAGLM_COMPACT_VALUE)
+/*
+** Three and four-component vectors and quaternions are immutable collectable
+** objects. A new object is created for each value, i.e., objects are never
+** shared with a mutable owner, and are compared by value.
+*/
+typedef struct GCVector {
+  CommonHeader;
+  lua_Float4 f4;
+} GCVector;
+
+/* raw type tag of a vector variant */
+#define vectt(t) ((t) == LUA_VVECTOR2 ? (t) : ctb(t))
+
+#define ttisvector2(o) checktag((o), LUA_VVECTOR2)
+#define ttisvector3(o) checktag((o), ctb(LUA_VVECTOR3))
+#define ttisvector4(o) checktag((o), ctb(LUA_VVECTOR4))
+#define ttisquat(o) checktag((o), ctb(LUA_VQUAT))
+
+/* expand an inline vector2 to a lua_Float4 */
+static LUA_INLINE lua_Float4 luaO_f2tof4 (const lua_VecF *f2) {
+  lua_Float4 f4;
+  f4.raw[0] = f2[0];
+  f4.raw[1] = f2[1];
+  f4.raw[2] = f4.raw[3] = cast(lua_VecF, 0);
+  return f4;
+}
+
+/* vector of the Value 'v' with raw type tag 'rtt' (e.g., a node key) */
+#define vvalue_raw(v, rtt) \
+  ((rtt) == LUA_VVECTOR2 ? luaO_f2tof4((v).f2) : gco2vec((v).gc)->f4)
+#define vvalue_(o) vvalue_raw(val_((o)), rawtt(o))
+#define vvalue_comp(o, i) \
+  (ttisvector2(o) ? val_(o).f2[(i)] : gco2vec(val_(o).gc)->f4.raw[(i)])
+
+#define setvvalue(L, obj, x, o)        \
+  LUA_MLM_BEGIN                        \
+  const lua_Float4 f4_ = (x);          \
+  luaO_setvector(L, (obj), &f4_, (o)); \
+  LUA_MLM_END
+#else
+#define vectt(t) (t)
+
 #define ttisvector2(o) checktag((o), LUA_VVECTOR2)
 #define ttisvector3(o) checktag((o), LUA_VVECTOR3)
 #define ttisvector4(o) checktag((o), LUA_VVECTOR4)
 #define ttisquat(o) checktag((o), LUA_VQUAT)
 
-#define vvalue_raw(o) ((o).f4)
-#define vvalue_(o) vvalue_raw(val_((o)))
+#define vvalue_raw(v, rtt) ((v).f4)
+#define vvalue_(o) vvalue_raw(val_((o)), rawtt(o))
 #define vvalue_ref(o) check_exp((ttisvector(o) || ttisquat(o)), &vvalue_(o))
+#define vvalue_comp(o, i) (vvalue_(o).raw[(i)])
+
+#define setvvalue(L, obj, x, o) \
+  LUA_MLM_BEGIN                 \
+  TValue *io = (obj);           \
+  val_(io).f4 = (x);            \
+  settt_(io, (o));              \
+  checkliveness(L, io);         \
+  LUA_MLM_END
+#endif
 
 #define vvalue(o) check_exp((ttisvector(o) || ttisquat(o)), vvalue_(o))
 #define vecvalue(o) check_exp(ttisvector(o), vvalue_(o))
 #define quatvalue(o) check_exp(ttisquat(o), vvalue_(o))
-#define setqvalue(obj, x) setvvalue(obj, x, LUA_VQUAT)
-#define setvvalue(obj, x, o) \
-  LUA_MLM_BEGIN              \
-  TValue *io = (obj);        \
-  val_(io).f4 = (x);         \
-  settt_(io, (o));           \
-  LUA_MLM_END
+#define setqvalue(L, obj, x) setvvalue(L, obj, x, LUA_VQUAT)
 
 /* }================================================================== */
 
@@ -838,21 +905,66 @@ typedef struct Table {
 ** ===================================================================
 */
 
+/*
+** Collectable matrices are allocated with only the storage required by their
+** dimensions at creation: 'size' column-major lua_VecF's with columns packed
+** 'LUAGLM_MATRIX_STRIDE' components apart. Appending columns beyond that
+** storage moves the components to an external block of a full lua_Mat4 (see
+** glmMat_store).
+*/
 typedef struct GCMatrix {
   CommonHeader;
-  lua_Mat4 mat4;
+  lu_byte size;  /* number of lua_VecF's allocated in 'u.v' */
+  lu_byte boxed;  /* true if the components are stored in 'u.ext' */
+  grit_length_t dimensions;
+  union {
+    lua_VecF *ext;  /* external storage; LUAGLM_MATRIX_LENGTH(4x4) components */
+    LUAGLM_ALIGNED_TYPE(lua_VecF, v[1]);  /* variable-sized component storage */
+  } u;
 } GCMatrix;
 
+/* size of a matrix object with 'n' allocated components */
+#define sizematrix(n)	(offsetof(GCMatrix, u) + (n) * sizeof(lua_VecF))
+
+/* components of a matrix object */
+#define matdata(m)	((m)->boxed ? (m)->u.ext : (m)->u.v)
+
+/* true if a matrix of dimensions 'd' can be stored in 'm' */
+#define matfits(m,d)	((m)->boxed || LUAGLM_MATRIX_LENGTH(d) <= (m)->size)
+
 #define LUA_VMATRIX makevariant(LUA_TMATRIX, 0)
+#define LUA_VMATRIX2 makevariant(LUA_TMATRIX, 1)  /* inline mat2x2 */
 
-#define ttismatrix(o) checktag((o), ctb(LUA_VMATRIX))
-#define mvalue(o)	check_exp(ttismatrix(o), gco2mat(val_(o).gc)->mat4)
-#define mvalue_ref(o)	check_exp(ttismatrix(o), &gco2mat(val_(o).gc)->mat4)
-#define mvalue_dims(o)	mvalue(o).dimensions
+#define ttismatrix(o) checktype((o), LUA_TMATRIX)
+#define ttisfullmatrix(o) checktag((o), ctb(LUA_VMATRIX))
+#define mvalue(o)	check_exp(ttisfullmatrix(o), gco2mat(val_(o).gc))
 
 #define setmvalue2s(L, o, x) setmvalue(L, s2v(o), x)
 #define setmvalue(L, obj, x) glm_setmvalue(L, obj, x)
 
+/*
+** @LUAGLM_EXT_INLINEMAT: a mat2x2 has the size of a lua_Float4 and is stored,
+** column-major, in the Value payload. Inline matrices are values: assigning a
+** column updates the copy held by that slot and expanding its dimensions
+** promotes the slot to a collectable matrix. Not available with
+** LUAGLM_COMPACT_VALUE.
+*/
+#if defined(LUAGLM_EXT_INLINEMAT) && !defined(LUAGLM_COMPACT_VALUE)
+#define LUAGLM_INLINE_MATRIX
+
+#define ttisinlinematrix(o) checktag((o), LUA_VMATRIX2)
+#define m2value(o)	check_exp(ttisinlinematrix(o), val_(o).f4)
+
+#define setm2value(L, obj, x) \
+  { TValue *io = (obj); val_(io).f4 = (x); settt_(io, LUA_VMATRIX2); \
+    checkliveness(L, io); }
+#else
+#define ttisinlinematrix(o) 0
+#endif
+
+#define mvalue_dims(o) \
+  (ttisinlinematrix(o) ? LUAGLM_MATRIX_2x2 : mvalue(o)->dimensions)
+
 /* }================================================================== */
 
 
@@ -883,6 +995,10 @@ LUAI_FUNC const char *luaO_pushvfstring (lua_State *L, const char *fmt,
                                                        va_list argp);
 LUAI_FUNC const char *luaO_pushfstring (lua_State *L, const char *fmt, ...);
 LUAI_FUNC void luaO_chunkid (char *out, const char *source, size_t srclen);
+#if defined(LUAGLM_COMPACT_VALUE)
+LUAI_FUNC void luaO_setvector (lua_State *L, TValue *obj, const lua_Float4 *v,
+                                                          int variant);
+#endif
 
 
 #endif
@@ -99,6 +99,9 @@ LUAI_DDEF const lu_byte luaP_opmodes[NUM_OPCODES] = {
  ,opmode(0, 0, 0, 0, 1, iABx)		/* OP_CLOSURE */
 #if defined(LUAGLM_EXT_DEFER)
  ,opmode(0, 0, 0, 0, 1, iABC)		/* OP_DEFER */
+#endif
+#if defined(LUAGLM_EXT_CONSTVEC)
+ ,opmode(0, 0, 0, 0, 0, iABC)		/* OP_CHECKCTOR */
 #endif
  ,opmode(0, 1, 0, 0, 1, iABC)		/* OP_VARARG */
  ,opmode(0, 0, 1, 0, 1, iABC)		/* OP_VARARGPREP */
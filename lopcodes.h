@@ -304,6 +304,9 @@ OP_CLOSURE,/*	A Bx	R[A] := closure(KPROTO[Bx])			*/
 #if defined(LUAGLM_EXT_DEFER)
 OP_DEFER, /*	A Bx	R[A] := closure(KPROTO[Bx]); mark variable R[A] "is deferred" */
 #endif
+#if defined(LUAGLM_EXT_CONSTVEC)
+OP_CHECKCTOR, /*	A B	if R[A] is not the builtin constructor of vector variant B then error */
+#endif
 
 OP_VARARG,/*	A C	R[A], R[A+1], ..., R[A+C-2] = vararg		*/
 
@@ -95,6 +95,9 @@ static const char *const opnames[] = {
   "CLOSURE",
 #if defined(LUAGLM_EXT_DEFER)
   "DEFER",
+#endif
+#if defined(LUAGLM_EXT_CONSTVEC)
+  "CHECKCTOR",
 #endif
   "VARARG",
   "VARARGPREP",
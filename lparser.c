@@ -154,6 +154,9 @@ static void init_exp (expdesc *e, expkind k, int i) {
   e->f = e->t = NO_JUMP;
   e->k = k;
   e->u.info = i;
+#if defined(LUAGLM_EXT_INPLACE)
+  e->tmp = 0;
+#endif
 }
 
 
@@ -700,6 +703,79 @@ static void leaveblock (FuncState *fs) {
 }
 
 
+/*
+** Snapshot of the code generated so far for a function, used to drop
+** code that can never run (see 'discardcode').
+*/
+typedef struct CodeMark {
+  int pc;
+  int nk;
+  int np;
+  int nabslineinfo;
+  int previousline;
+  int lasttarget;
+  int ngt;  /* number of pending gotos */
+  short ndebugvars;
+  lu_byte nups;
+  lu_byte freereg;
+  lu_byte iwthabs;
+} CodeMark;
+
+
+static void markcode (FuncState *fs, CodeMark *m) {
+  m->pc = fs->pc;
+  m->nk = fs->nk;
+  m->np = fs->np;
+  m->nabslineinfo = fs->nabslineinfo;
+  m->previousline = fs->previousline;
+  m->lasttarget = fs->lasttarget;
+  m->ngt = fs->ls->dyd->gt.n;
+  m->ndebugvars = fs->ndebugvars;
+  m->nups = fs->nups;
+  m->freereg = fs->freereg;
+  m->iwthabs = fs->iwthabs;
+}
+
+
+/*
+** Remove everything generated since mark 'm': instructions, line
+** information, constants, nested functions, debug information of locals,
+** and upvalues. Constants still indexed by the cache 'ls->h' are checked
+** by 'addk' before being reused. Pending gotos from the removed code
+** (which can only be at the end of the list) lose their jumps but are
+** still resolved, so that wrong gotos are errors even in dead code.
+*/
+static void discardcode (FuncState *fs, const CodeMark *m) {
+  Labellist *gl = &fs->ls->dyd->gt;
+  int i;
+  lua_assert(fs->pc >= m->pc && gl->n >= m->ngt);
+  for (i = m->ngt; i < gl->n; i++)
+    gl->arr[i].pc = NO_JUMP;  /* its jump was removed */
+  fs->pc = m->pc;
+  fs->nk = m->nk;
+  fs->np = m->np;
+  fs->nabslineinfo = m->nabslineinfo;
+  fs->previousline = m->previousline;
+  fs->lasttarget = m->lasttarget;
+  fs->ndebugvars = m->ndebugvars;
+  fs->nups = m->nups;
+  fs->freereg = m->freereg;
+  fs->iwthabs = m->iwthabs;
+}
+
+
+/*
+** Check whether expression 'e' is a constant condition: return 1 if it
+** is always true, 0 if it is always false, and -1 if it is not constant.
+*/
+static int constcond (FuncState *fs, const expdesc *e) {
+  TValue k;
+  if (!luaK_exp2const(fs, e, &k))
+    return -1;
+  return !l_isfalse(&k);
+}
+
+
 /*
 ** adds a new prototype into list of prototypes
 */
@@ -1365,6 +1441,9 @@ static void simpleexp (LexState *ls, expdesc *v) {
 #endif
     default: {
       suffixedexp(ls, v);
+#if defined(LUAGLM_EXT_CONSTVEC)
+      luaK_constvec(ls->fs, v);
+#endif
       return;
     }
   }
@@ -1463,14 +1542,30 @@ static BinOpr subexpr (LexState *ls, expdesc *v, int limit) {
   /* expand while operators have priorities higher than 'limit' */
   op = getbinopr(ls->t.token);
   while (op != OPR_NOBINOPR && priority[op].left > limit) {
+    FuncState *fs = ls->fs;
+    expdesc v1 = *v;
     expdesc v2;
+    CodeMark m;
     BinOpr nextop;
     int line = ls->linenumber;
+    int k = constcond(fs, v);
     luaX_next(ls);  /* skip operator */
-    luaK_infix(ls->fs, op, v);
+    markcode(fs, &m);
+    if ((op == OPR_AND && k == 0) || (op == OPR_OR && k == 1)) {
+      /* 'false and x' or 'true or x': 'x' is never evaluated */
+      op = subexpr(ls, &v2, priority[op].right);
+      discardcode(fs, &m);
+      continue;
+    }
+    luaK_infix(fs, op, v);
     /* read sub-expression with higher priority */
     nextop = subexpr(ls, &v2, priority[op].right);
-    luaK_posfix(ls->fs, op, v, &v2, line);
+    if (k >= 0 && luaK_foldconst(fs, op, &v1, &v2)) {
+      discardcode(fs, &m);  /* remove code from 'luaK_infix' */
+      *v = v1;
+    }
+    else
+      luaK_posfix(fs, op, v, &v2, line);
     op = nextop;
   }
   leavelevel(ls);
@@ -1795,9 +1890,24 @@ static void whilestat (LexState *ls, int line) {
   int whileinit;
   int condexit;
   BlockCnt bl;
+  CodeMark m;
+  expdesc v;
   luaX_next(ls);  /* skip WHILE */
+  markcode(fs, &m);
   whileinit = luaK_getlabel(fs);
-  condexit = cond(ls);
+  expr(ls, &v);  /* read condition */
+  if (constcond(fs, &v) == 0) {  /* loop never runs? */
+    enterblock(fs, &bl, 1);
+    checknext(ls, TK_DO);
+    block(ls);
+    check_match(ls, TK_END, TK_WHILE, line);
+    leaveblock(fs);
+    discardcode(fs, &m);  /* remove the whole loop */
+    return;
+  }
+  if (v.k == VNIL) v.k = VFALSE;  /* 'falses' are all equal here */
+  luaK_goiftrue(fs, &v);
+  condexit = v.f;
   enterblock(fs, &bl, 1);
   checknext(ls, TK_DO);
   block(ls);
@@ -1959,15 +2069,49 @@ static void forstat (LexState *ls, int line) {
 }
 
 
-static void test_then_block (LexState *ls, int *escapelist) {
+/*
+** Compiles a block ('then' part or 'else' part) that can never run and
+** removes it, together with everything generated since mark 'm'.
+*/
+static void deadblock (LexState *ls, const CodeMark *m) {
+  BlockCnt bl;
+  FuncState *fs = ls->fs;
+  enterblock(fs, &bl, 0);
+  statlist(ls);
+  leaveblock(fs);
+  discardcode(fs, m);
+}
+
+
+/*
+** Returns whether the condition is always true; in that case, the
+** remaining 'elseif'/'else' parts are dead. Parts with a condition that
+** is always false, or that follow an always-true part ('dead'), are
+** removed with their conditions.
+*/
+static int test_then_block (LexState *ls, int *escapelist, int dead) {
   /* test_then_block -> [IF | ELSEIF] cond THEN block */
   BlockCnt bl;
   FuncState *fs = ls->fs;
   expdesc v;
+  CodeMark m;
+  int k;
   int jf;  /* instruction to skip 'then' code (if condition is false) */
   luaX_next(ls);  /* skip IF or ELSEIF */
+  markcode(fs, &m);
   expr(ls, &v);  /* read condition */
   checknext(ls, TK_THEN);
+  k = constcond(fs, &v);
+  if (dead || k == 0) {  /* 'then' part never runs? */
+    deadblock(ls, &m);
+    return 0;
+  }
+  else if (k == 1) {  /* 'then' part always runs? */
+    enterblock(fs, &bl, 0);
+    statlist(ls);
+    leaveblock(fs);
+    return 1;  /* no test, and no jump over the dead parts */
+  }
   if (ls->t.token == TK_BREAK) {  /* 'if x then break' ? */
     int line = ls->linenumber;
     luaK_goiffalse(ls->fs, &v);  /* will jump if condition is true */
@@ -1977,7 +2121,7 @@ static void test_then_block (LexState *ls, int *escapelist) {
     while (testnext(ls, ';')) {}  /* skip semicolons */
     if (block_follow(ls, 0)) {  /* jump is the entire block? */
       leaveblock(fs);
-      return;  /* and that is it */
+      return 0;  /* and that is it */
     }
     else  /* must skip over 'then' part if condition is false */
       jf = luaK_jump(fs);
@@ -1993,6 +2137,7 @@ static void test_then_block (LexState *ls, int *escapelist) {
       ls->t.token == TK_ELSEIF)  /* followed by 'else'/'elseif'? */
     luaK_concat(fs, escapelist, luaK_jump(fs));  /* must jump over it */
   luaK_patchtohere(fs, jf);
+  return 0;
 }
 
 
@@ -2000,11 +2145,18 @@ static void ifstat (LexState *ls, int line) {
   /* ifstat -> IF cond THEN block {ELSEIF cond THEN block} [ELSE block] END */
   FuncState *fs = ls->fs;
   int escapelist = NO_JUMP;  /* exit list for finished parts */
-  test_then_block(ls, &escapelist);  /* IF cond THEN block */
-  while (ls->t.token == TK_ELSEIF)
-    test_then_block(ls, &escapelist);  /* ELSEIF cond THEN block */
-  if (testnext(ls, TK_ELSE))
-    block(ls);  /* 'else' part */
+  int taken = test_then_block(ls, &escapelist, 0);  /* IF cond THEN block */
+  while (ls->t.token == TK_ELSEIF)  /* ELSEIF cond THEN block */
+    taken |= test_then_block(ls, &escapelist, taken);
+  if (testnext(ls, TK_ELSE)) {  /* 'else' part */
+    if (taken) {  /* some previous part always runs? */
+      CodeMark m;
+      markcode(fs, &m);
+      deadblock(ls, &m);
+    }
+    else
+      block(ls);
+  }
   check_match(ls, TK_END, TK_IF, line);
   luaK_patchtohere(fs, escapelist);  /* patch escape list to 'if' end */
 }
@@ -2068,6 +2220,27 @@ static void checktoclose (FuncState *fs, int level) {
 }
 
 
+#if defined(LUAGLM_EXT_CONSTVEC)
+/*
+** Mark the '<const>' variables, among the last 'nvars' ones, that are named
+** after a builtin vector constructor (e.g., "local vec3 <const> = vec3"):
+** calls through them may be folded into vector constants. Their values are
+** checked, once, at runtime (see 'luaK_constvec').
+*/
+static void checkctors (LexState *ls, int vidx, int nvars) {
+  FuncState *fs = ls->fs;
+  int i, tt;
+  for (i = vidx - nvars + 1; i <= vidx; i++) {
+    Vardesc *var = getlocalvardesc(fs, i);
+    if (var->vd.kind == RDKCONST && (tt = luaK_ctorvariant(var->vd.name))) {
+      var->vd.kind = RDKCTOR;
+      luaK_codeABC(fs, OP_CHECKCTOR, var->vd.ridx, tt, 0);
+    }
+  }
+}
+#endif
+
+
 static void localstat (LexState *ls) {
   /* stat -> LOCAL NAME ATTRIB {',' NAME ATTRIB} [IN primaryexp | '=' explist] */
   FuncState *fs = ls->fs;
@@ -2133,6 +2306,9 @@ static void localstat (LexState *ls) {
     adjust_assign(ls, nvars, nexps, &e);
     adjustlocalvars(ls, nvars);
   }
+#if defined(LUAGLM_EXT_CONSTVEC)
+  checkctors(ls, vidx, nvars);
+#endif
   checktoclose(fs, toclose);
 }
 
@@ -83,6 +83,9 @@ typedef struct expdesc {
   } u;
   int t;  /* patch list of 'exit when true' */
   int f;  /* patch list of 'exit when false' */
+#if defined(LUAGLM_EXT_INPLACE)
+  lu_byte tmp;  /* operand register holds an unshared arithmetic result */
+#endif
 } expdesc;
 
 
@@ -91,6 +94,9 @@ typedef struct expdesc {
 #define RDKCONST	1   /* constant */
 #define RDKTOCLOSE	2   /* to-be-closed */
 #define RDKCTC		3   /* compile-time constant */
+#if defined(LUAGLM_EXT_CONSTVEC)
+#define RDKCTOR		4   /* constant builtin vector constructor */
+#endif
 
 /* description of an active local variable */
 typedef union Vardesc {
@@ -133,6 +139,7 @@ typedef struct Dyndata {
   } actvar;
   Labellist gt;  /* list of pending gotos */
   Labellist label;   /* list of active labels */
+  lu_byte optimize;  /* run the optimizing pass (load mode 'O') */
 } Dyndata;
 
 
@@ -266,6 +266,46 @@ static void preinit_thread (lua_State *L, global_State *g) {
 }
 
 
+/*
+** {======================================================
+** Inline caches
+** =======================================================
+*/
+
+/*
+** Allocate an inline cache of 'n' entries of type 't'. A cache is allocated
+** when its first entry is filled, by an instruction that may have no other
+** use for an error: a failed allocation just leaves the instruction uncached.
+*/
+#define newcache(L,t,n)	cast(t *, luaM_realloc_(L, NULL, 0, sizeof(t) * (n)))
+
+
+/*
+** Inline cache of OP_SELF instructions with vector or matrix receivers. As
+** any allocation, this may run an emergency collection: the running function
+** must have saved its state.
+*/
+MethodCache *luaE_methodcache (lua_State *L) {
+  global_State *g = G(L);
+  if (g->methodcache == NULL) {
+    int i;
+    g->methodcache = newcache(L, MethodCache, METHODCACHE_N);
+    for (i = 0; g->methodcache != NULL && i < METHODCACHE_N; i++)
+      g->methodcache[i].pc = NULL;
+  }
+  return g->methodcache;
+}
+
+
+static void freecaches (lua_State *L) {
+  global_State *g = G(L);
+  if (g->methodcache != NULL)
+    luaM_freearray(L, g->methodcache, METHODCACHE_N);
+}
+
+/* }====================================================== */
+
+
 static void close_state (lua_State *L) {
   global_State *g = G(L);
   if (!completestate(g))  /* closing a partially built state? */
@@ -276,6 +316,7 @@ static void close_state (lua_State *L) {
     luaC_freeallobjects(L);  /* collect all objects */
     luai_userstateclose(L);
   }
+  freecaches(L);
   luaM_freearray(L, G(L)->strt.hash, G(L)->strt.size);
   freestack(L);
   lua_assert(gettotalbytes(g) == sizeof(LG));
@@ -398,7 +439,21 @@ LUA_API lua_State *lua_newstate (lua_Alloc f, void *ud) {
   g->gcstepsize = LUAI_GCSTEPSIZE;
   setgcparam(g->genmajormul, LUAI_GENMAJORMUL);
   g->genminormul = LUAI_GENMINORMUL;
+#if defined(LUAGLM_EXT_INPLACE)
+  g->lastmat = g->deadmat = NULL;
+#endif
+#if defined(LUAGLM_EXT_GCPOOL)
+  g->gcpoolmax = LUAI_GCPOOLMAX;
+  memset(g->gcpool, 0, sizeof(g->gcpool));
+#endif
   for (i=0; i < LUA_NUMTAGS; i++) g->mt[i] = NULL;
+  g->methodcache = NULL;
+#if defined(LUAGLM_EXT_FASTCALL)
+  for (i=0; i < FASTCALL_N; i++) g->fastcall[i].f = NULL;
+#endif
+#if defined(LUAGLM_EXT_BLOB)
+  g->viewmt = NULL;
+#endif
   if (luaD_rawrunprotected(L, f_luaopen, NULL) != LUA_OK) {
     /* memory allocation error: free partial state */
     close_state(L);
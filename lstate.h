@@ -243,6 +243,95 @@ typedef struct CallInfo {
 #define getoah(st)	((st) & CIST_OAH)
 
 
+/*
+** Decoded vector swizzle (e.g., "xy" or "zyx") of a short string. Entries of
+** the swizzle cache are indexed by the hash of their key and cleared, like
+** 'strcache', when the key is about to be collected (see 'luaS_clearcache').
+*/
+typedef struct Swizzle {
+  TString *key;
+  lu_byte n;  /* number of components; zero if 'key' is not a swizzle */
+  lu_byte dims;  /* minimum dimensions of a vector that can be swizzled */
+  lu_byte idx[4];  /* source component of each result component */
+} Swizzle;
+
+
+/*
+** Inline caches of the interpreter are arrays allocated on their first fill
+** (e.g., 'luaE_methodcache'), so that a state only pays for the caches of the
+** instructions it runs, and entries are indexed by the address of the
+** instruction owning them.
+*/
+#define cacheentry(c,pc,n)	(&(c)[lmod(point2uint(pc) / sizeof(Instruction), n)])
+
+
+/*
+** Inline cache of an OP_SELF instruction whose receiver is a vector or matrix,
+** i.e., a method resolved through the metatable shared by all values of that
+** type. None of the pointers of an entry are dereferenced before 'mt', 'node',
+** and 'lsizenode' are validated against the live metatable (see
+** 'glm_fastself').
+*/
+typedef struct MethodCache {
+  const Instruction *pc;  /* instruction owning the entry */
+  struct Table *mt;  /* metatable of the receiver */
+  Node *node;  /* hash part of 'mt' when the entry was filled */
+  Node *tm;  /* '__index' field of 'mt' */
+  Node *slot;  /* field of 'mt' holding the method */
+  lu_byte lsizenode;  /* log2 of the size of 'node' */
+} MethodCache;
+
+
+#if defined(LUAGLM_EXT_FASTCALL)
+/*
+** Typed variant of a light C function: called by OP_CALL directly on the
+** registers of the call, i.e., without a CallInfo, with its arguments at
+** 'func + 1' and storing its single result at 'func'. A fast function may
+** allocate but must not raise any other error.
+*/
+typedef void (*FastFunction) (lua_State *L, StkId func);
+
+/*
+** Entry of the registry of fast functions. Entries are indexed by the address
+** of the C function they replace, with linear probing; a C function may have
+** one entry per signature (see 'luaV_setfastcall').
+*/
+typedef struct FastCall {
+  lua_CFunction f;  /* replaced light C function; NULL if entry is empty */
+  FastFunction fast;
+  unsigned int sig;  /* packed type tags of the arguments */
+  lu_byte nargs;  /* number of arguments */
+} FastCall;
+#endif
+
+
+#if defined(LUAGLM_EXT_GCPOOL)
+/*
+** Size classes of fixed-size collectable objects whose released blocks
+** are retained by the collector for reuse (see 'luaC_newobj').
+*/
+#define GCPOOL_MATRIX	0
+#define GCPOOL_UPVAL	1
+#if defined(LUAGLM_COMPACT_VALUE)
+#define GCPOOL_VECTOR	2
+#define GCPOOL_N	3
+#else
+#define GCPOOL_N	2
+#endif
+
+/*
+** Free list of a single size class. Blocks are chained through their
+** 'next' field and are not accounted in 'totalbytes' while pooled.
+*/
+typedef struct GCPool {
+  GCObject *list;  /* released blocks */
+  int n;  /* number of blocks in 'list' */
+  lu_mem hits;  /* allocations served from 'list' */
+  lu_mem misses;  /* allocations of this class served by 'frealloc' */
+} GCPool;
+#endif
+
+
 /*
 ** 'global state', shared by all threads of this state
 */
@@ -292,9 +381,25 @@ typedef struct global_State {
   TString *memerrmsg;  /* message for memory-allocation errors */
   TString *tmname[TM_N];  /* array with tag-method names */
   struct Table *mt[LUA_NUMTAGS];  /* metatables for basic types */
+#if defined(LUAGLM_EXT_BLOB)
+  struct Table *viewmt;  /* metatable of typed blob views */
+#endif
   TString *strcache[STRCACHE_N][STRCACHE_M];  /* cache for strings in API */
+  Swizzle swizzle[SWIZZLECACHE_N];  /* cache of decoded vector swizzles */
+  MethodCache *methodcache;  /* OP_SELF inline caches (or NULL) */
+#if defined(LUAGLM_EXT_FASTCALL)
+  FastCall fastcall[FASTCALL_N];  /* registry of fast functions */
+#endif
   lua_WarnFunction warnf;  /* warning function */
   void *ud_warn;         /* auxiliary data to 'warnf' */
+#if defined(LUAGLM_EXT_INPLACE)
+  GCObject *lastmat;  /* last matrix created by a builtin arithmetic operator */
+  GCObject *deadmat;  /* matrix of a dying temporary that may be overwritten */
+#endif
+#if defined(LUAGLM_EXT_GCPOOL)
+  int gcpoolmax;  /* maximum number of blocks retained per size class */
+  GCPool gcpool[GCPOOL_N];  /* free lists of released objects */
+#endif
 } global_State;
 
 
@@ -355,6 +460,9 @@ union GCUnion {
   struct lua_State th;  /* thread */
   struct UpVal upv;
   struct GCMatrix mat;
+#if defined(LUAGLM_COMPACT_VALUE)
+  struct GCVector vec;
+#endif
 };
 
 
@@ -378,6 +486,8 @@ union GCUnion {
 #define gco2th(o)  check_exp((o)->tt == LUA_VTHREAD, &((cast_u(o))->th))
 #define gco2upv(o)	check_exp((o)->tt == LUA_VUPVAL, &((cast_u(o))->upv))
 #define gco2mat(o)  check_exp((o)->tt == LUA_VMATRIX, &((cast_u(o))->mat))
+#define gco2vec(o)  \
+	check_exp(novariant((o)->tt) == LUA_TVECTOR, &((cast_u(o))->vec))
 
 
 /*
@@ -400,6 +510,7 @@ LUAI_FUNC void luaE_incCstack (lua_State *L);
 LUAI_FUNC void luaE_warning (lua_State *L, const char *msg, int tocont);
 LUAI_FUNC void luaE_warnerror (lua_State *L, const char *where);
 LUAI_FUNC int luaE_resetthread (lua_State *L, int status);
+LUAI_FUNC MethodCache *luaE_methodcache (lua_State *L);
 
 
 #endif
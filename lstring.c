@@ -117,7 +117,7 @@ void luaS_resize (lua_State *L, int nsize) {
 
 /*
 ** Clear API string cache. (Entries cannot be empty, so fill them with
-** a non-collectable string.)
+** a non-collectable string.) Also clear the swizzle cache.
 */
 void luaS_clearcache (global_State *g) {
   int i, j;
@@ -126,6 +126,10 @@ void luaS_clearcache (global_State *g) {
       if (iswhite(g->strcache[i][j]))  /* will entry be collected? */
         g->strcache[i][j] = g->memerrmsg;  /* replace it with something fixed */
     }
+  for (i = 0; i < SWIZZLECACHE_N; i++) {
+    if (g->swizzle[i].key != NULL && iswhite(g->swizzle[i].key))
+      g->swizzle[i].key = NULL;  /* entry will be collected */
+  }
 }
 
 
@@ -145,6 +149,8 @@ void luaS_init (lua_State *L) {
   for (i = 0; i < STRCACHE_N; i++)  /* fill cache with valid strings */
     for (j = 0; j < STRCACHE_M; j++)
       g->strcache[i][j] = g->memerrmsg;
+  for (i = 0; i < SWIZZLECACHE_N; i++)
+    g->swizzle[i].key = NULL;
 }
 
 
@@ -2066,6 +2066,160 @@ static int str_blobunpack (lua_State *L) {
   luaL_argcheck(L, offset <= blob_len, 3, "initial position out of string");
   return shared_unpack(L, fmt, blob, blob_len, offset);
 }
+
+
+/*
+** {======================================================
+** Typed blob accessors and views
+** =======================================================
+*/
+
+#define BLOBVIEW	"blobview"
+
+/* names of the element types; in the order of LUA_BLOBVEC2, ... */
+static const char *const blobtypes[] =
+  {"vec2", "vec3", "vec4", "quat", "float", "mat4", NULL};
+
+
+/*
+** Return the byte offset of an element of 'type' at the (optional) position
+** argument 'arg' of a blob of length 'len'.
+*/
+static size_t blobelem (lua_State *L, int arg, size_t len, int type) {
+  size_t offset = posrelatI(luaL_optinteger(L, arg, 1), len) - 1;
+  luaL_argcheck(L, offset <= len && lua_blobsize(type) <= len - offset, arg,
+                   "data string too short");
+  return offset;
+}
+
+
+/* blob_getXXX(blob [, pos]) */
+static int blobget (lua_State *L, int type) {
+  size_t len;
+  size_t offset;
+  luaL_checklstring(L, 1, &len);
+  offset = blobelem(L, 2, len, type);
+  lua_blobget(L, 1, offset, type);
+  return 1;
+}
+
+
+/* blob_setXXX(blob, pos, value) */
+static int blobset (lua_State *L, int type) {
+  size_t len = 0;
+  size_t offset;
+  if (!lua_isstringblob(L, 1))
+    return luaL_typeerror(L, 1, "blob");
+  lua_tostringblob(L, 1, &len);
+  offset = blobelem(L, 2, len, type);
+  lua_settop(L, 3);
+  lua_pushvalue(L, 3);
+  if (!lua_blobset(L, 1, offset, type))
+    return luaL_typeerror(L, 3, blobtypes[type]);
+  lua_settop(L, 1);
+  return 1;  /* return blob */
+}
+
+
+static int str_blobgetvec2 (lua_State *L) { return blobget(L, LUA_BLOBVEC2); }
+static int str_blobgetvec3 (lua_State *L) { return blobget(L, LUA_BLOBVEC3); }
+static int str_blobgetvec4 (lua_State *L) { return blobget(L, LUA_BLOBVEC4); }
+static int str_blobgetquat (lua_State *L) { return blobget(L, LUA_BLOBQUAT); }
+static int str_blobgetmat4 (lua_State *L) { return blobget(L, LUA_BLOBMAT4); }
+static int str_blobsetvec2 (lua_State *L) { return blobset(L, LUA_BLOBVEC2); }
+static int str_blobsetvec3 (lua_State *L) { return blobset(L, LUA_BLOBVEC3); }
+static int str_blobsetvec4 (lua_State *L) { return blobset(L, LUA_BLOBVEC4); }
+static int str_blobsetquat (lua_State *L) { return blobset(L, LUA_BLOBQUAT); }
+static int str_blobsetmat4 (lua_State *L) { return blobset(L, LUA_BLOBMAT4); }
+
+
+/* blob_view(blob, type [, pos [, count]]) */
+static int str_blobview (lua_State *L) {
+  size_t len = 0;
+  size_t size, offset, count;
+  lua_BlobView *view;
+  int type;
+  if (!lua_isstringblob(L, 1))
+    return luaL_typeerror(L, 1, "blob");
+  lua_tostringblob(L, 1, &len);
+  type = luaL_checkoption(L, 2, NULL, blobtypes);
+  size = lua_blobsize(type);
+  offset = posrelatI(luaL_optinteger(L, 3, 1), len) - 1;
+  luaL_argcheck(L, offset <= len, 3, "initial position out of string");
+  count = (len - offset) / size;
+  if (!lua_isnoneornil(L, 4)) {
+    lua_Integer n = luaL_checkinteger(L, 4);
+    luaL_argcheck(L, 0 <= n && (lua_Unsigned)n <= count, 4,
+                     "data string too short");
+    count = (size_t)n;
+  }
+  view = (lua_BlobView *)lua_newuserdatauv(L, sizeof(lua_BlobView), 1);
+  view->offset = offset;
+  view->count = count;
+  view->type = type;
+  lua_pushvalue(L, 1);
+  lua_setiuservalue(L, -2, 1);  /* anchor blob */
+  luaL_setmetatable(L, BLOBVIEW);
+  return 1;
+}
+
+
+/*
+** Metamethods of blob views: the virtual machine handles the in-bounds
+** integer keys of a view (see lua_setblobview); everything else ends here.
+*/
+static int blobview_index (lua_State *L) {
+  lua_BlobView *view = (lua_BlobView *)luaL_checkudata(L, 1, BLOBVIEW);
+  lua_Integer n = lua_tointeger(L, 2);
+  if (lua_isinteger(L, 2) && 1 <= n && (lua_Unsigned)n <= view->count) {
+    lua_getiuservalue(L, 1, 1);
+    lua_blobget(L, -1, view->offset + (size_t)(n - 1) * lua_blobsize(view->type),
+                   view->type);
+  }
+  else
+    lua_pushnil(L);
+  return 1;
+}
+
+
+static int blobview_newindex (lua_State *L) {
+  lua_BlobView *view = (lua_BlobView *)luaL_checkudata(L, 1, BLOBVIEW);
+  lua_Integer n = lua_tointeger(L, 2);
+  luaL_argcheck(L, lua_isinteger(L, 2) && 1 <= n && (lua_Unsigned)n <= view->count,
+                   2, "index out of range");
+  lua_settop(L, 3);
+  lua_getiuservalue(L, 1, 1);
+  lua_pushvalue(L, 3);
+  if (!lua_blobset(L, 4, view->offset + (size_t)(n - 1) * lua_blobsize(view->type),
+                      view->type))
+    return luaL_typeerror(L, 3, blobtypes[view->type]);
+  return 0;
+}
+
+
+static int blobview_len (lua_State *L) {
+  lua_BlobView *view = (lua_BlobView *)luaL_checkudata(L, 1, BLOBVIEW);
+  lua_pushinteger(L, (lua_Integer)view->count);
+  return 1;
+}
+
+
+static const luaL_Reg blobviewmeta[] = {
+  {"__index", blobview_index},
+  {"__newindex", blobview_newindex},
+  {"__len", blobview_len},
+  {NULL, NULL}
+};
+
+
+static void createblobview (lua_State *L) {
+  luaL_newmetatable(L, BLOBVIEW);
+  luaL_setfuncs(L, blobviewmeta, 0);
+  lua_setblobview(L, -1);
+  lua_pop(L, 1);  /* pop metatable */
+}
+
+/* }====================================================== */
 #endif
 
 /* }====================================================== */
@@ -2107,6 +2261,17 @@ static const luaL_Reg strlib[] = {
   {"isblob", str_isblob},
   {"blob_pack", str_blobpack},
   {"blob_unpack", str_blobunpack},
+  {"blob_getvec2", str_blobgetvec2},
+  {"blob_getvec3", str_blobgetvec3},
+  {"blob_getvec4", str_blobgetvec4},
+  {"blob_getquat", str_blobgetquat},
+  {"blob_getmat4", str_blobgetmat4},
+  {"blob_setvec2", str_blobsetvec2},
+  {"blob_setvec3", str_blobsetvec3},
+  {"blob_setvec4", str_blobsetvec4},
+  {"blob_setquat", str_blobsetquat},
+  {"blob_setmat4", str_blobsetmat4},
+  {"blob_view", str_blobview},
 #endif
   {NULL, NULL}
 };
@@ -2132,6 +2297,9 @@ static void createmetatable (lua_State *L) {
 LUAMOD_API int luaopen_string (lua_State *L) {
   luaL_newlib(L, strlib);
   createmetatable(L);
+#if defined(LUAGLM_EXT_BLOB)
+  createblobview(L);
+#endif
   return 1;
 }
 
@@ -162,7 +162,8 @@ static Node *mainpositionTV (const Table *t, const TValue *key) {
     case LUA_VVECTOR2:
     case LUA_VVECTOR3:
     case LUA_VVECTOR4:
-    case LUA_VQUAT: {
+    case LUA_VQUAT:
+    case LUA_VMATRIX2: {
       return hashmod(t, glmVec_hash(key));
     }
     case LUA_VSHRSTR: {
@@ -240,10 +241,11 @@ static int equalkey (const TValue *k1, const Node *n2, int deadok) {
       return fvalue(k1) == fvalueraw(keyval(n2));
     case ctb(LUA_VLNGSTR):
       return luaS_eqlngstr(tsvalue(k1), keystrval(n2));
-    case LUA_VVECTOR2:
-    case LUA_VVECTOR3:
-    case LUA_VVECTOR4:
-    case LUA_VQUAT:
+    case vectt(LUA_VVECTOR2):
+    case vectt(LUA_VVECTOR3):
+    case vectt(LUA_VVECTOR4):
+    case vectt(LUA_VQUAT):
+    case LUA_VMATRIX2:
       return glmVec_equalKey(k1, n2, keytt(n2));
 #if defined(LUAGLM_EXT_BLOB)
     case ctb(LUA_VBLOBSTR):  /* blobs stored by pointer */
@@ -696,7 +698,7 @@ void luaH_newkey (lua_State *L, Table *t, const TValue *key, TValue *value) {
     else if (l_unlikely(luai_numisnan(f)))
       luaG_runerror(L, "table index is NaN");
   }
-  else if (ttisvector(key)) {
+  else if (ttisvector(key) || ttisinlinematrix(key)) {
     if (l_unlikely(!glmVec_isfinite(key))) {
       luaG_runerror(L, "vector index has NaN component");
     }
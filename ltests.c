@@ -26,6 +26,7 @@
 #include "ldebug.h"
 #include "ldo.h"
 #include "lfunc.h"
+#include "ljit.h"
 #include "lmem.h"
 #include "lopcodes.h"
 #include "lopnames.h"
@@ -493,6 +494,9 @@ static void checkrefs (global_State *g, GCObject *o) {
       checkproto(g, gco2p(o));
       break;
     }
+#if defined(LUAGLM_COMPACT_VALUE)
+    case LUA_VVECTOR3: case LUA_VVECTOR4: case LUA_VQUAT:
+#endif
     case LUA_VMATRIX:
     case LUA_VSHRSTR:
 #if defined(LUAGLM_EXT_BLOB)
@@ -754,6 +758,29 @@ static int listcode (lua_State *L) {
 }
 
 
+#if defined(LUAGLM_EXT_JIT)
+/*
+** Compile a function into native code (if not done yet) and return the
+** number of its instructions with native code, or nil if it has none.
+*/
+static int jitcode (lua_State *L) {
+  int pc, n = 0;
+  Proto *p;
+  luaL_argcheck(L, lua_isfunction(L, 1) && !lua_iscfunction(L, 1),
+                 1, "Lua function expected");
+  p = getproto(obj_at(L, 1));
+  if (p->jit == NULL && p->jithot > 0)
+    luaJ_compile(L, p);
+  if (p->jit == NULL)
+    return 0;
+  for (pc=0; pc<p->sizecode; pc++)
+    n += luaJ_isnative(p, pc);
+  lua_pushinteger(L, n);
+  return 1;
+}
+#endif
+
+
 static int printcode (lua_State *L) {
   int pc;
   Proto *p;
@@ -2035,6 +2062,9 @@ static const struct luaL_Reg tests_funcs[] = {
   {"log2", log2_aux},
   {"limits", get_limits},
   {"listcode", listcode},
+#if defined(LUAGLM_EXT_JIT)
+  {"jitcode", jitcode},
+#endif
   {"printcode", printcode},
   {"listk", listk},
   {"listabslineinfo", listabslineinfo},
@@ -143,6 +143,9 @@ static int callbinTM (lua_State *L, const TValue *p1, const TValue *p2,
     tm = luaT_gettmbyobj(L, p2, event);  /* try second operand */
   if (notm(tm)) return 0;
   luaT_callTMres(L, tm, p1, p2, res);
+#if defined(LUAGLM_EXT_INPLACE)
+  G(L)->lastmat = NULL;  /* the result of a metamethod may be shared */
+#endif
   return 1;
 }
 
@@ -160,6 +163,7 @@ void luaT_trybinTM (lua_State *L, const TValue *p1, const TValue *p2,
   */
   if (ttisvector(p1) || ttismatrix(p1) || ttisvector(p2) || ttismatrix(p2)) {
     if (l_likely(glm_trybinTM(L, p1, p2, res, event))) {
+      luaC_checkvecGC(L);
       return;
     }
   }
@@ -187,7 +191,7 @@ void luaT_tryconcatTM (lua_State *L) {
   const TValue *p2 = s2v(top - 1);
   if (l_unlikely(!callbinTM(L, p1, p2, top - 2, TM_CONCAT))) {
     /* Append a value to the vector, increasing its dimensions. */
-    if (ttisvector(p1) && glmVec_concat(p1, p2, top - 2))
+    if (ttisvector(p1) && glmVec_concat(L, p1, p2, top - 2))
       return;
 
     luaG_concaterror(L, p1, p2);
@@ -311,6 +311,53 @@ LUA_API char *(lua_tostringblob) (lua_State *L, int idx, size_t *len);
 
 /* Pushes the string pointed to by s with size len onto the stack as a blob variant. */
 LUA_API char *(lua_pushblob) (lua_State *L, size_t len);
+
+/*
+** Typed blob elements: tightly packed single-precision components, i.e.,
+** string.pack("f") compatible. Quaternions are stored (x, y, z, w) and
+** matrices are column-major.
+*/
+#define LUA_BLOBVEC2	0
+#define LUA_BLOBVEC3	1
+#define LUA_BLOBVEC4	2
+#define LUA_BLOBQUAT	3
+#define LUA_BLOBFLOAT	4
+#define LUA_BLOBMAT4	5
+
+#define lua_blobsize(t)	(sizeof(float) * ((t) == LUA_BLOBMAT4 ? 16 \
+                          : (t) == LUA_BLOBFLOAT ? 1                    \
+                          : (t) == LUA_BLOBQUAT ? 4 : (t) + 2))
+
+/*
+** Header of a blob view: a full userdata, whose first user value is the
+** viewed blob, of 'count' elements starting 'offset' bytes into the blob.
+*/
+typedef struct lua_BlobView {
+  size_t offset;
+  size_t count;
+  int type;
+} lua_BlobView;
+
+/*
+** Pushes the element of the given type stored 'offset' bytes into the string
+** at the given index. Returns the type of the pushed value or LUA_TNIL if the
+** element is out of bounds (nil is pushed).
+*/
+LUA_API int (lua_blobget) (lua_State *L, int idx, size_t offset, int type);
+
+/*
+** Pops a value from the stack and stores it as an element of the given type
+** 'offset' bytes into the blob at the given index. Returns 0 if the value is
+** not of that type or the element is out of bounds.
+*/
+LUA_API int (lua_blobset) (lua_State *L, int idx, size_t offset, int type);
+
+/*
+** Sets the table at the given index as the metatable of blob views: indexing
+** a userdata with this metatable by an in-bounds integer key is handled by
+** the virtual machine without invoking its metamethods.
+*/
+LUA_API void (lua_setblobview) (lua_State *L, int idx);
 #endif
 
 /*
@@ -365,6 +412,10 @@ LUA_API void (lua_warning)  (lua_State *L, const char *msg, int tocont);
 #define LUA_GCISRUNNING		9
 #define LUA_GCGEN		10
 #define LUA_GCINC		11
+#if defined(LUAGLM_EXT_GCPOOL)
+#define LUA_GCPOOL		12
+#define LUA_GCSETPOOL		13
+#endif
 
 LUA_API int (lua_gc) (lua_State *L, int what, ...);
 
@@ -19,6 +19,7 @@
 #include "lauxlib.h"
 
 #include "ldebug.h"
+#include "lglm_core.h"
 #include "lobject.h"
 #include "lopcodes.h"
 #include "lopnames.h"
@@ -34,6 +35,7 @@ static void PrintFunction(const Proto* f, int full);
 static int listing=0;			/* list bytecodes? */
 static int dumping=1;			/* dump bytecodes? */
 static int stripping=0;			/* strip debug information? */
+static int optimizing=0;		/* run the optimizing pass? */
 static char Output[]={ OUTPUT };	/* default output file name */
 static const char* output=Output;	/* actual output file name */
 static const char* progname=PROGNAME;	/* actual program name */
@@ -62,6 +64,7 @@ static l_noret usage(const char* message)
   "Available options are:\n"
   "  -l       list (use -l -l for full listing)\n"
   "  -o name  output to file 'name' (default is \"%s\")\n"
+  "  -O       optimize generated code\n"
   "  -p       parse only\n"
   "  -s       strip debug information\n"
   "  -v       show version information\n"
@@ -99,6 +102,8 @@ static int doargs(int argc, char* argv[])
     usage("'-o' needs argument");
    if (IS("-")) output=NULL;
   }
+  else if (IS("-O"))			/* optimize */
+   optimizing=1;
   else if (IS("-p"))			/* parse only */
    dumping=0;
   else if (IS("-s"))			/* strip debug information */
@@ -178,7 +183,8 @@ static int pmain(lua_State* L)
  for (i=0; i<argc; i++)
  {
   const char* filename=IS("-") ? NULL : argv[i];
-  if (luaL_loadfile(L,filename)!=LUA_OK) fatal(lua_tostring(L,-1));
+  if (luaL_loadfilex(L,filename,optimizing ? "btO" : NULL)!=LUA_OK)
+   fatal(lua_tostring(L,-1));
  }
  f=combine(L,argc);
  if (listing) luaU_print(f,listing>1);
@@ -286,6 +292,12 @@ static void PrintType(const Proto* f, int i)
   case LUA_VLNGSTR:
 	printf("S");
 	break;
+  case LUA_VVECTOR2:
+  case LUA_VVECTOR3:
+  case LUA_VVECTOR4:
+  case LUA_VQUAT:
+	printf("V");
+	break;
   default:				/* cannot happen */
 	printf("?%d",ttypetag(o));
 	break;
@@ -322,6 +334,16 @@ static void PrintConstant(const Proto* f, int i)
   case LUA_VLNGSTR:
 	PrintString(tsvalue(o));
 	break;
+  case LUA_VVECTOR2:
+  case LUA_VVECTOR3:
+  case LUA_VVECTOR4:
+  case LUA_VQUAT:
+	{
+	char buff[GLM_STRING_BUFFER];
+	glmVec_tostr(o,buff,sizeof(buff));
+	printf("%s",buff);
+	break;
+	}
   default:				/* cannot happen */
 	printf("?%d",ttypetag(o));
 	break;
@@ -524,6 +546,7 @@ static void PrintCode(const Proto* f)
    case OP_MMBIN:
 	printf("%d %d %d",a,b,c);
 	printf(COMMENT "%s",eventname(c));
+	if (isk) printf(" temp");
 	break;
    case OP_MMBINI:
 	printf("%d %d %d %d",a,sb,c,isk);
@@ -643,6 +666,11 @@ static void PrintCode(const Proto* f)
 	  printf(COMMENT "%p",VOID(f->p[bx]));
 	  break;
    }
+#endif
+#if defined(LUAGLM_EXT_CONSTVEC)
+   case OP_CHECKCTOR:
+	printf("%d %d",a,b);
+	break;
 #endif
    case OP_CLOSURE:
 	printf("%d %d",a,bx);
@@ -886,6 +886,17 @@
   #define LUAGLM_INT_TYPE int
 #endif
 
+/*
+@@ LUAGLM_COMPACT_VALUE Restrict the Value payload to 8-bytes, i.e., a TValue
+** is 16-bytes rather than 24/32-bytes. Two-dimensional vectors are stored
+** inline; all other vectors and quaternions are collectable objects. This
+** trades an allocation per vector temporary for a smaller stack, table array,
+** and node footprint.
+*/
+#if defined(LUAGLM_COMPACT_VALUE) && LUA_VEC_TYPE != LUA_FLOAT_FLOAT
+  #error "LUAGLM_COMPACT_VALUE requires single-precision vectors!"
+#endif
+
 /*
 @@ LUAGLM_ALIGN Alignment macro for improved compiler intrinsics.
 **
@@ -958,6 +969,18 @@
 #define LUAGLM_MATRIX_4x4 LUAGLM_MATRIX_TYPE(4, 4)
 #define LUAGLM_MATRIX_INVALID 11
 
+/*
+@@ LUAGLM_MATRIX_STRIDE Number of components between two column vectors of size
+**  R. GLM implicitly aligns vec3 when aligned gentypes are forced.
+@@ LUAGLM_MATRIX_LENGTH Number of components required to store a matrix type.
+*/
+#if defined(LUAGLM_FORCES_ALIGNED_GENTYPES)
+#define LUAGLM_MATRIX_STRIDE(R) ((R) == 3 ? 4 : (R))  /* @ImplicitAlign */
+#else
+#define LUAGLM_MATRIX_STRIDE(R) (R)
+#endif
+#define LUAGLM_MATRIX_LENGTH(T) (LUAGLM_MATRIX_COLS(T) * LUAGLM_MATRIX_STRIDE(LUAGLM_MATRIX_ROWS(T)))
+
 /*
 ** GLM_FORCE_SIZE_T_LENGTH forces length_t to be size_t. Otherwise, defined as
 ** an int as GLSL declares it. This requires synchronization across the C and
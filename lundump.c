@@ -216,7 +216,8 @@ static void loadConstants (LoadState *S, Proto *f) {
       case LUA_VVECTOR3:
       case LUA_VVECTOR4:
       case LUA_VQUAT:
-        setvvalue(o, loadVectorType(S, t), cast_byte(t));
+        setvvalue(S->L, o, loadVectorType(S, t), cast_byte(t));
+        luaC_barrier(S->L, f, o);  /* may be collectable */
         break;
       case LUA_VSHRSTR:
 #if defined(LUAGLM_EXT_BLOB)
@@ -22,6 +22,8 @@
 #include "ldo.h"
 #include "lfunc.h"
 #include "lgc.h"
+#include "lgrit_lib.h"
+#include "ljit.h"
 #include "lobject.h"
 #include "lglm_core.h"
 #include "lopcodes.h"
@@ -304,6 +306,10 @@ void luaV_finishget (lua_State *L, const TValue *t, TValue *key, StkId val,
   for (loop = 0; loop < MAXTAGLOOP; loop++) {
     if (slot == NULL) {  /* 't' is not a table? */
       lua_assert(!ttistable(t));
+#if defined(LUAGLM_EXT_BLOB)
+      if (glmBlob_viewget(L, t, key, val))
+        return;  /* element of a typed blob view */
+#endif
       tm = luaT_gettmbyobj(L, t, TM_INDEX);
       if (l_unlikely(notm(tm)))
         luaG_typeerror(L, t, "index");  /* no metamethod */
@@ -367,6 +373,10 @@ void luaV_finishset (lua_State *L, const TValue *t, TValue *key,
       /* else will try the metamethod */
     }
     else {  /* not a table; check metamethod */
+#if defined(LUAGLM_EXT_BLOB)
+      if (glmBlob_viewset(L, t, key, val))
+        return;  /* element of a typed blob view */
+#endif
       tm = luaT_gettmbyobj(L, t, TM_NEWINDEX);
       if (l_unlikely(notm(tm)))
         luaG_typeerror(L, t, ttisvector(t) ? "mutate" : "index");
@@ -590,7 +600,9 @@ int luaV_lessequal (lua_State *L, const TValue *l, const TValue *r) {
 int luaV_equalobj (lua_State *L, const TValue *t1, const TValue *t2) {
   const TValue *tm;
   if (ttypetag(t1) != ttypetag(t2)) {  /* not the same variant? */
-    if (ttype(t1) != ttype(t2) || ttype(t1) != LUA_TNUMBER)
+    if (ttismatrix(t1) && ttismatrix(t2))  /* inline and collectable matrix? */
+      return glmMat_equalObj(L, t1, t2);
+    else if (ttype(t1) != ttype(t2) || ttype(t1) != LUA_TNUMBER)
       return 0;  /* only numbers can be equal with different variants */
     else {  /* two numbers with different variants */
       /* One of them is an integer. If the other does not have an
@@ -619,6 +631,7 @@ int luaV_equalobj (lua_State *L, const TValue *t1, const TValue *t2) {
     case LUA_VVECTOR4: return glmVec_equalObj(L, t1, t2);
     case LUA_VQUAT: return glmVec_equalObj(L, t1, t2);
     case LUA_VMATRIX: return glmMat_equalObj(L, t1, t2);
+    case LUA_VMATRIX2: return glmMat_equalObj(L, t1, t2);
     case LUA_VUSERDATA: {
       if (uvalue(t1) == uvalue(t2)) return 1;
       else if (L == NULL) return 0;
@@ -723,6 +736,7 @@ void luaV_objlen (lua_State *L, StkId ra, const TValue *rb) {
       glmVec_objlen(rb, ra);
       return;
     case LUA_VMATRIX:
+    case LUA_VMATRIX2:
       glmMat_objlen(rb, ra);
       return;
     case LUA_VTABLE: {
@@ -938,6 +952,17 @@ void luaV_finishOp (lua_State *L) {
 #define l_gei(a,b)	(a >= b)
 
 
+/*
+** LuaGLM: component-wise vector/quaternion arithmetic that would otherwise
+** be handled by the following OP_MMBIN instruction. 'tm' is constant for
+** each instance of this macro, so the test folds away for all operations
+** without a fast path.
+*/
+#define op_arithV(L,v1,v2,tm) {  \
+  if (glmVec_hasfastarith(tm) && glmVec_fastarith(L, v1, v2, ra, tm)) {  \
+    pc++; checkvecGC(L); }}
+
+
 /*
 ** Arithmetic operations with immediate operands. 'iop' is the integer
 ** operation, 'fop' is the float operation.
@@ -953,6 +978,10 @@ void luaV_finishOp (lua_State *L) {
     lua_Number nb = fltvalue(v1);  \
     lua_Number fimm = cast_num(imm);  \
     pc++; setfltvalue(s2v(ra), fop(L, nb, fimm)); \
+  }  \
+  else if (ttisvector(v1)) {  \
+    TValue vimm; setivalue(&vimm, imm);  \
+    op_arithV(L, v1, &vimm, TM_ADD);  \
   }}
 
 
@@ -960,58 +989,60 @@ void luaV_finishOp (lua_State *L) {
 ** Auxiliary function for arithmetic operations over floats and others
 ** with two register operands.
 */
-#define op_arithf_aux(L,v1,v2,fop) {  \
+#define op_arithf_aux(L,v1,v2,fop,tm) {  \
   lua_Number n1; lua_Number n2;  \
   if (tonumberns(v1, n1) && tonumberns(v2, n2)) {  \
     pc++; setfltvalue(s2v(ra), fop(L, n1, n2));  \
-  }}
+  }  \
+  else op_arithV(L, v1, v2, tm); }
 
 
 /*
 ** Arithmetic operations over floats and others with register operands.
 */
-#define op_arithf(L,fop) {  \
+#define op_arithf(L,fop,tm) {  \
   TValue *v1 = vRB(i);  \
   TValue *v2 = vRC(i);  \
-  op_arithf_aux(L, v1, v2, fop); }
+  op_arithf_aux(L, v1, v2, fop, tm); }
 
 
 /*
 ** Arithmetic operations with K operands for floats.
 */
-#define op_arithfK(L,fop) {  \
+#define op_arithfK(L,fop,tm) {  \
   TValue *v1 = vRB(i);  \
-  TValue *v2 = KC(i); lua_assert(ttisnumber(v2));  \
-  op_arithf_aux(L, v1, v2, fop); }
+  TValue *v2 = KC(i); lua_assert(ttisnumber(v2) || ttisvector(v2));  \
+  op_arithf_aux(L, v1, v2, fop, tm); }
 
 
 /*
 ** Arithmetic operations over integers and floats.
 */
-#define op_arith_aux(L,v1,v2,iop,fop) {  \
+#define op_arith_aux(L,v1,v2,iop,fop,tm) {  \
   if (ttisinteger(v1) && ttisinteger(v2)) {  \
     lua_Integer i1 = ivalue(v1); lua_Integer i2 = ivalue(v2);  \
     pc++; setivalue(s2v(ra), iop(L, i1, i2));  \
   }  \
-  else op_arithf_aux(L, v1, v2, fop); }
+  else op_arithf_aux(L, v1, v2, fop, tm); }
 
 
 /*
 ** Arithmetic operations with register operands.
 */
-#define op_arith(L,iop,fop) {  \
+#define op_arith(L,iop,fop,tm) {  \
   TValue *v1 = vRB(i);  \
   TValue *v2 = vRC(i);  \
-  op_arith_aux(L, v1, v2, iop, fop); }
+  op_arith_aux(L, v1, v2, iop, fop, tm); }
 
 
 /*
-** Arithmetic operations with K operands.
+** Arithmetic operations with K operands. (LuaGLM: the K operand may be a
+** vector constant, which is handled by op_arithV.)
 */
-#define op_arithK(L,iop,fop) {  \
+#define op_arithK(L,iop,fop,tm) {  \
   TValue *v1 = vRB(i);  \
-  TValue *v2 = KC(i); lua_assert(ttisnumber(v2));  \
-  op_arith_aux(L, v1, v2, iop, fop); }
+  TValue *v2 = KC(i); lua_assert(ttisnumber(v2) || ttisvector(v2));  \
+  op_arith_aux(L, v1, v2, iop, fop, tm); }
 
 
 /*
@@ -1082,6 +1113,113 @@ void luaV_finishOp (lua_State *L) {
 /* }================================================================== */
 
 
+#if defined(LUAGLM_EXT_CONSTVEC)
+/*
+** Check whether 'o' is the builtin constructor of vector variant 'tt', i.e.,
+** the function whose calls were folded by 'luaK_constvec'.
+*/
+static int isvecctor (const TValue *o, int tt) {
+  lua_CFunction f;
+  switch (tt) {
+    case LUA_VVECTOR2: f = glmVec_vec2; break;
+    case LUA_VVECTOR3: f = glmVec_vec3; break;
+    case LUA_VVECTOR4: f = glmVec_vec4; break;
+    case LUA_VQUAT: f = glmVec_qua; break;
+    default: return 0;
+  }
+  return ttislcf(o) && fvalue(o) == f;
+}
+#endif
+
+
+#if defined(LUAGLM_EXT_FASTCALL)
+/*
+** {==================================================================
+** Fast functions
+** ===================================================================
+*/
+
+#define fasthash(f)	lmod(point2uint(f) >> 4, FASTCALL_N)
+
+
+/*
+** Register 'fast' as the typed variant of light C function 'f' when called
+** with 'nargs' arguments of signature 'sig' (see 'luaV_sigarg'), replacing
+** any previous variant of the same signature. Returns 0 if the registry is
+** full (one entry is always kept empty to terminate lookups).
+*/
+int luaV_setfastcall (lua_State *L, lua_CFunction f, int nargs,
+                                    unsigned int sig, FastFunction fast) {
+  global_State *g = G(L);
+  FastCall *fc = NULL;
+  int i, used = 0;
+  lua_assert(f != NULL && fast != NULL);
+  if (nargs < 0 || nargs > FASTCALL_MAXARGS)
+    return 0;
+  for (i = 0; i < FASTCALL_N; i++) {
+    const FastCall *e = &g->fastcall[i];
+    if (e->f != NULL) {
+      used++;
+      if (e->f == f && e->nargs == nargs && e->sig == sig)
+        fc = &g->fastcall[i];  /* replace existing variant */
+    }
+  }
+  if (fc == NULL) {
+    if (used >= FASTCALL_N - 1)
+      return 0;
+    for (i = fasthash(f); g->fastcall[i].f != NULL; i = lmod(i + 1, FASTCALL_N))
+      ;
+    fc = &g->fastcall[i];
+  }
+  fc->f = f;
+  fc->fast = fast;
+  fc->sig = sig;
+  fc->nargs = cast_byte(nargs);
+  return 1;
+}
+
+
+/*
+** Try to call the light C function at 'func', whose arguments end at
+** 'L->top', through one of its fast functions. On success, adjust the
+** results as 'luaD_poscall' would and return 1; return 0 if no variant
+** matches the arguments of the call.
+*/
+static int fastcall (lua_State *L, StkId func, int nresults) {
+  global_State *g = G(L);
+  lua_CFunction f = fvalue(s2v(func));
+  int nargs = cast_int(L->top - func) - 1;
+  unsigned int sig = 0;
+  int i, insig = 0;
+  for (i = fasthash(f); g->fastcall[i].f != NULL; i = lmod(i + 1, FASTCALL_N)) {
+    const FastCall *fc = &g->fastcall[i];
+    if (fc->f != f || fc->nargs != nargs)
+      continue;
+    if (!insig) {  /* compute signature of the call (once) */
+      int n;
+      for (n = nargs; n > 0; n--)
+        sig = (sig << 8) | luaV_sigtag(s2v(func + n));
+      insig = 1;
+    }
+    if (fc->sig == sig) {
+      fc->fast(L, func);
+      if (nresults < 0)  /* multiple results? */
+        L->top = func + 1;
+      else {
+        for (i = 1; i < nresults; i++)
+          setnilvalue(s2v(func + i));  /* complete missing results */
+        L->top = func + nresults;
+      }
+      return 1;
+    }
+  }
+  return 0;
+}
+
+/* }================================================================== */
+#endif
+
+
 /*
 ** {==================================================================
 ** Function 'luaV_execute': main interpreter loop
@@ -1165,12 +1303,52 @@ void luaV_finishOp (lua_State *L) {
                          updatetrap(ci)); \
            luai_threadyield(L); }
 
+/*
+** 'checkGC' after a vector was created by a fast path: a no-op unless vectors
+** are collectable (see luaC_checkvecGC). Registers are assumed live.
+*/
+#if defined(LUAGLM_COMPACT_VALUE)
+#define checkvecGC(L)	checkGC(L, ci->top)
+#else
+#define checkvecGC(L)	((void)0)
+#endif
+
+
+#if defined(LUAGLM_EXT_JIT)
+/*
+** Native code of the running function can run (no hooks): 'trap' is only
+** on because of the stack or because native code left instruction 'jitpc'
+** to the interpreter (see 'jitenter'). Go back to native code once that
+** instruction has run.
+*/
+#define jitready()	(cl->p->jit != NULL && !L->hookmask)
+
+#define jitresume()  \
+	{ updatebase(ci); \
+    if (pc != jitpc) { ci->u.l.trap = 0; goto jitenter; } }
+
+/*
+** Interpreted back jump: go to native code of the running function, after
+** counting the jump towards compiling it
+*/
+#define jitloop(ci)  \
+	{ if (luaJ_ishot(L, cl->p)) { \
+      jitpc = NULL; trap = ci->u.l.trap = 1;  /* enter it */ } }
+#else
+#define jitready()	0
+#define jitresume()	((void)0)
+#define jitloop(ci)	((void)0)
+#endif
+
 
 /* fetch an instruction and prepare its execution */
 #define vmfetch()	{ \
   if (l_unlikely(trap)) {  /* stack reallocation or hooks? */ \
-    trap = luaG_traceexec(L, pc);  /* handle hooks */ \
-    updatebase(ci);  /* correct stack */ \
+    if (jitready()) { jitresume(); } \
+    else { \
+      trap = luaG_traceexec(L, pc);  /* handle hooks */ \
+      updatebase(ci);  /* correct stack */ \
+    } \
   } \
   i = *(pc++); \
   ra = RA(i); /* WARNING: any stack reallocation invalidates 'ra' */ \
@@ -1187,6 +1365,9 @@ LUA_JUMPTABLE_ATTRIBUTE void luaV_execute (lua_State *L, CallInfo *ci) {
   StkId base;
   const Instruction *pc;
   int trap;
+#if defined(LUAGLM_EXT_JIT)
+  const Instruction *jitpc = NULL;  /* where native code was left */
+#endif
 #if LUA_USE_JUMPTABLE
 #include "ljumptab.h"
 #endif
@@ -1206,6 +1387,20 @@ LUA_JUMPTABLE_ATTRIBUTE void luaV_execute (lua_State *L, CallInfo *ci) {
     ci->u.l.trap = 1;  /* assume trap is on, for now */
   }
   base = ci->func + 1;
+#if defined(LUAGLM_EXT_JIT)
+  if (!trap && !L->hookmask && luaJ_ishot(L, cl->p)) {
+   jitenter:  /* run native code from 'pc' */
+    pc = luaJ_execute(L, ci, pc);
+    if (pc == NULL)  /* function returned? */
+      goto ret;
+    else if (!luaJ_isnative(cl->p, cast_int(pc - cl->p->code))) {
+      jitpc = pc;  /* interpret this instruction... */
+      trap = ci->u.l.trap = 1;  /* ...and come back after it */
+    }
+    else  /* a fast path failed: interpret until a back jump or return */
+      updatetrap(ci);
+  }
+#endif
   /* main loop of interpreter */
   for (;;) {
     Instruction i;  /* instruction being executed */
@@ -1283,6 +1478,7 @@ LUA_JUMPTABLE_ATTRIBUTE void luaV_execute (lua_State *L, CallInfo *ci) {
         if (ttisvector(upval)) {
           if (l_unlikely(!glmVec_fastgets(upval, key, ra))) {
             Protect(glmVec_get(L, upval, rc, ra));
+            checkvecGC(L);
           }
         }
         else {
@@ -1302,12 +1498,14 @@ LUA_JUMPTABLE_ATTRIBUTE void luaV_execute (lua_State *L, CallInfo *ci) {
           if (!(ttisinteger(rc) && glmVec_fastgeti(rb, ivalue(rc), ra))
               && !(ttisstring(rc) && glmVec_fastgets(rb, tsvalue(rc), ra))) {
             Protect(glmVec_get(L, rb, rc, ra));
+            checkvecGC(L);
           }
         }
         else if (ttismatrix(rb)) {  /* fast track for integers? */
-          if (!(ttisinteger(rc) && glmMat_fastgeti(rb, ivalue(rc), ra))) {
+          if (!(ttisinteger(rc) && glmMat_fastgeti(L, rb, ivalue(rc), ra))) {
             Protect(glmMat_get(L, rb, rc, ra));
           }
+          checkvecGC(L);
         }
         else {
           const TValue *slot;
@@ -1331,9 +1529,10 @@ LUA_JUMPTABLE_ATTRIBUTE void luaV_execute (lua_State *L, CallInfo *ci) {
           }
         }
         else if (ttismatrix(rb)) {
-          if (l_unlikely(!glmMat_fastgeti(rb, c, ra))) {
+          if (l_unlikely(!glmMat_fastgeti(L, rb, c, ra))) {
             Protect(glmMat_geti(L, rb, c, ra));
           }
+          checkvecGC(L);
         }
         else {
           const TValue *slot;
@@ -1353,8 +1552,10 @@ LUA_JUMPTABLE_ATTRIBUTE void luaV_execute (lua_State *L, CallInfo *ci) {
         TValue *rc = KC(i);
         TString *key = tsvalue(rc);  /* key must be a string */
         if (ttisvector(rb)) {
-          if (l_unlikely(!glmVec_fastgets(rb, key, ra))) {
+          if (l_unlikely(!glmVec_fastgets(rb, key, ra)
+                         && !glmVec_fastswizzle(L, rb, key, ra))) {
             Protect(glmVec_get(L, rb, rc, ra));
+            checkvecGC(L);
           }
         }
         else {
@@ -1464,8 +1665,17 @@ LUA_JUMPTABLE_ATTRIBUTE void luaV_execute (lua_State *L, CallInfo *ci) {
         TString *key = tsvalue(rc);  /* key must be a string */
         setobj2s(L, ra + 1, rb);
         if (ttisvector(rb)) {  /* key must be a string */
-          if (l_unlikely(!glmVec_fastgets(rb, key, ra))) {
+          if (l_unlikely(!glmVec_fastgets(rb, key, ra)
+                         && !glm_fastself(L, pc, rb, key, ra))) {
+            halfProtect(glm_cacheself(L, pc, rb, key));
             Protect(glmVec_get(L, rb, rc, ra));
+            checkvecGC(L);
+          }
+        }
+        else if (ttismatrix(rb)) {  /* method of the matrix metatable */
+          if (l_unlikely(!glm_fastself(L, pc, rb, key, ra))) {
+            halfProtect(glm_cacheself(L, pc, rb, key));
+            Protect(luaV_finishget(L, rb, rc, ra, NULL));
           }
         }
         else {
@@ -1483,31 +1693,31 @@ LUA_JUMPTABLE_ATTRIBUTE void luaV_execute (lua_State *L, CallInfo *ci) {
         vmbreak;
       }
       vmcase(OP_ADDK) {
-        op_arithK(L, l_addi, luai_numadd);
+        op_arithK(L, l_addi, luai_numadd, TM_ADD);
         vmbreak;
       }
       vmcase(OP_SUBK) {
-        op_arithK(L, l_subi, luai_numsub);
+        op_arithK(L, l_subi, luai_numsub, TM_SUB);
         vmbreak;
       }
       vmcase(OP_MULK) {
-        op_arithK(L, l_muli, luai_nummul);
+        op_arithK(L, l_muli, luai_nummul, TM_MUL);
         vmbreak;
       }
       vmcase(OP_MODK) {
-        op_arithK(L, luaV_mod, luaV_modf);
+        op_arithK(L, luaV_mod, luaV_modf, TM_MOD);
         vmbreak;
       }
       vmcase(OP_POWK) {
-        op_arithfK(L, luai_numpow);
+        op_arithfK(L, luai_numpow, TM_POW);
         vmbreak;
       }
       vmcase(OP_DIVK) {
-        op_arithfK(L, luai_numdiv);
+        op_arithfK(L, luai_numdiv, TM_DIV);
         vmbreak;
       }
       vmcase(OP_IDIVK) {
-        op_arithK(L, luaV_idiv, luai_numidiv);
+        op_arithK(L, luaV_idiv, luai_numidiv, TM_IDIV);
         vmbreak;
       }
       vmcase(OP_BANDK) {
@@ -1541,31 +1751,31 @@ LUA_JUMPTABLE_ATTRIBUTE void luaV_execute (lua_State *L, CallInfo *ci) {
         vmbreak;
       }
       vmcase(OP_ADD) {
-        op_arith(L, l_addi, luai_numadd);
+        op_arith(L, l_addi, luai_numadd, TM_ADD);
         vmbreak;
       }
       vmcase(OP_SUB) {
-        op_arith(L, l_subi, luai_numsub);
+        op_arith(L, l_subi, luai_numsub, TM_SUB);
         vmbreak;
       }
       vmcase(OP_MUL) {
-        op_arith(L, l_muli, luai_nummul);
+        op_arith(L, l_muli, luai_nummul, TM_MUL);
         vmbreak;
       }
       vmcase(OP_MOD) {
-        op_arith(L, luaV_mod, luaV_modf);
+        op_arith(L, luaV_mod, luaV_modf, TM_MOD);
         vmbreak;
       }
       vmcase(OP_POW) {
-        op_arithf(L, luai_numpow);
+        op_arithf(L, luai_numpow, TM_POW);
         vmbreak;
       }
       vmcase(OP_DIV) {  /* float division (always with floats) */
-        op_arithf(L, luai_numdiv);
+        op_arithf(L, luai_numdiv, TM_DIV);
         vmbreak;
       }
       vmcase(OP_IDIV) {  /* floor division */
-        op_arith(L, luaV_idiv, luai_numidiv);
+        op_arith(L, luaV_idiv, luai_numidiv, TM_IDIV);
         vmbreak;
       }
       vmcase(OP_BAND) {
@@ -1594,6 +1804,11 @@ LUA_JUMPTABLE_ATTRIBUTE void luaV_execute (lua_State *L, CallInfo *ci) {
         TMS tm = (TMS)GETARG_C(i);
         StkId result = RA(pi);
         lua_assert(OP_ADD <= GET_OPCODE(pi) && GET_OPCODE(pi) <= OP_SHR);
+#if defined(LUAGLM_EXT_INPLACE)
+        /* R[A] dies here; reuse its matrix if no one else has seen it */
+        if (GETARG_k(i) && ttisfullmatrix(s2v(ra)) && gcvalue(s2v(ra)) == G(L)->lastmat)
+          G(L)->deadmat = gcvalue(s2v(ra));
+#endif
         Protect(luaT_trybinTM(L, s2v(ra), rb, result, tm));
         vmbreak;
       }
@@ -1625,6 +1840,9 @@ LUA_JUMPTABLE_ATTRIBUTE void luaV_execute (lua_State *L, CallInfo *ci) {
         else if (tonumberns(rb, nb)) {
           setfltvalue(s2v(ra), luai_numunm(L, nb));
         }
+        else if (glmVec_fastarith(L, rb, rb, ra, TM_UNM)) {
+          checkvecGC(L);
+        }
         else
           Protect(luaT_trybinTM(L, rb, rb, ra, TM_UNM));
         vmbreak;
@@ -1672,6 +1890,8 @@ LUA_JUMPTABLE_ATTRIBUTE void luaV_execute (lua_State *L, CallInfo *ci) {
         vmbreak;
       }
       vmcase(OP_JMP) {
+        if (GETARG_sJ(i) < 0)
+          jitloop(ci);
         dojump(ci, i, 0);
         vmbreak;
       }
@@ -1748,6 +1968,12 @@ LUA_JUMPTABLE_ATTRIBUTE void luaV_execute (lua_State *L, CallInfo *ci) {
           L->top = ra + b;  /* top signals number of arguments */
         /* else previous instruction set top */
         savepc(L);  /* in case of errors */
+#if defined(LUAGLM_EXT_FASTCALL)
+        if (ttislcf(s2v(ra)) && !L->hookmask && fastcall(L, ra, nresults)) {
+          checkGC(L, L->top);  /* fast function may have allocated */
+          vmbreak;
+        }
+#endif
         if ((newci = luaD_precall(L, ra, nresults)) == NULL)
           updatetrap(ci);  /* C call; nothing else to be done */
         else {  /* Lua call: run function in this same C frame */
@@ -1856,10 +2082,13 @@ LUA_JUMPTABLE_ATTRIBUTE void luaV_execute (lua_State *L, CallInfo *ci) {
             chgivalue(s2v(ra), idx);  /* update internal index */
             setivalue(s2v(ra + 3), idx);  /* and control variable */
             pc -= GETARG_Bx(i);  /* jump back */
+            jitloop(ci);
           }
         }
-        else if (floatforloop(ra))  /* float loop */
+        else if (floatforloop(ra)) {  /* float loop */
           pc -= GETARG_Bx(i);  /* jump back */
+          jitloop(ci);
+        }
         updatetrap(ci);  /* allows a signal to break the loop */
         vmbreak;
       }
@@ -1902,6 +2131,7 @@ LUA_JUMPTABLE_ATTRIBUTE void luaV_execute (lua_State *L, CallInfo *ci) {
         if (!ttisnil(s2v(ra + 4))) {  /* continue loop? */
           setobjs2s(L, ra + 2, ra + 4);  /* save control variable */
           pc -= GETARG_Bx(i);  /* jump back */
+          jitloop(ci);
         }
         vmbreak;
       }
@@ -1946,6 +2176,13 @@ LUA_JUMPTABLE_ATTRIBUTE void luaV_execute (lua_State *L, CallInfo *ci) {
         halfProtect(luaF_newtbcupval(L, ra, 1));
         vmbreak;
       }
+#endif
+#if defined(LUAGLM_EXT_CONSTVEC)
+      vmcase(OP_CHECKCTOR) {
+        if (l_unlikely(!isvecctor(s2v(ra), GETARG_B(i))))
+          halfProtect(luaG_ctorerror(L, s2v(ra)));
+        vmbreak;
+      }
 #endif
       vmcase(OP_VARARG) {
         int n = GETARG_C(i) - 1;  /* required results */
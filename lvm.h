@@ -114,6 +114,16 @@ typedef enum {
       luaC_barrierback(L, gcvalue(t), v); }
 
 
+#if defined(LUAGLM_EXT_FASTCALL)
+/*
+** Signature of the arguments of a fast function: the type tags of its
+** arguments packed one byte per argument, the first argument in the lowest
+** byte. Integers are folded into floats.
+*/
+#define luaV_sigtag(o)	cast_uint(ttisinteger(o) ? LUA_VNUMFLT : ttypetag(o))
+#define luaV_sigarg(i,tt)	(cast_uint(tt) << (8 * (i)))
+#endif
+
 
 
 LUAI_FUNC int luaV_equalobj (lua_State *L, const TValue *t1, const TValue *t2);
@@ -136,5 +146,9 @@ LUAI_FUNC lua_Integer luaV_mod (lua_State *L, lua_Integer x, lua_Integer y);
 LUAI_FUNC lua_Number luaV_modf (lua_State *L, lua_Number x, lua_Number y);
 LUAI_FUNC lua_Integer luaV_shiftl (lua_Integer x, lua_Integer y);
 LUAI_FUNC void luaV_objlen (lua_State *L, StkId ra, const TValue *rb);
+#if defined(LUAGLM_EXT_FASTCALL)
+LUAI_FUNC int luaV_setfastcall (lua_State *L, lua_CFunction f, int nargs,
+                                unsigned int sig, FastFunction fast);
+#endif
 
 #endif
@@ -85,6 +85,7 @@
 #include "lparser.c"
 #include "ldebug.c"
 #include "lfunc.c"
+#include "ljit.c"
 #include "lobject.c"
 #include "ltm.c"
 #include "lstring.c"
@@ -302,6 +302,63 @@ checkI(function () return ~(~kFF0 | kFF0) end, 0)
 checkI(function () return ~~-1024.0 end, -1024)
 checkI(function () return ((100 << k6) << -4) >> 2 end, 100)
 
+-- folding of strings, comparisons, and short-circuits
+local kS <const> = "ab"
+checkK(function () return "a" .. "b" .. "c" end, "abc")
+checkK(function () return kS .. "c" end, "abc")
+checkI(function () return #"hello" + #kS end, 7)
+checkR(function (x) return x .. "a" .. "b" end, "x", "xab",
+  'MOVE', 'LOADK', 'CONCAT', 'RETURN1')
+checkKlist(function (x) return x .. "a" .. "b" end, {"ab"})
+check(function () return 1 < 2, k3 >= 4.0, 1 == 1.0, kS ~= "ab" end,
+  'LOADTRUE', 'LOADFALSE', 'LOADTRUE', 'LOADFALSE', 'RETURN')
+check(function () return nil == false, "a" == "a", not (k1 > k3) end,
+  'LOADFALSE', 'LOADTRUE', 'LOADTRUE', 'RETURN')
+check(function () return false and print("x"), kS or print("y") end,
+  'LOADFALSE', 'LOADK', 'RETURN')
+checkKlist(function () return false and print("x"), kS or print("y") end,
+  {"ab"})
+checkR(function (x) return 1 < 2 and x end, 10, 10, 'RETURN1')
+-- order of strings depends on the locale: not folded
+check(function () return "a" < "b" end,
+  'LOADK', 'LOADK', 'LT', 'JMP', 'LFALSESKIP', 'LOADTRUE', 'RETURN1')
+
+-- dead branches
+local kDebug <const> = false
+check(function (x)
+  if kDebug then print("debug") end
+  while kDebug do x = x + 1 end
+  if 1 > 2 then x = 1 elseif x then x = 2 else x = 3 end
+  return x
+end, 'TEST', 'JMP', 'LOADI', 'JMP', 'LOADI', 'RETURN1')
+check(function (x)
+  if x then x = 1 elseif true then x = 2 elseif x then x = 3 else x = 4 end
+  return x
+end, 'TEST', 'JMP', 'LOADI', 'JMP', 'LOADI', 'RETURN1')
+checkKlist(function ()
+  if kDebug then print("debug", 1.5) else return "on" end
+end, {"on"})
+do  -- dead code may create functions, locals, and gotos
+  local function f (a)
+    while nil do local x = function () return a end; goto l; ::l:: end
+    repeat if false then local y = a; break end until true
+    return function () return a end
+  end
+  check(f, 'CLOSURE', 'RETURN')
+  assert(f(10)() == 10)
+  local lines = debug.getinfo(f, "L").activelines
+  local l = debug.getinfo(f, "S").linedefined
+  assert(not lines[l + 1] and not lines[l + 2] and lines[l + 3])
+  local t = {}
+  for i = 1, 3 do
+    if kDebug then break else t[#t + 1] = i end
+  end
+  assert(#t == 3)
+  -- wrong gotos are still errors
+  assert(not load("if false then break end"))
+  assert(not load("while false do goto l end"))
+end
+
 -- borders around MAXARG_sBx ((((1 << 17) - 1) >> 1) == 65535)
 local a = 17; local sbx = ((1 << a) - 1) >> 1   -- avoid folding
 local border <const> = 65535
@@ -445,5 +502,231 @@ do   -- string constants
   assert(T.listk(f2)[1] == nil)
 end
 
+
+-- constant vector constructors (LUAGLM_EXT_CONSTVEC)
+if string.find(table.concat(T.listcode(load"local vec3 <const> = vec3")),
+               "CHECKCTOR") then
+  local vec3 <const> = vec3
+  local quat <const> = quat
+  local up <const> = vec3(0, 1, 0)
+
+  check(function () return vec3(1, 2, 3) end, 'LOADK', 'RETURN1')
+  check(function () return up end, 'LOADK', 'RETURN1')
+  check(function ()
+    local vec4 <const> = vec4
+    return vec4(1, 2, 3, 4.5)
+  end, 'GETTABUP', 'CHECKCTOR', 'LOADK', 'RETURN1')
+
+  -- constants are reused
+  local function f () return vec3(1, 2, 3), vec3(1.0, 2, 3.0), vec3(-1) end
+  checkKlist(f, {vec3(1, 2, 3), vec3(-1)})
+  local a, b, c = f()
+  assert(a == b and c == _ENV.vec3(-1, -1, -1))
+  assert(quat(1, 0, 0, 0) == _ENV.quat() and quat() == _ENV.quat(1, 0, 0, 0))
+
+  -- non-literal arguments and invalid calls are left untouched
+  check(function (x) return vec3(x, 2, 3) end,
+    'GETUPVAL', 'MOVE', 'LOADI', 'LOADI', 'TAILCALL', 'RETURN')
+  check(function () return vec3(1, 2) end,
+    'GETUPVAL', 'LOADI', 'LOADI', 'TAILCALL', 'RETURN')
+  assert(not pcall(function () return vec3(1, 2) end))
+
+  -- vector constants are not compared through EQK
+  check(function (v) return v == up end,
+    'LOADK', 'EQ', 'JMP', 'LFALSESKIP', 'LOADTRUE', 'RETURN1')
+
+  -- vector constants as K operands
+  check(function (p) return p + up end, 'ADDK', 'MMBINK', 'RETURN1')
+  check(function (p) return up * p end, 'MULK', 'MMBINK', 'RETURN1')
+  check(function (p) return p - vec3(1, 2, 3) end, 'SUBK', 'MMBINK', 'RETURN1')
+  check(function (p) return p / vec3(2) end, 'DIVK', 'MMBINK', 'RETURN1')
+  check(function (p) return p % vec3(2) end, 'MODK', 'MMBINK', 'RETURN1')
+  check(function (q) return quat(1, 0, 0, 0) * q end,
+    'MULK', 'MMBINK', 'RETURN1')
+  -- non-commutative operators with a 1st constant operand
+  check(function (p) return vec3(1, 2, 3) - p end,
+    'LOADK', 'SUB', 'MMBIN', 'RETURN1')
+  -- numerals are preferred as immediate and K operands
+  check(function () return up + 1 end, 'LOADK', 'ADDI', 'MMBINI', 'RETURN1')
+  check(function () return 2.5 * up end, 'LOADK', 'MULK', 'MMBINK', 'RETURN1')
+
+  do
+    local V = _ENV.vec3
+    local function f1 (p) return p + up end
+    local function f2 (p) return up + p end
+    local function f3 (p) return vec3(1, 2, 3) - p end
+    local function f4 (p) return p / vec3(2, 4, 8) end
+    assert(f1(V(1, 2, 3)) == V(1, 3, 3) and f2(V(1, 2, 3)) == V(1, 3, 3))
+    assert(f1(2) == V(2, 3, 2) and f2(2) == V(2, 3, 2))
+    assert(f3(V(1)) == V(0, 1, 2) and f3(1) == V(0, 1, 2))
+    assert(f4(V(8)) == V(4, 2, 1) and f4(8) == V(4, 2, 1))
+    assert(not pcall(f1, {}) and not pcall(f2, "x"))
+  end
+
+  -- the constructor is checked at its declaration
+  local g = load"local vec3 <const> = ...; return vec3(1, 2, 3)"
+  assert(g(_ENV.vec3) == vec3(1, 2, 3))
+  local st, msg = pcall(g, print)
+  assert(not st and string.find(msg, "local 'vec3'"))
+end
+
+
+-- in-place temporaries: 'k' in OP_MMBIN flags a first operand that is the
+-- unshared result of another arithmetic operation
+do
+  local function flags (f)   -- 'k' of each OP_MMBIN in 'f'
+    local res = {}
+    for _, l in ipairs(T.listcode(f)) do
+      if string.find(l, "MMBIN ") then
+        res[#res + 1] = string.find(l, "%(k%)$") ~= nil
+      end
+    end
+    return table.unpack(res)
+  end
+
+  local k1, k2, k3 = flags(function (a, b, c) return a * b * c end)
+  if k2 then
+    assert(not k1)
+    k1, k2, k3 = flags(function (a, b, c, d) return (a * b) - (c * d) end)
+    assert(not k1 and not k2 and k3)
+    k1, k2 = flags(function (a, b, c) return -(a + b) / c end)
+    assert(not k1 and k2)
+    -- right operands, locals, and values with jumps are never reused
+    k1, k2 = flags(function (a, b, c) return a * (b * c) end)
+    assert(not k1 and not k2)
+    k1, k2 = flags(function (a, b, c) local x = a * b; return x * c end)
+    assert(not k1 and not k2)
+    k1, k2 = flags(function (a, b, c, d) return (a or b * c) * d end)
+    assert(not k1 and not k2)
+
+    -- results of metamethods may be shared
+    local shared = setmetatable({}, {__mul = function (x) return x end})
+    local o = setmetatable({}, {__mul = function () return shared end})
+    local one, two = 1, 2
+    assert(o * one * two == shared)
+  end
+end
+
+
+-- optimizing pass (load mode 'O')
+do
+  local function opt (s) return assert(load(s, "=opt", "tO"))() end
+
+  -- jumps into returns; the jump following a test is kept
+  check(opt[[return function (x) if x then return 1 else return 2 end end]],
+    'TEST', 'JMP', 'LOADI', 'RETURN1', 'RETURN0', 'LOADI', 'RETURN1',
+    'RETURN0')
+  check(opt[[return function (x) if x then x = 1 else x = 2 end end]],
+    'TEST', 'JMP', 'LOADI', 'RETURN0', 'LOADI', 'RETURN0')
+  -- a jump into a return on another line is kept (line hooks)
+  check(opt"return function (x)\n if x then return 1\n else x = 2 end\nend",
+    'TEST', 'JMP', 'LOADI', 'RETURN1', 'JMP', 'LOADI', 'RETURN0')
+
+  -- same results as the unoptimized code
+  local srcs = {
+    [[local s = 0
+      for i = 1, 10 do if i % 3 == 0 then goto cont end; s = s + i; ::cont:: end
+      for _, v in ipairs{1, 2, 3} do while true do s = s + v; break end end
+      repeat local x = s; if x > 10 then break end until true
+      local function f (a, b) if a then return a and b or not b end end
+      local g; g = function (n) if n <= 1 then return 1 end return n * g(n - 1) end
+      return s, f(1, false), f(nil), g(5), (s > 3) == true]],
+    [[local a, b = 1, 2; a, b = b, a
+      local t = {}; t.x, t.y = a, b
+      local c; c = t.x; local d = c; c = t.y
+      return a, b, c, d, t.x]],
+  }
+  for _, s in ipairs(srcs) do
+    local r1 = table.pack(assert(load(s))())
+    local r2 = table.pack(opt(s))
+    assert(r1.n == r2.n)
+    for i = 1, r1.n do assert(r1[i] == r2[i]) end
+  end
+
+  -- line information is kept
+  local _, msg = pcall(opt, "local x = ...\nif x then return end\n\nerror('x')")
+  assert(string.find(msg, "^opt:4:"))
+  local f = opt"return function (x)\n if x then\n return 1\n end\n end"
+  assert(debug.getinfo(f, "L").activelines[3])
+
+  -- mode 'O' alone accepts no chunk
+  assert(not load("return 1", nil, "O"))
+  assert(load(string.dump(f), nil, "bO"))
+end
+
+
+-- baseline JIT: native code must behave as the interpreter
+if T.jitcode then
+  local function sum (t, n)
+    local s, f = 0, 0.0
+    for i = 1, n do
+      local v = t[i]
+      if v > 2 then s = s + v * 2 else s = s - v end
+      f = f + v / 2
+    end
+    return s, f, s // 3, s % 7, s << 2, -f, not (s == 0)
+  end
+  local t = {1, 2, 3, 4, 5}
+  assert(T.jitcode(sum) > 0)
+  local r = table.pack(sum(t, 5))
+  assert(r[1] == 21 and math.type(r[1]) == "integer" and r[2] == 7.5)
+  assert(r[3] == 7 and r[4] == 0 and r[5] == 84 and r[6] == -7.5 and r[7])
+
+  -- operands of other types exit to the interpreter
+  r = table.pack(sum({1, 2.5, 3, 4.0, 5}, 5))
+  assert(r[1] == 28 and math.type(r[1]) == "float" and r[2] == 7.75)
+  assert(r[3] == 9 and r[5] == 112)
+  local mt = {__lt = function () return true end,
+              __mul = function () return 10 end,
+              __div = function () return 0 end}
+  local o = setmetatable({}, mt)
+  r = table.pack(sum({o}, 1))
+  assert(r[1] == 10 and r[2] == 0 and r[3] == 3 and r[4] == 3)
+  assert(not pcall(sum, {nil, 1}, 2))
+
+  -- arrays: appends, hash parts, and writes into a readonly table
+  local function fill (t, n) for i = 1, n do t[i] = i * i end return t end
+  assert(T.jitcode(fill))
+  local a = fill({}, 100)
+  assert(#a == 100 and a[10] == 100)
+  a = fill(setmetatable({}, {__newindex = function (t, k, v)
+    rawset(t, k, -v)
+  end}), 3)
+  assert(a[1] == -1 and a[3] == -9)
+
+  -- globals and upvalues
+  local up = 0
+  local function glob (n)
+    for i = 1, n do JITG = (JITG or 0) + i; up = up + 1 end
+    return JITG, up
+  end
+  assert(T.jitcode(glob))
+  local g, u = glob(10)
+  assert(g == 55 and u == 10 and JITG == 55)
+  JITG = nil
+
+  -- integer division by zero still raises an error
+  local function idiv (a, b) return a // b, a % b end
+  assert(T.jitcode(idiv))
+  assert(idiv(7, 2) == 3 and select(2, idiv(-7, 2)) == 1)
+  assert(not pcall(idiv, 1, 0) and idiv(1.0, 0) == math.huge)
+
+  -- hooks are called while native code exists
+  local function loop (n) local s = 0 for i = 1, n do s = s + i end return s end
+  assert(T.jitcode(loop))
+  local count = 0
+  debug.sethook(function () count = count + 1 end, "", 1)
+  assert(loop(100) == 5050)
+  debug.sethook()
+  assert(count > 100)
+
+  -- code whose fast paths keep failing is discarded
+  local function add (a, b) return a + b end
+  assert(T.jitcode(add))
+  local v = setmetatable({}, {__add = function () return 1 end})
+  for _ = 1, 10000 do assert(add(v, v) == 1) end
+  assert(T.jitcode(add) == nil and add(1, 2) == 3)
+end
+
 print 'OK'
 
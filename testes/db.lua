@@ -136,7 +136,7 @@ if nil then
 else
   a=2
 end
-]], {2,5,6})
+]], {5,6})    -- constant condition: no test, and no dead branch
 
 test([[a=1
 repeat
@@ -686,6 +686,35 @@ do    -- check that the collector is not reentrant in incremental mode
 end
 
 
+if pcall(collectgarbage, "pool") then   -- object pools
+  local function churn (n)
+    local fs = {}
+    for i = 1, n do
+      local x = i
+      fs[i % 10 + 1] = function () return x end   -- new (closed) upvalue
+      if mat4 then local m = mat4() * mat4(); m = nil end
+    end
+  end
+  collectgarbage()
+  local oldmax = collectgarbage("setpool", 64)
+  assert(math.type(oldmax) == "integer" and oldmax >= 0)
+  churn(10000); collectgarbage()
+  local pooled = collectgarbage("pool")
+  assert(pooled > 0 and pooled <= 64 * 2)
+  collectgarbage("setpool")   -- reset statistics
+  local _, hits, misses = collectgarbage("pool")
+  assert(hits == 0 and misses == 0)
+  churn(100)
+  _, hits, misses = collectgarbage("pool")
+  assert(hits > 0 and hits + misses >= 100)
+  assert(collectgarbage("setpool", 0) == 64)   -- release all blocks
+  assert(collectgarbage("pool") == 0)
+  churn(100); collectgarbage()
+  assert(collectgarbage("pool") == 0)
+  collectgarbage("setpool", oldmax)
+end
+
+
 collectgarbage(oldmode)
 
 print('OK')
@@ -250,3 +250,553 @@ do
   assert(T.testC("rawgeti 2 0; return 1", m) == nil)
   assert(T.testC("rawgeti 2 -1; return 1", m) == nil)
 end
+
+---------------------------------------
+------------- arithmetic --------------
+---------------------------------------
+
+print("arithmetic")
+do -- Component-wise operations handled by the luaV_execute fast path
+  local a, b = vec3(1, 2, 3), vec3(4, 5, 6)
+  assert(a + b == vec3(a.x + b.x, a.y + b.y, a.z + b.z))
+  assert(a - b == vec3(a.x - b.x, a.y - b.y, a.z - b.z))
+  assert(a * b == vec3(a.x * b.x, a.y * b.y, a.z * b.z))
+  assert(a / b == vec3(a.x / b.x, a.y / b.y, a.z / b.z))
+  assert(-a == vec3(-a.x, -a.y, -a.z))
+
+  -- OP_ADDI, OP_ADDK, OP_MULK, and <number, vector> permutations
+  assert(a + 1 == vec3(2, 3, 4) and a - 1 == vec3(0, 1, 2))
+  assert(a * 2.0 == vec3(2, 4, 6) and a / 2 == vec3(0.5, 1, 1.5))
+  assert(2 * a == a * 2 and 1 + a == a + 1 and 6 - a == vec3(5, 4, 3))
+  assert(6 / a == vec3(6, 3, 2))
+
+  local c, d = vec4(1, 2, 3, 4), vec4(4, 3, 2, 1)
+  assert(c + d == vec4(5) and c - d == vec4(-3, -1, 1, 3))
+  assert(vec2(1, 2) * vec2(3, 4) == vec2(3, 8))
+  assert(math.type((a + b).x) == "float")
+
+  local q1, q2 = quat(1, 0, 0, 0), quat(0, 1, 2, 3)
+  assert(q1 + q2 == quat(1, 1, 2, 3) and q1 - q2 == quat(1, -1, -2, -3))
+  assert(q2 * 2 == quat(0, 2, 4, 6) and 2 * q2 == q2 * 2)
+  assert(-q2 == quat(0, -1, -2, -3))
+end
+
+do -- Non component-wise operations are deferred to OP_MMBIN
+  local a = vec3(1, 2, 3)
+  assert(not pcall(function() return a + vec4(1) end))
+  assert(not pcall(function() return a + "1" end))
+  assert(not pcall(function() return a + {} end))
+  if glm then
+    local q = quat(0.953717, 0.080367, 0.160734, 0.241101)
+    assert(q * q == glm.cross(q, q))
+    assert(q * a == glm.rotate(q, a))
+    assert(q / 0 == quat(1, 0, 0, 0))
+  end
+end
+
+do -- Vectors are values regardless of their representation (LUAGLM_COMPACT_VALUE)
+  local t = setmetatable({ }, { __mode = "kv" })
+  for i = 1, 100 do t[vec3(i, 0, 0)] = vec4(i); t[i] = quat(1, 0, 0, i) end
+  collectgarbage()
+  assert(t[vec3(50, 0, 0)] == vec4(50) and t[100] == quat(1, 0, 0, 100))
+
+  local f = load(string.dump(function() return vec2(1, 2), vec3(1, 2, 3), vec4(1, 2, 3, 4) end))
+  local a, b, c = f()
+  assert(a == vec2(1, 2) and b == vec3(1, 2, 3) and c == vec4(1, 2, 3, 4))
+
+  local acc = vec3(0)
+  for i = 1, 10000 do acc = acc + vec3(1, 2, 3) * 0.5; acc = -(-acc) end
+  assert(acc == vec3(5000, 10000, 15000))
+end
+
+do -- Temporaries reused by arithmetic chains (LUAGLM_EXT_INPLACE) stay private
+  local A, B = mat4x4(1) * 2, mat4x4(1) * 3
+  local AB = mat4x4(1) * 6
+  local t = {}
+  t.x = A * B
+  assert(t.x * B + B == AB * B + B and t.x == AB)
+  t[1] = A * B
+  assert(t[1] * B * B == AB * B * B and t[1] == AB)
+
+  local u = A * B
+  local function getu () return u end
+  assert(getu() * B + B == AB * B + B and u == AB)
+  local up
+  local function setup () up = A * B; return up end
+  assert(setup() * B * B == AB * B * B and up == AB)
+
+  local mt = setmetatable({}, {__index = function (_, k) t[k] = A * B; return t[k] end})
+  assert(mt.y * B + B == AB * B + B and t.y == AB)
+  local shared = A * B  -- a metamethod result may be seen elsewhere
+  local obj = setmetatable({}, {__mul = function () return shared end})
+  assert(obj * B * B == AB * B and shared == AB)
+  assert(A * B * B * B == AB * B * B and A == mat4x4(1) * 2 and B == mat4x4(1) * 3)
+end
+
+if glm and glm.batch then -- Batched kernels over packed blobs
+  local batch = glm.batch
+  local a = string.blob(string.pack("ffffff", 1, 2, 3, 4, 5, 6))
+  local b = string.blob(string.pack("ffffff", 1, 1, 1, 2, 2, 2))
+  assert(batch.size("vec3") == 12 and batch.size("mat4", 2) == 128)
+
+  local r = batch.add("vec3", nil, a, b)
+  assert(#r >= 24 and string.unpack("fff", r, 13) == 6)
+  assert(select(3, string.unpack("fff", batch.sub("vec3", nil, a, 1))) == 2)
+
+  local out = string.blob(24)
+  assert(batch.mul("vec3", out, a, vec3(2)) == out)
+  assert(select(2, string.unpack("fff", out, 13)) == 10)
+
+  local d = batch.dot("vec3", nil, a, b)
+  assert(string.unpack("f", d) == 6 and string.unpack("f", d, 5) == 30)
+
+  local t = batch.transform("vec3", nil, glm.translate(mat4(), vec3(1, 0, 0)), a, 1)
+  assert(string.unpack("f", t) == 2)
+  assert(not pcall(batch.add, "vec3", nil, 1, 2))  -- count required
+  assert(not pcall(batch.add, "vec3", string.blob(4), 1, 2, 4))  -- output too small
+  assert(not pcall(batch.add, "vec3", nil, string.pack("ffffff", 1, 2, 3, 4, 5, 6), b, 3))  -- count out of range
+  assert(not pcall(batch.dot, "mat4", nil, a, b))  -- vector type expected
+
+  local x1, y1, x2, y2 = string.unpack("ffff", batch.lerp("vec2", nil, string.pack("ffff", 0, 0, 2, 2), vec2(4, 8), 0.5))
+  assert(x1 == 2 and y1 == 4 and x2 == 3 and y2 == 5)
+  local nrm = batch.normalize("vec4", nil, vec4(0, 3, 0, 4), 2)
+  assert(math.abs(select(2, string.unpack("ffff", nrm, 17)) - 0.6) < 1e-6)
+
+  -- Worker pool: results are identical to the calling thread
+  local workers, threshold = batch.threads()
+  assert(workers == 0 and threshold > 0)
+  for _, n in ipairs({ 17, 1023, 4099 }) do  -- not multiples of the chunk size
+    local x = batch.add("vec3", nil, vec3(1, 2, 3), 0, n)
+    x = batch.lerp("vec3", nil, x, vec3(7), string.pack("f", 0.25):rep(n))
+    local serial = batch.mul("vec3", nil, x, vec3(0.5, 2, 4))
+    local dots = batch.dot("vec3", nil, serial, x)
+    if batch.threads(3, 16) > 0 then
+      assert(batch.threads() == 3)
+      local parallel = batch.mul("vec3", nil, x, vec3(0.5, 2, 4))
+      assert(parallel:sub(1, n * 12) == serial:sub(1, n * 12))
+      assert(batch.dot("vec3", nil, parallel, x):sub(1, n * 4) == dots:sub(1, n * 4))
+    end
+    assert(batch.threads(0, threshold) == 0)
+  end
+  assert(not pcall(batch.threads, 1, -1))
+end
+
+if string.blob_view then -- Typed blob accessors and views
+  local b = string.blob(string.pack("ffffff", 1, 2, 3, 4, 5, 6))
+  assert(b:blob_getvec3() == vec3(1, 2, 3) and b:blob_getvec2(5) == vec2(2, 3))
+  assert(b:blob_setvec3(13, vec3(7, 8, 9)) == b)
+  assert(select(3, string.unpack("fff", b, 13)) == 9)
+  assert(not pcall(string.blob_getvec4, b, #b - 8))  -- out of bounds
+  assert(not pcall(string.blob_setvec3, b, 1, vec4(1)))  -- type mismatch
+  assert(not pcall(string.blob_setvec3, string.rep("a", 64), 1, vec3(1)))  -- not a blob
+
+  local q = string.blob(16)
+  q:blob_setquat(1, quat(0.5, 1, 2, 3))  -- stored (x, y, z, w)
+  assert(select(4, string.unpack("ffff", q)) == 0.5 and q:blob_getquat() == quat(0.5, 1, 2, 3))
+
+  local v = string.blob_view(b, "vec3", 1, 2)
+  assert(#v == 2 and v[1] == vec3(1, 2, 3) and v[2] == vec3(7, 8, 9))
+  assert(v[0] == nil and v[3] == nil and v.x == nil)
+  v[1] = vec3(-1)
+  assert(b:blob_getvec3() == vec3(-1))
+  assert(not pcall(function() v[3] = vec3(1) end))
+  assert(not pcall(function() v[1] = 1 end))
+
+  local f = string.blob_view(b, "float", 5, 2)
+  assert(#f == 2 and f[1] == -1 and f[2] == -1)
+  f[2] = 0.5
+  assert(v[1] == vec3(-1, -1, 0.5))
+
+  if mat4 then
+    local m = string.blob(64)
+    m:blob_setmat4(1, mat4(vec4(1, 2, 3, 4), vec4(5, 6, 7, 8), vec4(9, 10, 11, 12), vec4(13, 14, 15, 16)))
+    assert(select(5, string.unpack("ffffffffffffffff", m)) == 5)  -- column-major
+    assert(string.blob_view(m, "mat4")[1] == m:blob_getmat4())
+  end
+end
+
+if glm and glm.spatial then -- Native spatial indices
+  for _, new in ipairs({ glm.spatial.bvh, glm.spatial.octree }) do
+    local index = new()
+    for i = 1, 100 do
+      index:Insert(i, vec3(i, 0, 0), vec3(i + 0.5, 1, 1))
+    end
+    index:InsertPoint("point", vec3(-10, 0, 0))
+    assert(#index == 101 and select(2, index:Bounds(7)) == vec3(7.5, 1, 1))
+
+    local objects = index:Colliding(nil, vec3(9.75, 0, 0), vec3(12.25, 1, 1))
+    table.sort(objects)
+    assert(#objects == 3 and objects[1] == 10 and objects[3] == 12)
+    assert(#index:Query(nil, vec3(50.25, 0.5, 0.5)) == 1)
+    assert(#index:Raycast(nil, vec3(0, 0.5, 0.5), vec3(1, 0, 0)) == 100)
+    assert(#index:SphereIntersection(nil, vec3(-10, 0, 0), 1) == 1)
+
+    local near, dist = index:NearestNeighbors(nil, vec3(20.25, 2, 0.5), 2)
+    assert(near[1] == 20 and dist[1] == 1 and dist[2] > 1)
+
+    index:Remove(20):Remove("point")
+    assert(#index == 99 and index:Bounds(20) == nil)
+    assert(index:NearestNeighbors(nil, vec3(20.25, 2, 0.5), 1)[1] ~= 20)
+
+    local count = 0
+    for object in coroutine.wrap(function() index:Each(coroutine.yield) end) do
+      count = count + 1
+    end
+    assert(count == 99)
+
+    index:Immutable()
+    assert(not pcall(index.Insert, index, 1, vec3(0), vec3(1)))
+    assert(not pcall(index.Remove, index, 1))
+  end
+
+  -- Randomized queries against a brute-force search
+  local function dist2 (mn, mx, p)
+    local d = 0
+    for i = 1, 3 do
+      local v = math.max(mn[i], math.min(p[i], mx[i])) - p[i]
+      d = d + v * v
+    end
+    return d
+  end
+  for _, index in ipairs({ glm.spatial.bvh(), glm.spatial.octree(vec3(0), 8, 64, 1, 1.25) }) do
+    local mins, maxs = { }, { }
+    for i = 1, 1000 do
+      local p = vec3(math.random(-100, 100), math.random(-100, 100), math.random(-100, 100))
+      mins[i], maxs[i] = p, p + vec3(math.random(0, 5), math.random(0, 5), math.random(0, 5))
+      index:Insert(i, mins[i], maxs[i])
+    end
+    for i = 1, 1000, 7 do index:Remove(i); mins[i], maxs[i] = nil, nil end
+    for q = 1, 50 do
+      if q == 25 and index.Rebuild then index:Rebuild() end
+      local c, e = vec3(math.random(-100, 100), 0, math.random(-100, 100)), vec3(math.random(1, 30))
+      local found, count = { }, 0
+      for _, o in ipairs(index:Colliding(nil, c - e, c + e)) do found[o] = true end
+      for i, mn in pairs(mins) do
+        local mx = maxs[i]
+        local hit = mn.x < c.x + e.x and c.x - e.x < mx.x and mn.y < c.y + e.y
+                and c.y - e.y < mx.y and mn.z < c.z + e.z and c.z - e.z < mx.z
+        assert(hit == (found[i] == true))
+        count = count + 1
+      end
+      assert(count == #index)
+
+      local _, dists = index:NearestNeighbors(nil, c, 5)
+      local all = { }
+      for i, mn in pairs(mins) do all[#all + 1] = math.sqrt(dist2(mn, maxs[i], c)) end
+      table.sort(all)
+      for i = 1, 5 do assert(math.abs(dists[i] - all[i]) < 1e-3) end
+    end
+  end
+end
+
+if glm and glm.orderedlist then -- Native ordered lists
+  local orderedlist = glm.orderedlist
+  local list = orderedlist(3)
+  assert(getmetatable(list) == orderedlist and getmetatable(list).__len == nil)
+  list:Insert("a", 3):Insert("b", 1):Insert("c", 2):Insert("d", 0.5)
+  assert(#list == 3 and list[1] == "d" and list[3] == "c" and list[4] == nil)
+  assert(list:Score("b") == 1 and list:Score("a") == nil and list:GetWorstDistance() == 2)
+  list:Insert("e", 2)  -- ties with the worst score expand the list
+  assert(#list == 4 and list:Size() == 4 and list[4] == "e")
+  list:Insert("f", 1.5)
+  assert(#list == 3 and list[3] == "f" and select(2, list:Get(3)) == 1.5)
+  assert(list:Pop() == "d" and list:Peek() == "b" and #list == 2)
+
+  local count = 0
+  for i, v in pairs(list) do
+    count = count + 1
+    assert(list[i] == v)
+  end
+  assert(count == 2)
+  assert(#list:Clear(40) == 0 and list:GetMaximumSize() == 40)
+  for i = 1, 100 do list:Insert(i, -i) end
+  assert(#list == 40 and list[1] == 100 and list:GetWorstDistance() == -61)
+
+  for _, max in ipairs({ false, true }) do
+    local heap = orderedlist.heap(10, max)
+    for i = 1, 100 do heap:Push(i, (i * 37) % 101) end
+    assert(#heap == 10)
+    local prev = nil
+    while #heap > 0 do
+      local _, score = heap:Pop()
+      assert(prev == nil or (max and score <= prev) or (not max and score >= prev))
+      assert((max and score <= 10) or (not max and score >= 91))
+      prev = score
+    end
+    assert(heap:Pop() == nil and heap:GetWorstDistance() == nil)
+  end
+
+  -- Both containers against a sorted reference, and KNN against brute force
+  local ref, list, heap = { }, orderedlist(16), orderedlist.heap(16, true)
+  for i = 1, 500 do
+    local s = math.random()
+    ref[i] = s
+    list:Insert(i, s)
+    heap:Push(i, s)
+  end
+  table.sort(ref)
+  assert(#list == 16 and #heap == 16 and list:GetWorstDistance() == ref[16])
+  for i = 1, 16 do
+    assert(select(2, list:Get(i)) == ref[i])
+    assert(select(2, heap:Pop()) == ref[17 - i])
+  end
+
+  assert(not pcall(list.Insert, list, nil, 1))
+  assert(not pcall(list.Size, { }))
+
+  if glm.spatial then
+    local index = glm.spatial.bvh()
+    for i = 1, 100 do index:InsertPoint(i, vec3(i, 0, 0)) end
+    local near = index:NearestNeighbors(nil, vec3(20.25, 0, 0), orderedlist(2))
+    assert(#near == 2 and near[1] == 20 and near[2] == 21)
+    near = index:NearestNeighbors(nil, vec3(20.25, 0, 0), orderedlist.heap(3, true))
+    assert(#near == 3 and near[1] == 19)  -- the root of a bounded max-heap is the worst
+
+    for _, idx in ipairs({ glm.spatial.bvh(), glm.spatial.octree(vec3(0), 8, 64, 1, 1.25) }) do
+      local pts = { }
+      for i = 1, 500 do
+        pts[i] = vec3(math.random(-100, 100), math.random(-100, 100), math.random(-100, 100))
+        idx:InsertPoint(i, pts[i])
+      end
+      for _ = 1, 25 do
+        local c, all = vec3(math.random(-100, 100), math.random(-100, 100), 0), { }
+        for i = 1, 500 do
+          local d = pts[i] - c
+          all[i] = math.sqrt(d.x * d.x + d.y * d.y + d.z * d.z)
+        end
+        table.sort(all)
+        near = idx:NearestNeighbors(nil, c, orderedlist(8))
+        assert(#near >= 8)  -- ties with the eighth distance expand the list
+        for i = 1, #near do
+          assert(math.abs(select(2, near:Get(i)) - all[i]) < 1e-3)
+        end
+      end
+    end
+  end
+end
+
+-- Batched ray queries
+do
+  if glm and glm.ray and glm.ray.nearestTriangle then
+    local ray = glm.ray
+    local aabbs, packed = { }, { }
+    for i = 1, 19 do  -- more than one packet with a partial tail
+      aabbs[#aabbs + 1] = vec3(i, -1, -1)
+      aabbs[#aabbs + 1] = vec3(i + 0.5, 1, 1)
+      packed[i] = string.pack("ffffff", i, -1, -1, i + 0.5, 1, 1)
+    end
+    packed = table.concat(packed)
+
+    for _, src in ipairs({ aabbs, packed }) do
+      local i, d = ray.nearestAABB(vec3(20, 0, 0), vec3(-1, 0, 0), src)
+      assert(i == 19 and math.abs(d - 0.5) < 1e-5)
+      i, d = ray.nearestAABB(vec3(0, 0, 0), vec3(1, 0, 0), src)
+      assert(i == 1 and math.abs(d - 1) < 1e-5)
+      assert(ray.nearestAABB(vec3(0, 0, 0), vec3(1, 0, 0), src, 0.5) == nil)
+      assert(ray.nearestAABB(vec3(0, 2, 0), vec3(1, 0, 0), src) == nil)
+      assert(ray.nearestAABB(vec3(0, 0, 0), vec3(1, 0, 0), src, math.huge, true) ~= nil)
+    end
+
+    local triangles = string.pack("fffffffff", 0, 0, 5, 1, 0, 5, 0, 1, 5)
+                   .. string.pack("fffffffff", 0, 0, 2, 1, 0, 2, 0, 1, 2)
+    local i, d, u, v = ray.nearestTriangle(vec3(0.25, 0.25, 0), vec3(0, 0, 1), triangles)
+    assert(i == 2 and math.abs(d - 2) < 1e-5 and math.abs(u - 0.25) < 1e-5 and math.abs(v - 0.25) < 1e-5)
+    assert(ray.nearestTriangle(vec3(0.75, 0.75, 0), vec3(0, 0, 1), triangles) == nil)
+    assert(ray.nearestTriangle(vec3(0.25, 0.25, 0), vec3(0, 0, 1), { vec3(0, 0, 3), vec3(1, 0, 3), vec3(0, 1, 3) }) == 1)
+    assert(not pcall(ray.nearestTriangle, vec3(0), vec3(0, 0, 1), 1))
+  end
+end
+
+do  -- mat2x2 semantics (LUAGLM_EXT_INLINEMAT stores them inline, as values)
+  if glm then
+    local a = mat(vec2(1, 2), vec2(3, 4))
+    local b = a
+    b[1] = vec2(5, 6)
+    local inline = a[1] == vec2(1, 2)  -- the alias did not see the mutation
+    local function mutate (m) m[2] = vec2(0, 0) end
+
+    if inline then
+      assert(b[1] == vec2(5, 6) and a[2] == b[2])
+      assert(a == mat(vec2(1, 2), vec2(3, 4)) and a ~= b and #a == 2)
+
+      mutate(a)  -- the parameter is a copy
+      assert(a[2] == vec2(3, 4))
+
+      local t = { [a] = true }  -- hashed by value: equal matrices share a key
+      assert(t[mat(vec2(1, 2), vec2(3, 4))] and not t[b])
+      t[mat(vec2(1, 2), vec2(3, 4))] = false
+      assert(t[a] == false and next(t, next(t)) == nil)
+
+      b[3] = vec2(7, 8)  -- promoted to a collectible mat3x2
+      assert(#b == 3 and b[3] == vec2(7, 8) and b[1] == vec2(5, 6))
+      b[3] = nil  -- collectible mat2x2
+      assert(#b == 2 and b == mat(vec2(5, 6), vec2(3, 4)))
+      local c = b  -- ... with reference semantics
+      c[1] = vec2(9, 9); assert(b[1] == vec2(9, 9))
+      mutate(b); assert(c[2] == vec2(0, 0))
+    else
+      assert(a == b and rawequal(a, b) and a[1] == vec2(5, 6))
+      mutate(a); assert(b[2] == vec2(0, 0))
+
+      local t = { [a] = true }  -- keys are identities
+      assert(t[b] and not t[mat(vec2(5, 6), vec2(0, 0))])
+    end
+
+    a = mat(vec2(1, 2), vec2(3, 4))
+    assert(a + a == a * 2 and 2 * a - a == a and -a == a * -1)
+    assert(a * vec2(1, 0) == vec2(1, 2) and (a * a)[1] == vec2(7, 10))
+    assert(glm.inverse(a) * a == mat(vec2(1, 0), vec2(0, 1)))
+  end
+end
+
+do  -- collectable matrices are sized to their dimensions
+  if glm then
+    local m = mat(vec3(1, 2, 3), vec3(4, 5, 6))
+    local n = m  -- shared reference
+    m[3] = vec3(7, 8, 9); m[4] = vec3(10, 11, 12)  -- expanded beyond its allocation
+    assert(#n == 4 and n[1] == vec3(1, 2, 3) and n[4] == vec3(10, 11, 12))
+    m[4] = nil
+    assert(n == mat(vec3(1, 2, 3), vec3(4, 5, 6), vec3(7, 8, 9)))
+    assert(mat3x4(2) * 0.5 == mat3x4(1) and (mat4x3(1) + mat4x3(1))[4] == vec3(0))
+    collectgarbage()
+  end
+end
+
+do  -- swizzles: OP_GETFIELD fast path and cached decoding
+  local v2, v3, v4 = vec2(1, 2), vec3(1, 2, 3), vec4(1, 2, 3, 4)
+  assert(v2.yx == vec2(2, 1) and v2.xyxy == vec4(1, 2, 1, 2) and v2.xz == nil)
+  assert(v3.zyx == vec3(3, 2, 1) and v3.xy == vec2(1, 2) and v3.xyw == nil)
+  assert(v4.wzyx == vec4(4, 3, 2, 1) and v4.ww == vec2(4, 4) and v4.xyzwx == nil)
+  assert(v3.dim == 3 and v3.n == 3 and v3.xq == nil)
+  for i = 2, 4 do  -- dynamic keys, decoded again once their string is collected
+    local r = v3[string.rep("z", i)]
+    assert(r.n == i and r.x == 3 and r[i] == 3)
+    collectgarbage()
+  end
+end
+
+do  -- OP_SELF inline cache of vector/matrix methods
+  local vmt, mmt = debug.getmetatable(vec3()), debug.getmetatable(mat(c1, c2))
+  local lib = { tag = function(o) return type(o) .. "1" end }
+  lib.__index = lib
+  debug.setmetatable(vec3(), lib); debug.setmetatable(mat(c1, c2), lib)
+
+  local function call(o) return o:tag() end
+  local v, m = vec3(1, 2, 3), mat(c1, c2)
+  local tv, tm = type(v), type(m)
+  for _ = 1, 3 do assert(call(v) == tv .. "1" and call(m) == tm .. "1") end
+  lib.tag = function(o) return type(o) .. "2" end  -- updated method
+  for _ = 1, 3 do assert(call(v) == tv .. "2") end
+  for i = 1, 64 do lib["f" .. i] = i end  -- rehashed metatable
+  for _ = 1, 3 do assert(call(v) == tv .. "2" and call(m) == tm .. "2") end
+  lib.tag = nil  -- removed method
+  assert(not pcall(call, v) and not pcall(call, m))
+  lib.tag = function() return "tag" end
+  lib.__index = { tag = function() return "index" end }  -- replaced '__index'
+  for _ = 1, 3 do assert(call(v) == "index" and call(m) == "index") end
+  lib.__index = lib
+  local other = { tag = function() return "other" end }  -- replaced metatable
+  other.__index = other
+  debug.setmetatable(vec3(), other)
+  for _ = 1, 3 do assert(call(v) == "other" and call(m) == "tag") end
+  other.xy = function() return "xy" end  -- vector fields take priority
+  assert((function(o) return o:xy() end)(v) ~= "xy")
+
+  debug.setmetatable(vec3(), vmt); debug.setmetatable(m, mmt)
+  if glm and vmt then  -- glm library as the vector/matrix metatable
+    for _ = 1, 3 do assert(v:length() == glm.length(v) and v:normalize() == glm.normalize(v)) end
+  end
+end
+
+do  -- typed fast calls of glm bindings (LUAGLM_EXT_FASTCALL)
+  if glm then
+    local function slow(f, ...) return select(2, assert(pcall(f, ...))) end
+    local a, b, c = vec3(1, 2, 3), vec3(-4, 5, 0.5), vec3(0.25)
+    for _, v in ipairs({ { vec2(1, 2), vec2(3, -4) }, { a, b }, { vec4(1, 2, 3, 4), vec4(0, -1, 2, 8) } }) do
+      local x, y = v[1], v[2]
+      assert(glm.dot(x, y) == slow(glm.dot, x, y))
+      assert(glm.length(x) == slow(glm.length, x))
+      assert(glm.distance(x, y) == slow(glm.distance, x, y))
+      assert(glm.normalize(y) == slow(glm.normalize, y))
+      assert(glm.clamp(y, x, x * 2) == slow(glm.clamp, y, x, x * 2))
+      assert(glm.clamp(y, 0, 1) == slow(glm.clamp, y, 0.0, 1.0))  -- integers match numbers
+      assert(glm.mix(x, y, 0.25) == slow(glm.mix, x, y, 0.25))
+      assert(glm.mix(x, y, y) == slow(glm.mix, x, y, y))
+    end
+    assert(glm.cross(a, b) == slow(glm.cross, a, b))
+    assert(glm.mix(a, b, true) == b and glm.mix(a, b, false) == a)  -- no variant
+
+    -- edge cases: NaNs compare as equal, integers take the number signatures
+    local function same(x, y) return x == y or tostring(x) == tostring(y) end
+    local function hooked(f, ...)  -- a hook also forces the regular call
+      local hook, mask, count = debug.gethook()
+      debug.sethook(function () end, "", 1000)
+      local r = f(...)
+      debug.sethook(hook, mask, count)
+      return r
+    end
+    for _, z in ipairs({ vec2(0), vec3(0), vec4(0) }) do
+      assert(same(glm.normalize(z), slow(glm.normalize, z)))
+      assert(same(glm.normalize(z), hooked(glm.normalize, z)))
+      assert(glm.length(z) == slow(glm.length, z) and glm.length(z) == 0)
+    end
+    for _, args in ipairs({ { b, 0, 1 }, { b, -1, 2.5 }, { b, 1.5, 3 }, { a, 2, 2 } }) do
+      assert(glm.clamp(table.unpack(args)) == slow(glm.clamp, table.unpack(args)))
+      assert(glm.clamp(table.unpack(args)) == hooked(glm.clamp, table.unpack(args)))
+    end
+    for _, w in ipairs({ 0, 1, 2, -1, 0.5 }) do
+      assert(glm.mix(a, b, w) == slow(glm.mix, a, b, w))
+      assert(glm.mix(a, b, w) == hooked(glm.mix, a, b, w))
+    end
+    assert(glm.mix(a, b, 0) == a and glm.mix(a, b, 1) == b)
+    assert(glm.clamp(b, 0, 1) == vec3(0, 1, 0.5))
+    assert(glm.clamp(a) == slow(glm.clamp, a) and glm.clamp(1, 0, 2) == 1)
+
+    -- results are adjusted as for any other call
+    assert(select('#', glm.dot(a, b)) == 1)
+    local t = { glm.length(a), glm.length(a) }
+    assert(#t == 2 and t[1] == t[2])
+    local x, y = glm.mix(a, b, c)
+    assert(x == slow(glm.mix, a, b, c) and y == nil)
+
+    -- vector results survive collections (LUAGLM_COMPACT_VALUE boxes vectors)
+    local acc = vec3(0)
+    for i = 1, 10000 do
+      acc = acc + glm.normalize(glm.cross(a, vec3(i, 1, 0)))
+      if i % 1000 == 0 then collectgarbage() end
+    end
+    assert(acc == acc)  -- no NaN
+  end
+end
+
+do  -- polygons store their points inline and grow in place
+  if glm and glm.polygon then
+    local polygon = glm.polygon
+    local p = polygon.new({ vec3(0, 0, 0), vec3(4, 0, 0), vec3(4, 4, 0), vec3(0, 4, 0) })
+    assert(#p == 4 and p[1] == vec3(0, 0, 0) and p[4] == vec3(0, 4, 0) and p[5] == nil)
+    assert(tostring(p) == "Polygon<4>" and polygon.area(p) == 16)
+
+    local q = polygon.new()
+    for i = 1, 100 do  -- past the inline capacity
+      q[#q + 1] = vec3(i, -i, 0)
+      if i % 25 == 0 then collectgarbage() end
+    end
+    assert(#q == 100 and q[1] == vec3(1, -1, 0) and q[100] == vec3(100, -100, 0))
+    q[50] = vec3(0)
+    assert(q[50] == vec3(0) and q[51] == vec3(51, -51, 0))
+    assert(not pcall(function() q[102] = vec3(0) end))
+
+    local t, n = q(), 0
+    assert(#t == 100 and t[100] == q[100])
+    for i, v in pairs(q) do n = n + 1; assert(v == q[i]) end
+    assert(n == 100)
+
+    -- polygons of packed float points are batch arrays (written in place)
+    if glm.batch and pcall(glm.batch.add, "vec3", nil, p, vec3(0)) then
+      glm.batch.add("vec3", p, p, vec3(1, 1, 1))
+      assert(p[1] == vec3(1, 1, 1) and p[4] == vec3(1, 5, 1) and #p == 4)
+      local d = glm.batch.dot("vec3", nil, q, vec3(1, 1, 0))
+      assert(#d == 100 * 4 and string.unpack("f", d) == 0)
+    end
+  end
+end
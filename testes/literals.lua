@@ -227,7 +227,12 @@ do  -- reuse of long strings
   assert(a1 == getadd(foo1()))
   assert(a1 == getadd(foo2()))
 
+  -- concatenation of constants is done by the compiler
   local sd = "0123456789" .. "0123456789012345678901234567890123456789"
+  assert(sd == s1 and getadd(sd) == a1)
+
+  local s4 = "0123456789"
+  sd = s4 .. "0123456789012345678901234567890123456789"
   assert(sd == s1 and getadd(sd) ~= a1)
 end
 
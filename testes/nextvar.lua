@@ -802,4 +802,81 @@ do
   
 end
 
+
+-- testing global accesses (OP_GETTABUP/OP_SETTABUP) across rehashes and removals
+do
+  -- closures of the same prototype share their instructions
+  local function new (_ENV)
+    return function () return gx end, function (v) gx = v end
+  end
+  local e1, e2 = {gx = 1}, {y = 0, gx = 2}
+  local get1, set1 = new(e1)
+  local get2, set2 = new(e2)
+  for i = 1, 3 do
+    assert(get1() == 1 and get2() == 2)
+  end
+  e1.gx = 10; assert(get1() == 10)     -- updated in place
+  e1.gx = nil; assert(get1() == nil)   -- removed
+  setmetatable(e1, {__index = function (_, k) return k end})
+  assert(get1() == "gx")
+  set1(20); assert(get1() == 20 and rawget(e1, "gx") == 20)
+  for i = 1, 100 do e1["k" .. i] = i end   -- rehash
+  assert(get1() == 20)
+  set1(30); assert(get1() == 30 and e1.gx == 30)
+  e1.gx = nil; collectgarbage()   -- dead key
+  assert(get1() == "gx")
+  set1(40); assert(get1() == 40)
+  for i = 1, 100 do e1["k" .. i] = nil end
+  collectgarbage(); e1.z = 1    -- rehash into a smaller table
+  assert(get1() == 40)
+  setmetatable(e2, {__newindex = function (t, k, v) rawset(t, k, v * 2) end})
+  e2.gx = nil; set2(5); assert(get2() == 10)
+  assert(not pcall(new(1)))     -- not a table
+end
+
+
+-- testing field accesses and method calls on objects of different layouts
+do
+  local function get (o) return o.fx end
+  local function set (o, v) o.fx = v end
+  local function call (o) return o:fm() end
+  local A = {fm = function (self) return "A" end}; A.__index = A
+  local B = {fm = function (self) return "B" end}; B.__index = B
+  -- objects of different layouts at the same instructions
+  local objs = {}
+  for i = 1, 10 do
+    local o = {fx = i}
+    for j = 1, i do o["f" .. j] = j end
+    objs[i] = setmetatable(o, i % 2 == 0 and A or B)
+  end
+  for _ = 1, 3 do
+    for i = 1, 10 do
+      local o = objs[i]
+      assert(get(o) == i and call(o) == (i % 2 == 0 and "A" or "B"))
+      set(o, i * 2); assert(get(o) == i * 2); set(o, i)
+    end
+  end
+  local o = objs[4]
+  o.fx = nil; assert(get(o) == nil)     -- removed
+  A.fx = "class"; assert(get(o) == "class")
+  set(o, 1); assert(get(o) == 1 and A.fx == "class")
+  for i = 1, 100 do o["k" .. i] = i end   -- rehash
+  assert(get(o) == 1 and call(o) == "A")
+  o.fm = function () return "own" end   -- shadows the method
+  assert(call(o) == "own")
+  o.fm = nil; collectgarbage()   -- dead key
+  assert(call(o) == "A")
+  A.fm = nil; A.__index = function (_, k) return function () return k end end
+  assert(call(objs[2]) == "fm" and get(objs[6]) == 6)
+  A.__index = B; assert(call(objs[2]) == "B")
+  setmetatable(objs[8], {__newindex = function (t, k, v) rawset(t, k, -v) end})
+  objs[8].fx = nil; set(objs[8], 3); assert(get(objs[8]) == -3)
+  local mt = getmetatable("")
+  assert(call(setmetatable({}, {__index = {fm = function () return 0 end}})) == 0)
+  mt.__index.fm = function (s) return #s end
+  assert(call("abc") == 3)     -- not a table
+  mt.__index.fm = nil
+  assert(not pcall(get, 1) and not pcall(set, nil, 1))
+end
+
 print"OK"